@@ -67,6 +67,46 @@
 #define SCHTBL_MAX_ENTRIES (SCHTBL_SLOTS * SCHTBL_ACTIVITIES_PER_SLOT)
 
 
+/*
+** Maximum number of event-triggered activities. Must be greater than zero
+** and less than or equal to 32.
+*/
+#define SCHTBL_MAX_TRIGGERS  8
+
+
+/*
+** Number of resident schedule modes. Mode 0 is the table loaded from the
+** SCH_TBL_LOAD_FILE and the remaining modes are loaded at startup from the
+** SCH_TBL_MODE_FILES list. Must be greater than zero.
+*/
+#define SCHTBL_MODES  3
+
+
+/*
+** Number of load shedding priorities. An activity's shed priority is 0 if it
+** is never shed or 1 to SCHTBL_SHED_PRIORITIES where priority 1 activities
+** are the first to be shed. Must be less than 256.
+*/
+#define SCHTBL_SHED_PRIORITIES  4
+
+
+/*
+** Size of the buffer used to write table dump files. Each time the buffer is
+** filled it is written to the file. Must be at least 512.
+*/
+#define DUMPWRITER_CHUNK_SIZE  4096
+
+
+/*
+** Size of the memory shared by table loads for the JSON file text and the
+** working copy of the table. It must hold the larger of the message and
+** scheduler tables' working data plus their JSON file. A JSON file is
+** limited to the smaller of the space remaining after the working data and
+** the table's JSON_FILE_MAX_CHAR.
+*/
+#define LOADARENA_SIZE  24576
+
+
 /******************************************************************************
 ** Message Table Configurations
 */
@@ -85,9 +125,15 @@
 ** smallest possible message header(see #CFE_SB_TLM_HDR_SIZE and 
 ** #CFE_SB_CMD_HDR_SIZE)
 */
-#define MSGTBL_MAX_MSG_WORDS      8
+#define MSGTBL_MAX_MSG_WORDS      64
 #define MSGTBL_MAX_MSG_BYTES      (MSGTBL_MAX_MSG_WORDS*2)
 
+/*
+** Number of words available for all of the message definitions. A message
+** uses 3 header words plus its data words. Must be less than 65536.
+*/
+#define MSGTBL_STORE_WORDS      1024
+
 
 /******************************************************************************
 ** Scheduler Configurations
@@ -140,5 +186,119 @@
 #define SCHEDULER_MAX_NOISY_MF   2
 
 
+/*
+** Depth of the pipe that receives trigger messages for event-triggered
+** activities. This is also the maximum number of trigger messages read
+** each time the scheduler wakes up.
+*/
+#define SCHEDULER_TRIGGER_PIPE_DEPTH  8
+
+
+/*
+** Maximum number of 'immediate' event-triggered activities that will be
+** dispatched each time the trigger pipe is read. Additional immediate
+** triggers are deferred to the next slot so a burst of trigger messages
+** can't delay the schedule.
+*/
+#define SCHEDULER_MAX_IMMEDIATE_TRIGGERS  2
+
+
+/*
+** When any 'immediate' trigger is enabled the scheduler waits for the next
+** slot in intervals of this many milliseconds and reads the trigger pipe
+** between them. This is the worst-case latency from a trigger message's
+** arrival to its activity being sent. It must be less than the slot period
+** to improve on 'next-slot' triggers.
+*/
+#define SCHEDULER_TRIGGER_POLL_MS  5
+
+
+/*
+** Load shedding controller. At the end of each major frame the number of
+** activity send failures and slot overruns (skipped slot wakeups and
+** multiple slot wakeups that aren't routine catch-up) during the frame are
+** compared to these thresholds. If either is
+** met the shed level is raised by one. The level is lowered by one after
+** SCHEDULER_SHED_CLEAR_FRAMES consecutive major frames below both
+** thresholds. The thresholds must be greater than zero.
+*/
+#define SCHEDULER_SHED_FAILURE_THRESHOLD   2
+#define SCHEDULER_SHED_OVERRUN_THRESHOLD   2
+#define SCHEDULER_SHED_CLEAR_FRAMES        4
+
+
+/*
+** Timing fault injection. When true the inject timing fault command can
+** drop or corrupt frame signals so the catch-up and noise handling can be
+** exercised on a test bed. Leave it false in flight builds: the command is
+** rejected and the fault checks in the frame callbacks are compiled out.
+** The outcome is reported SCHEDULER_FAULT_SETTLE_FRAMES major frames after
+** the last fault so the scheduler has time to recover.
+*/
+#define SCHEDULER_TIMING_FAULTS        false
+#define SCHEDULER_FAULT_SETTLE_FRAMES  2
+
+
+/*
+** Event limiting. The skipped slots, multiple slots, activity send error and
+** triggered activity error events can be sent every slot or trigger poll
+** when the system is overloaded. Each of them
+** is limited to SCHEDULER_EVS_LIMIT_CNT events in a window of
+** SCHEDULER_EVS_LIMIT_FRAMES major frames. Events beyond the limit are
+** counted and summarized in one event at the end of the window.
+*/
+#define SCHEDULER_EVS_LIMIT_CNT     2
+#define SCHEDULER_EVS_LIMIT_FRAMES  1
+
+
+/******************************************************************************
+** Schedule Analyzer Configurations
+*/
+
+/*
+** Maximum number of table passes evaluated for a slot's worst-case load. A
+** slot whose enabled periods have a larger least common multiple is
+** reported with the sum of all of its activities. Must be at least 255.
+*/
+#define SCHANALYZER_MAX_PASSES  4096
+
+
+/*
+** Slot load budget. A slot whose worst-case number of messages or message
+** bytes sent in one pass exceeds its budget is reported as overloaded.
+*/
+#define SCHANALYZER_SLOT_MSG_BUDGET   10
+#define SCHANALYZER_SLOT_BYTE_BUDGET  1024
+
+
+/******************************************************************************
+** Scheduler Trace Configurations
+*/
+
+/*
+** Number of records in each trace ring. There is a ring for the major frame
+** callback, the minor frame callback and the scheduler task. Must be a
+** power of 2.
+*/
+#define SCHTRACE_RING_LEN  256
+
+
+/******************************************************************************
+** Scheduler Profile Configurations
+*/
+
+/*
+** Minor frame timer histogram. The error between each measured minor frame
+** interval and the nominal slot period is counted in SCHPROFILE_TICK_BINS
+** bins that are SCHPROFILE_TICK_BIN_US wide. Wakeups are counted by the
+** number of slots that were due in SCHPROFILE_LAG_BINS bins where bin 0 is
+** a wakeup in the same slot. The last bin of each histogram also counts
+** everything beyond it.
+*/
+#define SCHPROFILE_TICK_BINS    8
+#define SCHPROFILE_TICK_BIN_US  100
+#define SCHPROFILE_LAG_BINS     6
+
+
 
 #endif /* _kit_sch_platform_cfg_ */
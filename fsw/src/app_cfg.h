@@ -60,6 +60,16 @@
 **   initialization. The scheduler will wait this amount of time before
 **   assuming all apps have been started and will then begin nominal scheduler
 **   processing.
+**
+** CFG_SCH_TBL_MODE_FILES
+**   Comma separated list of scheduler table files for schedule modes 1 to
+**   SCHTBL_MODES-1. Mode 0 is the SCH_TBL_LOAD_FILE. An empty list entry
+**   leaves a mode undefined.
+**
+** CFG_MSG_TBL_LOAD_FILE, CFG_SCH_TBL_LOAD_FILE, CFG_SCH_TBL_MODE_FILES
+**   Table files with the TBLIMAGE_FILE_EXT (".bin") extension are loaded as
+**   binary table images instead of JSON. Images are created with the table
+**   dump command using a ".bin" filename.
 */
 
 #define CFG_APP_CFE_NAME          APP_CFE_NAME
@@ -70,6 +80,11 @@
 #define CFG_KIT_SCH_HK_TLM_TOPICID        KIT_SCH_HK_TLM_TOPICID
 #define CFG_KIT_SCH_DIAG_TLM_TOPICID      KIT_SCH_DIAG_TLM_TOPICID
 #define CFG_KIT_SCH_TBL_ENTRY_TLM_TOPICID KIT_SCH_TBL_ENTRY_TLM_TOPICID
+#define CFG_KIT_SCH_ANALYSIS_TLM_TOPICID  KIT_SCH_ANALYSIS_TLM_TOPICID
+#define CFG_KIT_SCH_RATE_TLM_TOPICID      KIT_SCH_RATE_TLM_TOPICID
+#define CFG_KIT_SCH_PROFILE_TLM_TOPICID   KIT_SCH_PROFILE_TLM_TOPICID
+#define CFG_KIT_SCH_LATENCY_TLM_TOPICID   KIT_SCH_LATENCY_TLM_TOPICID
+#define CFG_KIT_SCH_LATENCY_STAMP_TLM_TOPICID  KIT_SCH_LATENCY_STAMP_TLM_TOPICID
 
 #define CFG_CMD_PIPE_NAME         CMD_PIPE_NAME
 #define CFG_CMD_PIPE_DEPTH        CMD_PIPE_DEPTH
@@ -79,8 +94,10 @@
 
 #define CFG_SCH_TBL_LOAD_FILE     SCH_TBL_LOAD_FILE
 #define CFG_SCH_TBL_DUMP_FILE     SCH_TBL_DUMP_FILE
+#define CFG_SCH_TBL_MODE_FILES    SCH_TBL_MODE_FILES
 
 #define CFG_STARTUP_SYNC_TIMEOUT  STARTUP_SYNC_TIMEOUT
+#define CFG_HEALTH_WINDOW_FRAMES  HEALTH_WINDOW_FRAMES
 
 #define APP_CONFIG(XX) \
    XX(APP_CFE_NAME,char*) \
@@ -90,13 +107,20 @@
    XX(KIT_SCH_HK_TLM_TOPICID,uint32) \
    XX(KIT_SCH_DIAG_TLM_TOPICID,uint32) \
    XX(KIT_SCH_TBL_ENTRY_TLM_TOPICID,uint32) \
+   XX(KIT_SCH_ANALYSIS_TLM_TOPICID,uint32) \
+   XX(KIT_SCH_RATE_TLM_TOPICID,uint32) \
+   XX(KIT_SCH_PROFILE_TLM_TOPICID,uint32) \
+   XX(KIT_SCH_LATENCY_TLM_TOPICID,uint32) \
+   XX(KIT_SCH_LATENCY_STAMP_TLM_TOPICID,uint32) \
    XX(CMD_PIPE_NAME,char*) \
    XX(CMD_PIPE_DEPTH,uint32) \
    XX(MSG_TBL_LOAD_FILE,char*) \
    XX(MSG_TBL_DUMP_FILE,char*) \
    XX(SCH_TBL_LOAD_FILE,char*) \
    XX(SCH_TBL_DUMP_FILE,char*) \
+   XX(SCH_TBL_MODE_FILES,char*) \
    XX(STARTUP_SYNC_TIMEOUT,uint32) \
+   XX(HEALTH_WINDOW_FRAMES,uint32) \
    
 DECLARE_ENUM(Config,APP_CONFIG)
 
@@ -113,6 +137,80 @@ DECLARE_ENUM(Config,APP_CONFIG)
 #define SCHEDULER_LOAD_MSG_TBL_ENTRY_CMD_FC (CMDMGR_APP_START_FC + 5)
 #define SCHEDULER_SEND_MSG_TBL_ENTRY_CMD_FC (CMDMGR_APP_START_FC + 6)
 #define SCHEDULER_SEND_DIAG_TLM_CMD_FC      (CMDMGR_APP_START_FC + 7)
+#define SCHEDULER_CFG_GROUP_CMD_FC          (CMDMGR_APP_START_FC + 8)
+#define SCHEDULER_SWITCH_MODE_CMD_FC        (CMDMGR_APP_START_FC + 9)
+#define SCHEDULER_SEND_MSG_REFS_CMD_FC      (CMDMGR_APP_START_FC + 10)
+#define SCHANALYZER_ANALYZE_CMD_FC          (CMDMGR_APP_START_FC + 11)
+#define SCHBALANCER_BALANCE_CMD_FC          (CMDMGR_APP_START_FC + 12)
+#define SCHTRACE_DUMP_CMD_FC                (CMDMGR_APP_START_FC + 13)
+#define SCHPROFILE_START_CMD_FC             (CMDMGR_APP_START_FC + 14)
+#define SCHEDULER_INJECT_FAULT_CMD_FC       (CMDMGR_APP_START_FC + 15)
+#define SCHEDULER_CFG_LATENCY_CMD_FC        (CMDMGR_APP_START_FC + 16)
+#define SCHEDULER_ACTIVATE_PATCH_CMD_FC     (CMDMGR_APP_START_FC + 17)
+
+
+/******************************************************************************
+** Table Load Types
+**
+** KIT_SCH_LOAD_TBL_PATCH
+**   A table load with the framework's update load type is a patch. Only the
+**   entries listed in the file are validated and staged. The staged entries
+**   are copied to the table by the activate patch command and each change is
+**   recorded in the table's change log. Replace loads merge the file into a
+**   copy of the complete table.
+*/
+
+#define KIT_SCH_LOAD_TBL_PATCH  TBLMGR_LOAD_TBL_UPDATE
+
+
+/******************************************************************************
+** Performance Log IDs
+**
+** KIT_SCH uses KIT_SCH_PERF_ID_CNT consecutive performance log IDs starting
+** at CFG_APP_PERF_ID. Each definition is an offset from CFG_APP_PERF_ID.
+**
+** KIT_SCH_PERF_APP:         Main task execution excluding the wakeup wait
+** KIT_SCH_PERF_WAKEUP_WAIT: Pending on the slot timer semaphore
+** KIT_SCH_PERF_SLOT:        Dispatching one slot's activities
+** KIT_SCH_PERF_SEND:        Sending one message table entry
+** KIT_SCH_PERF_CMD:         Processing the command pipe
+** KIT_SCH_PERF_TBL_LOAD:    Reading and validating a JSON table file
+*/
+
+#define KIT_SCH_PERF_APP          0
+#define KIT_SCH_PERF_WAKEUP_WAIT  1
+#define KIT_SCH_PERF_SLOT         2
+#define KIT_SCH_PERF_SEND         3
+#define KIT_SCH_PERF_CMD          4
+#define KIT_SCH_PERF_TBL_LOAD     5
+#define KIT_SCH_PERF_ID_CNT       6
+
+
+/******************************************************************************
+** Table Dump Types
+**
+** KIT_SCH_DUMP_TBL_COMPACT
+**   Omit table entries that have never been defined. All entries are dumped
+**   for any other dump type.
+*/
+
+#define KIT_SCH_DUMP_TBL_FULL     0
+#define KIT_SCH_DUMP_TBL_COMPACT  1
+
+
+/******************************************************************************
+** Memory Barrier
+**
+** Keeps the compiler and CPU from reordering accesses to data shared with
+** the frame callbacks. Used by the scheduler statistics sequence lock and
+** the trace rings.
+*/
+
+#if defined(__GNUC__)
+   #define KIT_SCH_MEM_BARRIER()  __sync_synchronize()
+#else
+   #define KIT_SCH_MEM_BARRIER()
+#endif
 
 
 /******************************************************************************
@@ -128,6 +226,11 @@ DECLARE_ENUM(Config,APP_CONFIG)
 #define SCHTBL_BASE_EID       (OSK_C_FW_APP_BASE_EID + 100)
 #define MSGTBL_BASE_EID       (OSK_C_FW_APP_BASE_EID + 200)
 #define SCHEDULER_BASE_EID    (OSK_C_FW_APP_BASE_EID + 300)
+#define TBLIMAGE_BASE_EID     (OSK_C_FW_APP_BASE_EID + 400)
+#define SCHANALYZER_BASE_EID  (OSK_C_FW_APP_BASE_EID + 500)
+#define SCHBALANCER_BASE_EID  (OSK_C_FW_APP_BASE_EID + 600)
+#define SCHTRACE_BASE_EID     (OSK_C_FW_APP_BASE_EID + 700)
+#define SCHPROFILE_BASE_EID   (OSK_C_FW_APP_BASE_EID + 800)
 
 /*
 ** One event ID is used for all initialization debug messages. Uncomment one of
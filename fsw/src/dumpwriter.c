@@ -0,0 +1,142 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement a buffered text file writer used by KIT_SCH's table dumps
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "dumpwriter.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   osal_id_t  FileHandle;
+   bool       WriteErr;
+   size_t     BufLen;
+   char       Buf[DUMPWRITER_CHUNK_SIZE];
+
+} DUMPWRITER_Class_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static void Flush(void);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static DUMPWRITER_Class_t DumpWriter;
+
+
+/******************************************************************************
+** Function: DUMPWRITER_Open
+**
+*/
+int32 DUMPWRITER_Open(const char* Filename)
+{
+
+   DumpWriter.WriteErr = false;
+   DumpWriter.BufLen   = 0;
+
+   return OS_OpenCreate(&DumpWriter.FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+
+} /* End DUMPWRITER_Open() */
+
+
+/******************************************************************************
+** Function: DUMPWRITER_Printf
+**
+*/
+void DUMPWRITER_Printf(const char* Format, ...)
+{
+
+   va_list  Args;
+   int      RecordLen;
+
+   if ((DUMPWRITER_CHUNK_SIZE - DumpWriter.BufLen) < DUMPWRITER_RECORD_MAX)
+   {
+      Flush();
+   }
+
+   va_start(Args, Format);
+   RecordLen = vsnprintf(&DumpWriter.Buf[DumpWriter.BufLen], DUMPWRITER_RECORD_MAX, Format, Args);
+   va_end(Args);
+
+   if ((RecordLen < 0) || (RecordLen >= DUMPWRITER_RECORD_MAX))
+   {
+      DumpWriter.WriteErr = true;
+   }
+   else
+   {
+      DumpWriter.BufLen += RecordLen;
+   }
+
+} /* End DUMPWRITER_Printf() */
+
+
+/******************************************************************************
+** Function: DUMPWRITER_Close
+**
+*/
+bool DUMPWRITER_Close(void)
+{
+
+   Flush();
+   OS_close(DumpWriter.FileHandle);
+
+   return !DumpWriter.WriteErr;
+
+} /* End DUMPWRITER_Close() */
+
+
+/******************************************************************************
+** Function: Flush
+**
+*/
+static void Flush(void)
+{
+
+   if (DumpWriter.BufLen > 0)
+   {
+      if (OS_write(DumpWriter.FileHandle, DumpWriter.Buf, DumpWriter.BufLen) != (int32)DumpWriter.BufLen)
+      {
+         DumpWriter.WriteErr = true;
+      }
+      DumpWriter.BufLen = 0;
+   }
+
+} /* End Flush() */
@@ -0,0 +1,98 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a buffered text file writer used by KIT_SCH's table dumps
+**
+**  Notes:
+**    1. Formatted output is accumulated in a DUMPWRITER_CHUNK_SIZE buffer
+**       and written to the file when the buffer is full so a table dump
+**       makes a few large OS_write() calls instead of one per record.
+**    2. There is one writer so only one file can be open at a time. This
+**       is sufficient because table dumps are performed by the app's
+**       main task.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _dumpwriter_
+#define _dumpwriter_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** A single formatted record must fit in the buffer
+*/
+#define DUMPWRITER_RECORD_MAX  512
+
+#if (DUMPWRITER_CHUNK_SIZE < DUMPWRITER_RECORD_MAX)
+   #error DUMPWRITER_CHUNK_SIZE must be greater than or equal to DUMPWRITER_RECORD_MAX
+#endif
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: DUMPWRITER_Open
+**
+** Create a dump file. The file is truncated if it exists.
+**
+** Notes:
+**   1. Returns the OSAL status so the caller can report errors in its own
+**      context.
+**
+*/
+int32 DUMPWRITER_Open(const char* Filename);
+
+
+/******************************************************************************
+** Function: DUMPWRITER_Printf
+**
+** Append formatted text to the dump file.
+**
+** Notes:
+**   1. Records longer than DUMPWRITER_RECORD_MAX are truncated and cause
+**      DUMPWRITER_Close() to report an error.
+**
+*/
+void DUMPWRITER_Printf(const char* Format, ...);
+
+
+/******************************************************************************
+** Function: DUMPWRITER_Close
+**
+** Write the buffered text and close the file.
+**
+** Notes:
+**   1. Returns false if any write failed or a record was truncated.
+**
+*/
+bool DUMPWRITER_Close(void);
+
+
+#endif /* _dumpwriter_ */
@@ -0,0 +1,345 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement a single-pass JSON walker used by KIT_SCH's table loads
+**
+**  Notes:
+**    1. Strings are not unescaped. Table keys and values don't use escape
+**       sequences and this matches how CJSON returns string values.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include <stdlib.h>
+#include "jsonwalk.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define JSONWALK_INT_STR_MAX 24
+
+#define IS_WHITE_SPACE(c) (((c) == ' ') || ((c) == '\t') || ((c) == '\r') || ((c) == '\n'))
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static void SkipWhiteSpace(const char* Buf, size_t* Pos, size_t End);
+static bool SkipString(const char* Buf, size_t* Pos, size_t End);
+static bool SkipValue(const char* Buf, size_t* Pos, size_t End);
+
+
+/******************************************************************************
+** Function: JSONWALK_Init
+**
+*/
+void JSONWALK_Init(JSONWALK_Cursor_t* Cursor, const char* Buf, size_t BufLen)
+{
+
+   Cursor->Buf = Buf;
+   Cursor->Pos = 0;
+   Cursor->End = BufLen;
+
+   SkipWhiteSpace(Cursor->Buf, &Cursor->Pos, Cursor->End);
+
+} /* End JSONWALK_Init() */
+
+
+/******************************************************************************
+** Function: JSONWALK_GetMember
+**
+*/
+bool JSONWALK_GetMember(const JSONWALK_Cursor_t* Object, const char* Key,
+                        JSONWALK_Cursor_t* Value)
+{
+
+   const char* Buf = Object->Buf;
+   size_t  Pos = Object->Pos;
+   size_t  End = Object->End;
+   size_t  KeyLen = strlen(Key);
+   size_t  KeyStart;
+   size_t  ValueStart;
+   bool    KeyMatch;
+
+   SkipWhiteSpace(Buf, &Pos, End);
+   if ((Pos >= End) || (Buf[Pos] != '{')) return false;
+   Pos++;
+
+   while (true)
+   {
+
+      SkipWhiteSpace(Buf, &Pos, End);
+      if ((Pos >= End) || (Buf[Pos] != '"')) return false;
+
+      KeyStart = Pos + 1;
+      if (!SkipString(Buf, &Pos, End)) return false;
+      KeyMatch = (((Pos - 1) - KeyStart) == KeyLen) && (memcmp(&Buf[KeyStart], Key, KeyLen) == 0);
+
+      SkipWhiteSpace(Buf, &Pos, End);
+      if ((Pos >= End) || (Buf[Pos] != ':')) return false;
+      Pos++;
+
+      SkipWhiteSpace(Buf, &Pos, End);
+      ValueStart = Pos;
+      if (!SkipValue(Buf, &Pos, End)) return false;
+
+      if (KeyMatch)
+      {
+         Value->Buf = Buf;
+         Value->Pos = ValueStart;
+         Value->End = Pos;
+         return true;
+      }
+
+      SkipWhiteSpace(Buf, &Pos, End);
+      if ((Pos >= End) || (Buf[Pos] != ',')) return false;
+      Pos++;
+
+   } /* End member loop */
+
+} /* End JSONWALK_GetMember() */
+
+
+/******************************************************************************
+** Function: JSONWALK_GetInt
+**
+*/
+bool JSONWALK_GetInt(const JSONWALK_Cursor_t* Object, const char* Key, int* Value)
+{
+
+   char  IntStr[JSONWALK_INT_STR_MAX];
+   char* EndPtr;
+   long  IntValue;
+   bool  RetStatus = false;
+
+   if (JSONWALK_GetStr(Object, Key, IntStr, sizeof(IntStr)))
+   {
+
+      IntValue = strtol(IntStr, &EndPtr, 10);
+      if ((EndPtr != IntStr) && (*EndPtr == '\0'))
+      {
+         *Value = (int)IntValue;
+         RetStatus = true;
+      }
+   }
+
+   return RetStatus;
+
+} /* End JSONWALK_GetInt() */
+
+
+/******************************************************************************
+** Function: JSONWALK_GetStr
+**
+*/
+bool JSONWALK_GetStr(const JSONWALK_Cursor_t* Object, const char* Key,
+                     char* Str, size_t MaxLen)
+{
+
+   JSONWALK_Cursor_t Value;
+   size_t  Start;
+   size_t  Len;
+   bool    RetStatus = false;
+
+   if (JSONWALK_GetMember(Object, Key, &Value))
+   {
+
+      Start = Value.Pos;
+      Len   = Value.End - Value.Pos;
+
+      if (Value.Buf[Start] == '"')
+      {
+         Start++;
+         Len -= 2;
+      }
+      else if ((Value.Buf[Start] == '{') || (Value.Buf[Start] == '['))
+      {
+         return false;
+      }
+
+      if (Len < MaxLen)
+      {
+         memcpy(Str, &Value.Buf[Start], Len);
+         Str[Len] = '\0';
+         RetStatus = true;
+      }
+   }
+
+   return RetStatus;
+
+} /* End JSONWALK_GetStr() */
+
+
+/******************************************************************************
+** Function: JSONWALK_EnterArray
+**
+*/
+bool JSONWALK_EnterArray(const JSONWALK_Cursor_t* Array, JSONWALK_Cursor_t* Iterator)
+{
+
+   *Iterator = *Array;
+
+   SkipWhiteSpace(Iterator->Buf, &Iterator->Pos, Iterator->End);
+   if ((Iterator->Pos >= Iterator->End) || (Iterator->Buf[Iterator->Pos] != '[')) return false;
+
+   Iterator->Pos++;
+
+   return true;
+
+} /* End JSONWALK_EnterArray() */
+
+
+/******************************************************************************
+** Function: JSONWALK_NextElement
+**
+*/
+bool JSONWALK_NextElement(JSONWALK_Cursor_t* Iterator, JSONWALK_Cursor_t* Element)
+{
+
+   size_t Start;
+
+   SkipWhiteSpace(Iterator->Buf, &Iterator->Pos, Iterator->End);
+   if ((Iterator->Pos >= Iterator->End) || (Iterator->Buf[Iterator->Pos] == ']')) return false;
+
+   Start = Iterator->Pos;
+   if (!SkipValue(Iterator->Buf, &Iterator->Pos, Iterator->End)) return false;
+
+   Element->Buf = Iterator->Buf;
+   Element->Pos = Start;
+   Element->End = Iterator->Pos;
+
+   SkipWhiteSpace(Iterator->Buf, &Iterator->Pos, Iterator->End);
+   if ((Iterator->Pos < Iterator->End) && (Iterator->Buf[Iterator->Pos] == ','))
+   {
+      Iterator->Pos++;
+   }
+
+   return true;
+
+} /* End JSONWALK_NextElement() */
+
+
+/******************************************************************************
+** Function: SkipWhiteSpace
+**
+*/
+static void SkipWhiteSpace(const char* Buf, size_t* Pos, size_t End)
+{
+
+   while ((*Pos < End) && IS_WHITE_SPACE(Buf[*Pos]))
+   {
+      (*Pos)++;
+   }
+
+} /* End SkipWhiteSpace() */
+
+
+/******************************************************************************
+** Function: SkipString
+**
+** Advance past the string that starts at Pos. Pos must be on the opening
+** quote and is left one past the closing quote.
+*/
+static bool SkipString(const char* Buf, size_t* Pos, size_t End)
+{
+
+   size_t i = *Pos + 1;
+
+   while (i < End)
+   {
+      if (Buf[i] == '\\')
+      {
+         i += 2;
+      }
+      else if (Buf[i] == '"')
+      {
+         *Pos = i + 1;
+         return true;
+      }
+      else
+      {
+         i++;
+      }
+   }
+
+   return false;
+
+} /* End SkipString() */
+
+
+/******************************************************************************
+** Function: SkipValue
+**
+** Advance past the value that starts at Pos. Objects and arrays are skipped
+** by bracket depth so nested values are passed over in one scan.
+*/
+static bool SkipValue(const char* Buf, size_t* Pos, size_t End)
+{
+
+   size_t Start = *Pos;
+   uint16 Depth = 0;
+
+   if (*Pos >= End) return false;
+
+   if (Buf[*Pos] == '"') return SkipString(Buf, Pos, End);
+
+   if ((Buf[*Pos] == '{') || (Buf[*Pos] == '['))
+   {
+
+      do
+      {
+
+         if (Buf[*Pos] == '"')
+         {
+            if (!SkipString(Buf, Pos, End)) return false;
+            continue;
+         }
+
+         if ((Buf[*Pos] == '{') || (Buf[*Pos] == '['))
+         {
+            Depth++;
+         }
+         else if ((Buf[*Pos] == '}') || (Buf[*Pos] == ']'))
+         {
+            Depth--;
+         }
+         (*Pos)++;
+
+      } while ((Depth > 0) && (*Pos < End));
+
+      return (Depth == 0);
+
+   } /* End if object or array */
+
+   /* Primitive */
+   while ((*Pos < End) && (Buf[*Pos] != ',') && (Buf[*Pos] != '}') &&
+          (Buf[*Pos] != ']') && !IS_WHITE_SPACE(Buf[*Pos]))
+   {
+      (*Pos)++;
+   }
+
+   return (*Pos > Start);
+
+} /* End SkipValue() */
@@ -0,0 +1,140 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a single-pass JSON walker used by KIT_SCH's table loads
+**
+**  Notes:
+**    1. CJSON_LoadObj() searches the entire JSON buffer for each object
+**       query so loading N array entries with M fields is O(N*M*FileLen).
+**       The walker visits each array element once and only searches the
+**       element's own members so a table load is linear in the file length.
+**    2. The walker operates on the buffer read by CJSON_ProcessFile() and
+**       doesn't copy or modify it. A cursor is a span of the buffer that
+**       contains one JSON value.
+**    3. No events are sent. Callers report errors in their table's context.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _jsonwalk_
+#define _jsonwalk_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Cursor
+**
+** - Buf[Pos..End) is the remaining span. For an object or array value the
+**   span starts at the opening bracket.
+*/
+
+typedef struct
+{
+
+   const char*  Buf;
+   size_t       Pos;
+   size_t       End;
+
+} JSONWALK_Cursor_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: JSONWALK_Init
+**
+** Initialize a cursor to a JSON buffer's top-level value.
+**
+*/
+void JSONWALK_Init(JSONWALK_Cursor_t* Cursor, const char* Buf, size_t BufLen);
+
+
+/******************************************************************************
+** Function: JSONWALK_GetMember
+**
+** Find a member of the object at the cursor and return a cursor to its value.
+**
+** Notes:
+**   1. Only the object's immediate members are searched.
+**
+*/
+bool JSONWALK_GetMember(const JSONWALK_Cursor_t* Object, const char* Key,
+                        JSONWALK_Cursor_t* Value);
+
+
+/******************************************************************************
+** Function: JSONWALK_GetInt
+**
+** Get the integer value of an object member.
+**
+*/
+bool JSONWALK_GetInt(const JSONWALK_Cursor_t* Object, const char* Key, int* Value);
+
+
+/******************************************************************************
+** Function: JSONWALK_GetStr
+**
+** Copy the string value of an object member.
+**
+** Notes:
+**   1. Primitive values (numbers, true, false) are copied as their text.
+**   2. Returns false if the value doesn't fit in MaxLen including the
+**      terminator.
+**
+*/
+bool JSONWALK_GetStr(const JSONWALK_Cursor_t* Object, const char* Key,
+                     char* Str, size_t MaxLen);
+
+
+/******************************************************************************
+** Function: JSONWALK_EnterArray
+**
+** Prepare a cursor for JSONWALK_NextElement() calls.
+**
+** Notes:
+**   1. Returns false if the cursor's value is not an array.
+**
+*/
+bool JSONWALK_EnterArray(const JSONWALK_Cursor_t* Array, JSONWALK_Cursor_t* Iterator);
+
+
+/******************************************************************************
+** Function: JSONWALK_NextElement
+**
+** Return a cursor to the next array element and advance the iterator.
+**
+** Notes:
+**   1. Returns false at the end of the array or if the array is malformed.
+**
+*/
+bool JSONWALK_NextElement(JSONWALK_Cursor_t* Iterator, JSONWALK_Cursor_t* Element);
+
+
+#endif /* _jsonwalk_ */
@@ -21,8 +21,11 @@
 **       parameters and integration items (message IDs, perf IDs, etc) was
 **       also taken into consideration.
 **    2. Event message filters are not used since this is for test environments.
-**       This may be reconsidered if event flooding ever becomes a problem.
-**    3. Performance traces are not included.
+**       The scheduler limits its events that can be sent every slot under
+**       load and summarizes the suppressed events. See
+**       SCHEDULER_EVS_LIMIT_CNT.
+**    3. Performance log markers use the block of IDs starting at
+**       CFG_APP_PERF_ID that are defined in app_cfg.h.
 **    4. Most functions are global to assist in unit testing
 **    5. Functions I removed from original that need to be thought through:
 **         SCH_ValidateMessageData()
@@ -42,6 +45,7 @@
 */
 
 #include "kit_sch_app.h"
+#include "loadarena.h"
 
 
 /***********************/
@@ -53,6 +57,10 @@
 #define  CMDMGR_OBJ    (&(KitSch.CmdMgr)) 
 #define  TBLMGR_OBJ    (&(KitSch.TblMgr))
 #define  SCHEDULER_OBJ (&(KitSch.Scheduler))
+#define  SCHANALYZER_OBJ (&(KitSch.Scheduler.SchAnalyzer))
+#define  SCHBALANCER_OBJ (&(KitSch.Scheduler.SchBalancer))
+#define  SCHTRACE_OBJ    (&(KitSch.Scheduler.Trace))
+#define  SCHPROFILE_OBJ  (&(KitSch.Scheduler.Profile))
 
 
 /*******************************/
@@ -123,6 +131,8 @@ void KIT_SCH_AppMain(void)
       
    } /* End CFE_ES_RunLoop */
 
+   CFE_ES_PerfLogExit(KitSch.PerfId + KIT_SCH_PERF_APP);
+
    /* Write to system log in case events not working */
 
    CFE_ES_WriteToSysLog("KIT_SCH App terminating, err = 0x%08X\n", RunStatus);
@@ -187,6 +197,9 @@ static int32 InitApp(void)
       KitSch.SendHkMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_KIT_SCH_SEND_HK_TOPICID));
       
       KitSch.StartupSyncTimeout = INITBL_GetIntConfig(INITBL_OBJ, CFG_STARTUP_SYNC_TIMEOUT);
+      KitSch.PerfId             = INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_PERF_ID);
+      
+      CFE_ES_PerfLogEntry(KitSch.PerfId + KIT_SCH_PERF_APP);
       
       SCHEDULER_Constructor(SCHEDULER_OBJ,INITBL_OBJ);
    
@@ -218,6 +231,16 @@ static int32 InitApp(void)
       CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_LOAD_MSG_TBL_ENTRY_CMD_FC, SCHEDULER_OBJ, SCHEDULER_LoadMsgEntryCmd,   SCHEDULER_LOAD_MSG_ENTRY_CMD_DATA_LEN);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_SEND_MSG_TBL_ENTRY_CMD_FC, SCHEDULER_OBJ, SCHEDULER_SendMsgEntryCmd,   SCHEDULER_SEND_MSG_ENTRY_CMD_DATA_LEN);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_SEND_DIAG_TLM_CMD_FC,      SCHEDULER_OBJ, SCHEDULER_SendDiagTlmCmd,    SCHEDULER_SEND_DIAG_TLM_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_CFG_GROUP_CMD_FC,          SCHEDULER_OBJ, SCHEDULER_ConfigGroupCmd,    SCHEDULER_CFG_GROUP_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_SWITCH_MODE_CMD_FC,        SCHEDULER_OBJ, SCHEDULER_SwitchModeCmd,     SCHEDULER_SWITCH_MODE_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_SEND_MSG_REFS_CMD_FC,      SCHEDULER_OBJ, SCHEDULER_SendMsgRefsCmd,    SCHEDULER_SEND_MSG_REFS_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_INJECT_FAULT_CMD_FC,       SCHEDULER_OBJ, SCHEDULER_InjectFaultCmd,    SCHEDULER_INJECT_FAULT_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_CFG_LATENCY_CMD_FC,        SCHEDULER_OBJ, SCHEDULER_ConfigLatencyCmd,  SCHEDULER_CFG_LATENCY_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHEDULER_ACTIVATE_PATCH_CMD_FC,     SCHEDULER_OBJ, SCHEDULER_ActivatePatchCmd,  SCHEDULER_ACTIVATE_PATCH_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHANALYZER_ANALYZE_CMD_FC,          SCHANALYZER_OBJ, SCHANALYZER_AnalyzeCmd,  0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHBALANCER_BALANCE_CMD_FC,          SCHBALANCER_OBJ, SCHBALANCER_BalanceCmd,  SCHBALANCER_BALANCE_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHTRACE_DUMP_CMD_FC,                SCHTRACE_OBJ,    SCHTRACE_DumpCmd,        SCHTRACE_DUMP_CMD_DATA_LEN);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SCHPROFILE_START_CMD_FC,             SCHPROFILE_OBJ,  SCHPROFILE_StartCmd,     SCHPROFILE_START_CMD_DATA_LEN);
     
       CFE_MSG_Init(CFE_MSG_PTR(KitSch.HkPkt.TlmHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_KIT_SCH_HK_TLM_TOPICID)), KIT_SCH_HK_TLM_LEN);
 
@@ -225,6 +248,7 @@ static int32 InitApp(void)
       TBLMGR_Constructor(TBLMGR_OBJ);
       TBLMGR_RegisterTblWithDef(TBLMGR_OBJ, MSGTBL_LoadCmd, MSGTBL_DumpCmd, INITBL_GetStrConfig(INITBL_OBJ, CFG_MSG_TBL_LOAD_FILE));
       TBLMGR_RegisterTblWithDef(TBLMGR_OBJ, SCHTBL_LoadCmd, SCHTBL_DumpCmd, INITBL_GetStrConfig(INITBL_OBJ, CFG_SCH_TBL_LOAD_FILE));
+      SCHTBL_LoadModeFiles(INITBL_GetStrConfig(INITBL_OBJ, CFG_SCH_TBL_MODE_FILES));
 
       /*
       ** Application startup event message
@@ -253,6 +277,8 @@ static int32 ProcessCommands(void)
    CFE_SB_Buffer_t* SbBufPtr;
    CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
 
+   CFE_ES_PerfLogEntry(KitSch.PerfId + KIT_SCH_PERF_CMD);
+
    SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, KitSch.CmdPipe, CFE_SB_POLL);
 
    if (SysStatus == CFE_SUCCESS)
@@ -285,6 +311,8 @@ static int32 ProcessCommands(void)
          RetStatus = CFE_ES_RunStatus_APP_ERROR;
    } 
 
+   CFE_ES_PerfLogExit(KitSch.PerfId + KIT_SCH_PERF_CMD);
+
    return RetStatus;
 
 } /* End ProcessCommands() */
@@ -313,28 +341,21 @@ static void SendHousekeepingPkt(void)
    
    KitSch.HkPkt.SchTblLastLoadStatus = KitSch.Scheduler.SchTbl.LastLoadStatus;
    KitSch.HkPkt.SchTblAttrErrCnt     = KitSch.Scheduler.SchTbl.LastLoadCnt;
+   KitSch.HkPkt.SchTblActiveMode     = KitSch.Scheduler.SchTbl.ActiveMode;
+   KitSch.HkPkt.SchTblPendingMode    = KitSch.Scheduler.PendingMode;
+   KitSch.HkPkt.LoadArenaHighWater   = LOADARENA_HighWater();
+   KitSch.HkPkt.MsgTblLoadUs         = KitSch.Scheduler.MsgTbl.LastLoadUs;
+   KitSch.HkPkt.MsgTblDumpUs         = KitSch.Scheduler.MsgTbl.LastDumpUs;
+   KitSch.HkPkt.SchTblLoadUs         = KitSch.Scheduler.SchTbl.LastLoadUs;
+   KitSch.HkPkt.SchTblDumpUs         = KitSch.Scheduler.SchTbl.LastDumpUs;
 
    /*
    ** Scheduler Data
-   ** - At a minimum every scheduler variable effected by a reset must be included
-   ** - These have been rearranged to align data words
+   ** - The scheduler publishes a consistent snapshot so a single copy is used
+   **   instead of sampling counters that the frame callbacks may be updating
    */
 
-   KitSch.HkPkt.SlotsProcessedCount          = KitSch.Scheduler.SlotsProcessedCount;
-   KitSch.HkPkt.ScheduleActivitySuccessCount = KitSch.Scheduler.ScheduleActivitySuccessCount;
-   KitSch.HkPkt.ScheduleActivityFailureCount = KitSch.Scheduler.ScheduleActivityFailureCount;
-   KitSch.HkPkt.ValidMajorFrameCount         = KitSch.Scheduler.ValidMajorFrameCount;
-   KitSch.HkPkt.MissedMajorFrameCount        = KitSch.Scheduler.MissedMajorFrameCount;
-   KitSch.HkPkt.UnexpectedMajorFrameCount    = KitSch.Scheduler.UnexpectedMajorFrameCount;
-   KitSch.HkPkt.TablePassCount               = KitSch.Scheduler.TablePassCount;
-   KitSch.HkPkt.ConsecutiveNoisyFrameCounter = KitSch.Scheduler.ConsecutiveNoisyFrameCounter;
-   KitSch.HkPkt.SkippedSlotsCount            = KitSch.Scheduler.SkippedSlotsCount;
-   KitSch.HkPkt.MultipleSlotsCount           = KitSch.Scheduler.MultipleSlotsCount;
-   KitSch.HkPkt.SameSlotCount                = KitSch.Scheduler.SameSlotCount;
-   KitSch.HkPkt.SyncAttemptsLeft             = KitSch.Scheduler.SyncAttemptsLeft;
-   KitSch.HkPkt.LastSyncMETSlot              = KitSch.Scheduler.LastSyncMETSlot;
-   KitSch.HkPkt.IgnoreMajorFrame             = KitSch.Scheduler.IgnoreMajorFrame;
-   KitSch.HkPkt.UnexpectedMajorFrame         = KitSch.Scheduler.UnexpectedMajorFrame;
+   SCHEDULER_GetStats(&KitSch.HkPkt.Scheduler);
 
    CFE_SB_TimeStampMsg(CFE_MSG_PTR(KitSch.HkPkt.TlmHeader));
    CFE_SB_TransmitMsg(CFE_MSG_PTR(KitSch.HkPkt.TlmHeader), true);
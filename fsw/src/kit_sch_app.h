@@ -85,28 +85,24 @@ typedef struct
 
    uint16   MsgTblAttrErrCnt;
    uint16   SchTblAttrErrCnt;
+   
+   uint8    SchTblActiveMode;
+   uint8    SchTblPendingMode;
+
+   uint32   LoadArenaHighWater;   /* Most load arena bytes used by a table load */
+
+   uint32   MsgTblLoadUs;         /* Time of the last successful load and dump */
+   uint32   MsgTblDumpUs;
+   uint32   SchTblLoadUs;
+   uint32   SchTblDumpUs;
 
    /*
-   ** SCHTBL Data
-   ** - At a minimum every sch-tbl variable effected by a reset must be included
-   ** - These have been rearranged to align data words
+   ** Scheduler Data
+   ** - At a minimum every scheduler variable effected by a reset must be included
+   ** - See SCHEDULER_Stats_t for the field definitions
    */
 
-   uint32  SlotsProcessedCount;
-   uint32  ScheduleActivitySuccessCount;
-   uint32  ScheduleActivityFailureCount;
-   uint32  ValidMajorFrameCount;
-   uint32  MissedMajorFrameCount;
-   uint32  UnexpectedMajorFrameCount;
-   uint32  TablePassCount;
-   uint32  ConsecutiveNoisyFrameCounter;
-   uint16  SkippedSlotsCount;
-   uint16  MultipleSlotsCount;
-   uint16  SameSlotCount;
-   uint16  SyncAttemptsLeft;
-   uint16  LastSyncMETSlot;
-   bool    IgnoreMajorFrame;
-   bool    UnexpectedMajorFrame;
+   SCHEDULER_Stats_t  Scheduler;
 
 } KIT_SCH_HkPkt_t;
 #define KIT_SCH_HK_TLM_LEN sizeof (KIT_SCH_HkPkt_t)
@@ -140,6 +136,7 @@ typedef struct
    */
    
    uint32   StartupSyncTimeout;
+   uint32   PerfId;
    CFE_SB_MsgId_t   CmdMid;
    CFE_SB_MsgId_t   SendHkMid;
    
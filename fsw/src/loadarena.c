@@ -0,0 +1,172 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the load-scoped memory arena shared by KIT_SCH's table loads
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "loadarena.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define LOADARENA_ALIGN(Bytes)  (((Bytes) + 7) & ~((size_t)7))
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   size_t  Used;
+   size_t  TailStart;    /* Start of the tail allocation */
+   uint32  HighWater;
+
+   uint64  Buf[(LOADARENA_SIZE + 7) / 8];   /* uint64 for alignment */
+
+} LOADARENA_Class_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static void UpdateHighWater(void);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static LOADARENA_Class_t LoadArena;
+
+
+/******************************************************************************
+** Function: LOADARENA_Reset
+**
+*/
+void LOADARENA_Reset(void)
+{
+
+   LoadArena.Used      = 0;
+   LoadArena.TailStart = 0;
+
+} /* End LOADARENA_Reset() */
+
+
+/******************************************************************************
+** Function: LOADARENA_Alloc
+**
+*/
+void* LOADARENA_Alloc(size_t Bytes)
+{
+
+   void* Block = NULL;
+
+   if (LOADARENA_ALIGN(Bytes) <= (sizeof(LoadArena.Buf) - LoadArena.Used))
+   {
+      Block = (uint8*)LoadArena.Buf + LoadArena.Used;
+      LoadArena.Used += LOADARENA_ALIGN(Bytes);
+      UpdateHighWater();
+   }
+
+   return Block;
+
+} /* End LOADARENA_Alloc() */
+
+
+/******************************************************************************
+** Function: LOADARENA_AllocTail
+**
+*/
+void* LOADARENA_AllocTail(size_t MaxBytes, size_t* TailBytes)
+{
+
+   void* Block = NULL;
+
+   *TailBytes = sizeof(LoadArena.Buf) - LoadArena.Used;
+   if (*TailBytes > MaxBytes)
+   {
+      *TailBytes = MaxBytes;
+   }
+
+   if (*TailBytes > 0)
+   {
+      Block = (uint8*)LoadArena.Buf + LoadArena.Used;
+      LoadArena.TailStart = LoadArena.Used;
+      LoadArena.Used += *TailBytes;
+   }
+
+   return Block;
+
+} /* End LOADARENA_AllocTail() */
+
+
+/******************************************************************************
+** Function: LOADARENA_TrimTail
+**
+*/
+void LOADARENA_TrimTail(size_t UsedBytes)
+{
+
+   if ((LoadArena.TailStart + UsedBytes) < LoadArena.Used)
+   {
+      LoadArena.Used = LoadArena.TailStart + UsedBytes;
+   }
+   UpdateHighWater();
+
+} /* End LOADARENA_TrimTail() */
+
+
+/******************************************************************************
+** Function: LOADARENA_HighWater
+**
+*/
+uint32 LOADARENA_HighWater(void)
+{
+
+   return LoadArena.HighWater;
+
+} /* End LOADARENA_HighWater() */
+
+
+/******************************************************************************
+** Function: UpdateHighWater
+**
+*/
+static void UpdateHighWater(void)
+{
+
+   if (LoadArena.Used > LoadArena.HighWater)
+   {
+      LoadArena.HighWater = LoadArena.Used;
+   }
+
+} /* End UpdateHighWater() */
@@ -0,0 +1,106 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the load-scoped memory arena shared by KIT_SCH's table loads
+**
+**  Notes:
+**    1. The JSON file text and the working copy of the table being loaded
+**       are only needed during a load. Table loads are performed one at a
+**       time by the app's main task so one LOADARENA_SIZE arena replaces
+**       the buffers each table used to keep resident. The schedule balancer
+**       also uses it for its slot loads because its command is processed
+**       by the main task.
+**    2. Each load starts with LOADARENA_Reset() which frees every previous
+**       allocation. Pointers from a previous load must not be used.
+**    3. The JSON text is read into a tail allocation that takes the space
+**       remaining after the working data. It is provisional until it is
+**       trimmed to the file length so the high-water mark reflects the
+**       bytes actually used.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _loadarena_
+#define _loadarena_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: LOADARENA_Reset
+**
+** Free all allocations. Called at the start of each table load.
+**
+*/
+void LOADARENA_Reset(void);
+
+
+/******************************************************************************
+** Function: LOADARENA_Alloc
+**
+** Allocate an 8-byte aligned block from the arena.
+**
+** Notes:
+**   1. Returns NULL if the arena doesn't have Bytes available.
+**
+*/
+void* LOADARENA_Alloc(size_t Bytes);
+
+
+/******************************************************************************
+** Function: LOADARENA_AllocTail
+**
+** Allocate the remaining arena space, up to MaxBytes.
+**
+** Notes:
+**   1. TailBytes is set to the size of the allocation. Returns NULL if the
+**      arena is full.
+**   2. The allocation isn't included in the high-water mark until
+**      LOADARENA_TrimTail() is called.
+**
+*/
+void* LOADARENA_AllocTail(size_t MaxBytes, size_t* TailBytes);
+
+
+/******************************************************************************
+** Function: LOADARENA_TrimTail
+**
+** Shrink the tail allocation to the bytes that were used.
+**
+*/
+void LOADARENA_TrimTail(size_t UsedBytes);
+
+
+/******************************************************************************
+** Function: LOADARENA_HighWater
+**
+** Return the most arena bytes used by a load since the app started.
+**
+*/
+uint32 LOADARENA_HighWater(void);
+
+
+#endif /* _loadarena_ */
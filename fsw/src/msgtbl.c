@@ -31,46 +31,35 @@
 #include <string.h>
 #include "cfe_endian.h"
 #include "msgtbl.h"
+#include "jsonwalk.h"
+#include "tblimage.h"
+#include "dumpwriter.h"
+#include "loadarena.h"
+#include "schtbl.h"
+#include "schanalyzer.h"
+#include "schprofile.h"
 #include "cfe_msgids.h"  /* Used for debug */
 
 /***********************/
 /** Macro Definitions **/
 /***********************/
 
-#define JSON_DATA_WORD_STR_MAX 32
-
-/**********************/
-/** Type Definitions **/
-/**********************/
-
-/* See LoadJsonData()prologue for details */
-typedef CJSON_IntObj_t JsonId_t;
-typedef CJSON_IntObj_t JsonTopicId_t;
-typedef CJSON_IntObj_t JsonSeqSeg_t;
-typedef CJSON_IntObj_t JsonLength_t;
-typedef struct
-{
-   CJSON_Obj_t  Obj;
-   char         Value[JSON_DATA_WORD_STR_MAX];
-} JsonDataWords_t;
-
-
-typedef struct
-{
-   JsonId_t         Id;
-   JsonTopicId_t    TopicId;
-   JsonSeqSeg_t     SeqSeg;
-   JsonLength_t     Length;
-   JsonDataWords_t  DataWords;
-     
-} JsonMessage_t;
-
+#define JSON_DATA_WORD_STR_MAX (MSGTBL_MAX_MSG_WORDS*7)
 
 /************************************/
 /** Local File Function Prototypes **/
 /************************************/
 
-static void ConstructJsonMessage(JsonMessage_t* JsonMessage, uint16 MsgArrayIdx);
+static bool DumpData(uint8 DumpType, const char* Filename, uint16* RecordCnt);
+static bool AllocLoadData(void);
+static bool ValidStore(const MSGTBL_Data_t* Data);
+static bool DefinedInData(const MSGTBL_Data_t* Data, uint16 Index);
+static bool RemovesReferencedEntry(const MSGTBL_Data_t* NewData);
+static bool StageEntry(uint16 Index, const uint16* Words, uint16 WordCnt);
+static bool PackLoad(void);
+static bool CommitLoad(void);
+static bool StagePatch(void);
+static void InitCmdMsgs(void);
 static bool LoadJsonData(size_t JsonFileLen);
 static char *SplitStr(char *Str, const char *Delim);
 
@@ -79,7 +68,21 @@ static char *SplitStr(char *Str, const char *Delim);
 /**********************/
 
 static MSGTBL_Class_t* MsgTbl = NULL;
-static MSGTBL_Data_t   TblData;        /* Working buffer for loads */
+
+/*
+** Load working data allocated from the load arena
+*/
+static MSGTBL_Data_t*  TblData  = NULL;   /* Definitions in the file being loaded */
+static MSGTBL_Data_t*  PackData = NULL;   /* Table packed from the current and loaded definitions */
+static char*           JsonBuf  = NULL;
+
+/*
+** Entries defined by the file being loaded. Only these TblData entries are
+** defined.
+*/
+static bool    LoadPatch = false;
+static uint16  LoadEntryCnt;
+static uint16* LoadEntry = NULL;          /* MSGTBL_MAX_ENTRIES */
 
 
 /******************************************************************************
@@ -89,7 +92,7 @@ static MSGTBL_Data_t   TblData;        /* Working buffer for loads */
 **    1. This must be called prior to any other functions
 **
 */
-void MSGTBL_Constructor(MSGTBL_Class_t*  ObjPtr, const char* AppName)
+void MSGTBL_Constructor(MSGTBL_Class_t*  ObjPtr, const char* AppName, uint32 LoadPerfId)
 {
    
    MsgTbl = ObjPtr;
@@ -98,10 +101,13 @@ void MSGTBL_Constructor(MSGTBL_Class_t*  ObjPtr, const char* AppName)
 
    MsgTbl->AppName        = AppName;
    MsgTbl->LastLoadStatus = TBLMGR_STATUS_UNDEF;
+   MsgTbl->LoadPerfId     = LoadPerfId;
+   
+   InitCmdMsgs();
 
    CFE_EVS_SendEvent(KIT_SCH_INIT_DEBUG_EID, KIT_SCH_INIT_EVS_TYPE,
-                    "MSGTBL_MAX_MSG_WORDS: %d, sizeof(CFE_MSG_CommandHeader_t): %ld, sizeof(MSGTBL_Cmd_t): %ld",
-                    MSGTBL_MAX_MSG_WORDS, sizeof(CFE_MSG_CommandHeader_t), sizeof(MSGTBL_CmdMsg_t));    
+                    "MSGTBL_MAX_MSG_WORDS: %d, MSGTBL_STORE_WORDS: %d, sizeof(MSGTBL_Commands_t): %ld",
+                    MSGTBL_MAX_MSG_WORDS, MSGTBL_STORE_WORDS, sizeof(MSGTBL_Commands_t));    
    CFE_EVS_SendEvent(KIT_SCH_INIT_DEBUG_EID, KIT_SCH_INIT_EVS_TYPE,
                     "CFE_ES_SEND_HK_MID: 0x%04X (%d)", CFE_ES_SEND_HK_MID, CFE_ES_SEND_HK_MID);
    CFE_EVS_SendEvent(KIT_SCH_INIT_DEBUG_EID, KIT_SCH_INIT_EVS_TYPE,
@@ -126,34 +132,358 @@ void MSGTBL_Constructor(MSGTBL_Class_t*  ObjPtr, const char* AppName)
 **     the app framework table manager that has verified the file. If the
 **     filename exists it will be overwritten.
 **  3. File is formatted so it can be used as a load file. 
-**  4. DumpType is unused.
+**  4. A KIT_SCH_DUMP_TBL_COMPACT dump omits entries that have never been
+**     defined. Loading it into an empty table creates the same table.
+**  5. A binary table image is written if the filename has the
+**     TBLIMAGE_FILE_EXT extension.
+**  6. The time to write a successful dump is reported in an event.
+**  7. A JSON dump includes the patch change log. The loader ignores it.
 */
 
 bool MSGTBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
+{
+
+   bool       RetStatus;
+   uint16     RecordCnt;
+   OS_time_t  StartTime;
+   
+   CFE_PSP_GetTime(&StartTime);
+   
+   RetStatus = DumpData(DumpType, Filename, &RecordCnt);
+   
+   if (RetStatus)
+   {
+      MsgTbl->LastDumpUs = SCHPROFILE_ElapsedUs(StartTime);
+      CFE_EVS_SendEvent(MSGTBL_TIMING_EID, CFE_EVS_EventType_INFORMATION,
+                        "Message table dump of %d entries took %d us, %d us per entry",
+                        RecordCnt, MsgTbl->LastDumpUs, ((RecordCnt > 0) ? (MsgTbl->LastDumpUs / RecordCnt) : 0));
+   }
+   
+   return RetStatus;
+   
+} /* End of MSGTBL_DumpCmd() */
+
+
+/******************************************************************************
+** Function: MSGTBL_LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr.
+**  2. Can assume valid table file name because this is a callback from 
+**     the app framework table manager that has verified the file.
+**  3. A binary table image is loaded if the filename has the
+**     TBLIMAGE_FILE_EXT extension. An image contains every entry so it
+**     replaces the table data.
+**  4. The working data and JSON text are allocated from the load arena
+**     which is reset for each load.
+**  5. The time to read a successful load, excluding the table analysis, is
+**     reported in an event.
+*/
+bool MSGTBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
+{
+
+   bool    RetStatus = false;
+   bool    Loaded;
+   size_t  JsonBufLen;
+   OS_time_t  StartTime;
+
+   CFE_PSP_GetTime(&StartTime);
+   LoadPatch = (LoadType == KIT_SCH_LOAD_TBL_PATCH);
+   
+   if (!AllocLoadData())
+   {
+      Loaded = false;
+   }
+   else if (TBLIMAGE_IsImageFile(Filename) && LoadPatch)
+   {
+      
+      Loaded = false;
+      CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Message table patch rejected. Table image %s can't be used as a patch", Filename);
+   }
+   else if (TBLIMAGE_IsImageFile(Filename))
+   {
+      
+      Loaded = TBLIMAGE_Read(Filename, TBLIMAGE_MSGTBL_ID, MSGTBL_MAX_ENTRIES,
+                             TblData, sizeof(MSGTBL_Data_t)) &&
+               ValidStore(TblData) && !RemovesReferencedEntry(TblData);
+      if (Loaded)
+      {
+         memcpy(&MsgTbl->Data, TblData, sizeof(MSGTBL_Data_t));
+         InitCmdMsgs();
+         MsgTbl->LastLoadCnt = MSGTBL_MAX_ENTRIES;
+         CFE_EVS_SendEvent(MSGTBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Message Table image load updated %d entries", MSGTBL_MAX_ENTRIES);
+      }
+   }
+   else
+   {
+      JsonBuf = LOADARENA_AllocTail(MSGTBL_JSON_FILE_MAX_CHAR, &JsonBufLen);
+      if (JsonBuf == NULL)
+      {
+         Loaded = false;
+         CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Message table load rejected. No load arena space for JSON file %s", Filename);
+      }
+      else
+      {
+         CFE_ES_PerfLogEntry(MsgTbl->LoadPerfId);
+         Loaded = CJSON_ProcessFile(Filename, JsonBuf, JsonBufLen, LoadJsonData);
+         CFE_ES_PerfLogExit(MsgTbl->LoadPerfId);
+      }
+   }
+   
+   if (Loaded)
+   {
+      MsgTbl->LastLoadUs = SCHPROFILE_ElapsedUs(StartTime);
+      CFE_EVS_SendEvent(MSGTBL_TIMING_EID, CFE_EVS_EventType_INFORMATION,
+                        "Message table load of %d entries took %d us, %d us per entry",
+                        MsgTbl->LastLoadCnt, MsgTbl->LastLoadUs,
+                        ((MsgTbl->LastLoadCnt > 0) ? (MsgTbl->LastLoadUs / MsgTbl->LastLoadCnt) : 0));
+      MsgTbl->Loaded = true;
+      MsgTbl->LastLoadStatus = TBLMGR_STATUS_VALID;
+      RetStatus = true;
+      SCHANALYZER_Run();
+   }
+   else
+   {
+      MsgTbl->LastLoadStatus = TBLMGR_STATUS_INVALID;
+   }
+
+   LoadPatch = false;
+   
+   return RetStatus;
+   
+} /* End MSGTBL_LoadCmd() */
+
+
+/******************************************************************************
+** Function: MSGTBL_ActivatePatch
+**
+*/
+bool MSGTBL_ActivatePatch(void)
+{
+
+   bool RetStatus = false;
+   
+   if (!MsgTbl->PatchStaged)
+   {
+      CFE_EVS_SendEvent(MSGTBL_PATCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Message table activate patch rejected. No patch is staged");
+   }
+   else if (AllocLoadData())
+   {
+      
+      memcpy(TblData, &MsgTbl->Staged, sizeof(MSGTBL_Data_t));
+      memcpy(LoadEntry, MsgTbl->StagedEntry, MsgTbl->StagedEntryCnt*sizeof(uint16));
+      LoadEntryCnt = MsgTbl->StagedEntryCnt;
+      LoadPatch    = true;
+      
+      if (CommitLoad())
+      {
+         MsgTbl->PatchStaged = false;
+         RetStatus = true;
+         SCHANALYZER_Run();
+      }
+      
+      LoadPatch = false;
+   
+   }
+   
+   return RetStatus;
+   
+} /* End MSGTBL_ActivatePatch() */
+
+
+/******************************************************************************
+** Function: MSGTBL_DiscardPatch
+**
+*/
+bool MSGTBL_DiscardPatch(void)
+{
+
+   bool RetStatus = MsgTbl->PatchStaged;
+   
+   if (MsgTbl->PatchStaged)
+   {
+      MsgTbl->PatchStaged = false;
+      CFE_EVS_SendEvent(MSGTBL_PATCH_EID, CFE_EVS_EventType_INFORMATION,
+                        "Message table staged patch of %d entries discarded",
+                        MsgTbl->StagedEntryCnt);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(MSGTBL_PATCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Message table discard patch rejected. No patch is staged");
+   }
+   
+   return RetStatus;
+   
+} /* End MSGTBL_DiscardPatch() */
+
+
+/******************************************************************************
+** Function: MSGTBL_EntryDefined
+**
+*/
+bool MSGTBL_EntryDefined(uint16 Index)
+{
+   
+   return (Index < MSGTBL_MAX_ENTRIES) && DefinedInData(&MsgTbl->Data, Index);
+   
+} /* End MSGTBL_EntryDefined() */
+
+
+/******************************************************************************
+** Function: MSGTBL_GetCmdMsg
+**
+*/
+CFE_MSG_Message_t* MSGTBL_GetCmdMsg(uint16 Index)
+{
+   
+   CFE_MSG_Message_t* MsgPtr = NULL;
+   
+   if ((Index < MSGTBL_MAX_ENTRIES) && (MsgTbl->Cmd.Offset[Index] != MSGTBL_CMD_UNDEF))
+   {
+      MsgPtr = (CFE_MSG_Message_t*)&MsgTbl->Cmd.Buf[MsgTbl->Cmd.Offset[Index]];
+   }
+   
+   return MsgPtr;
+   
+} /* End MSGTBL_GetCmdMsg() */
+
+
+/******************************************************************************
+** Function: MSGTBL_GetMsgBytes
+**
+*/
+uint16 MSGTBL_GetMsgBytes(uint16 Index)
+{
+
+   CFE_MSG_Message_t* MsgPtr = MSGTBL_GetCmdMsg(Index);
+   CFE_MSG_Size_t     Size = 0;
+
+   if (MsgPtr != NULL)
+   {
+      CFE_MSG_GetSize(MsgPtr, &Size);
+   }
+
+   return (uint16)Size;
+
+} /* End MSGTBL_GetMsgBytes() */
+
+
+/******************************************************************************
+** Function: MSGTBL_GetEntryWords
+**
+*/
+uint16 MSGTBL_GetEntryWords(uint16 Index, const uint16** Words)
+{
+   
+   uint16 WordCnt = 0;
+   
+   if (Index < MSGTBL_MAX_ENTRIES)
+   {
+      WordCnt = MsgTbl->Data.Entry[Index].WordCnt;
+      if (WordCnt > 0)
+      {
+         *Words = &MsgTbl->Data.Store[MsgTbl->Data.Entry[Index].Offset];
+      }
+   }
+   
+   return WordCnt;
+   
+} /* End MSGTBL_GetEntryWords() */
+
+
+/******************************************************************************
+** Function: MSGTBL_PatchEntry
+**
+*/
+bool MSGTBL_PatchEntry(uint16 Index, const uint16* Words, uint16 WordCnt)
+{
+   
+   bool RetStatus = false;
+   
+   if ((Index >= MSGTBL_MAX_ENTRIES) || (WordCnt < MSGTBL_HDR_WORDS) || (WordCnt > MSGTBL_MAX_MSG_WORDS))
+   {
+      CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Message table entry %d patch rejected. Invalid word count %d",
+                        Index, WordCnt);
+   }
+   else
+   {
+      
+      LoadPatch = true;
+      
+      if (AllocLoadData() && StageEntry(Index, Words, WordCnt))
+      {
+         RetStatus = CommitLoad();
+      }
+      
+      LoadPatch = false;
+   
+   }
+   
+   return RetStatus;
+   
+} /* End MSGTBL_PatchEntry() */
+
+
+/******************************************************************************
+** Function: MSGTBL_ResetStatus
+**
+*/
+void MSGTBL_ResetStatus(void)
+{
+   
+   MsgTbl->LastLoadStatus = TBLMGR_STATUS_UNDEF;
+   MsgTbl->LastLoadCnt = 0;
+    
+} /* End MSGTBL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: DumpData
+**
+** Write the table to a JSON file or a binary table image and return the
+** number of entries written in RecordCnt. See MSGTBL_DumpCmd() for details.
+*/
+static bool DumpData(uint8 DumpType, const char* Filename, uint16* RecordCnt)
 {
 
    bool        RetStatus = false;
    int32       OsStatus;
-   osal_id_t   FileHandle;
    int32       i, d;
-   char        DumpRecord[256];
    char        SysTimeStr[64];
    uint16      DataWords;
+   uint16      UndefHdr[MSGTBL_HDR_WORDS] = {0};
+   bool        Compact = (DumpType == KIT_SCH_DUMP_TBL_COMPACT);
+   bool        FirstRecord = true;
    os_err_name_t      OsErrStr;
-   CFE_MSG_Size_t     MsgBytes;
+   const uint16*         Words;
+   const MSGTBL_Entry_t* Entry;
+   const MSGTBL_Change_t* Change;
    const MSGTBL_Data_t *MsgTblPtr = &MsgTbl->Data;
    
-   OsStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+   *RecordCnt = 0;
+   
+   if (TBLIMAGE_IsImageFile(Filename))
+   {
+      *RecordCnt = MSGTBL_MAX_ENTRIES;
+      return TBLIMAGE_Write(Filename, TBLIMAGE_MSGTBL_ID, MSGTBL_MAX_ENTRIES,
+                            MsgTblPtr, sizeof(MSGTBL_Data_t));
+   }
+   
+   OsStatus = DUMPWRITER_Open(Filename);
 
    if (OsStatus == OS_SUCCESS)
    {
 
-      sprintf(DumpRecord,"{\n   \"app-name\": \"%s\",\n   \"tbl-name\": \"Message\",\n",MsgTbl->AppName);
-      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+      DUMPWRITER_Printf("{\n   \"app-name\": \"%s\",\n   \"tbl-name\": \"Message\",\n",MsgTbl->AppName);
 
       CFE_TIME_Print(SysTimeStr, CFE_TIME_GetTime());
-      sprintf(DumpRecord,"   \"description\": \"Table dumped at %s\",\n",SysTimeStr);
-      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+      DUMPWRITER_Printf("   \"description\": \"Table dumped at %s\",\n",SysTimeStr);
 
       /* 
       ** Message Array 
@@ -169,96 +499,117 @@ bool MSGTBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
       **   "seq-seg": 192,
       **   "length": 1792,
       **   "data-words": "0,1,2,3,4,5"
+      **
+      ** - The data words are the words following the definition's
+      **   topic-id, seq-seg and length words.
       */
       
-      sprintf(DumpRecord,"\"message-array\": [\n");
-      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+      DUMPWRITER_Printf("\"message-array\": [\n");
 
       for (i=0; i < MSGTBL_MAX_ENTRIES; i++)
       {
          
-         if (i > 0)  /* Complete previous entry */
+         Entry = &MsgTblPtr->Entry[i];
+         
+         if (Compact && (Entry->WordCnt == 0))
+         {
+            continue;
+         }
+         
+         if (!FirstRecord)  /* Complete previous entry */
          { 
-            sprintf(DumpRecord,",\n");
-            OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+            DUMPWRITER_Printf(",\n");
          }
+         FirstRecord = false;
+         (*RecordCnt)++;
           
-         sprintf(DumpRecord,"   {\"message\": {\n");
-         OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+         DUMPWRITER_Printf("   {\"message\": {\n");
          
-         sprintf(DumpRecord,"      \"id\": %d,\n      \"topic-id\": %d,\n      \"seq-seg\": %d,\n      \"length\": %d",
+         Words = (Entry->WordCnt > 0) ? &MsgTblPtr->Store[Entry->Offset] : UndefHdr;
+         DUMPWRITER_Printf("      \"id\": %d,\n      \"topic-id\": %d,\n      \"seq-seg\": %d,\n      \"length\": %d",
                  i,
-                 CFE_MAKE_BIG16(MsgTblPtr->Entry[i].Buffer[0]),
-                 CFE_MAKE_BIG16(MsgTblPtr->Entry[i].Buffer[1]),
-                 CFE_MAKE_BIG16(MsgTblPtr->Entry[i].Buffer[2]));
-         OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+                 CFE_MAKE_BIG16(Words[0]),
+                 CFE_MAKE_BIG16(Words[1]),
+                 CFE_MAKE_BIG16(Words[2]));
          
-         /*
-         ** DataWords is everything past the primary header so they include
-         ** the secondary header and don't distinguish between cmd or tlm
-         ** packets. 
+         /* 
+         ** Omit "data-words" property if no data
+         ** - Properly terminate 'length' line 
          */
-         
-         // TODO - cFE7.0 Rethink table itself. Either only allow commands or use message type to get header length and data words will truly just be payload
-         
-         CFE_MSG_GetSize((const CFE_MSG_Message_t *)MsgTblPtr->Entry[i].Buffer, &MsgBytes);
-
-         DataWords = (MsgBytes-PKTUTIL_CMD_HDR_BYTES)/2;
-         if (DataWords > (uint8)(MSGTBL_MAX_MSG_WORDS))
-         {
-            
-            CFE_EVS_SendEvent(MSGTBL_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "Error creating dump file message entry %d. Message word length %d is greater than max data buffer %ld",
-                              i, DataWords, PKTUTIL_CMD_HDR_WORDS);         
-         }
-         else
+         DataWords = (Entry->WordCnt > 0) ? (Entry->WordCnt - MSGTBL_HDR_WORDS) : 0;
+         if (DataWords > 0)
          {
-
-            /* 
-            ** Omit "data-words" property if no data
-            ** - Properly terminate 'length' line 
-            */
-            if (DataWords > 0)
+      
+            DUMPWRITER_Printf(",\n      \"data-words\": \"");         
+               
+            for (d=0; d < DataWords; d++)
             {
-         
-               sprintf(DumpRecord,",\n      \"data-words\": \"");         
-               OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
-                  
-               for (d=0; d < DataWords; d++)
+               
+               if (d == (DataWords-1))
                {
-                  
-                  if (d == (DataWords-1))
-                  {
-                     sprintf(DumpRecord,"%d\"\n   }}",MsgTbl->Data.Entry[i].Buffer[PKTUTIL_CMD_HDR_WORDS+d]);
-                  }
-                  else
-                  {
-                     sprintf(DumpRecord,"%d,",MsgTbl->Data.Entry[i].Buffer[PKTUTIL_CMD_HDR_WORDS+d]);
-                  }
-                  OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+                  DUMPWRITER_Printf("%d\"\n   }}",Words[MSGTBL_HDR_WORDS+d]);
+               }
+               else
+               {
+                  DUMPWRITER_Printf("%d,",Words[MSGTBL_HDR_WORDS+d]);
+               }
 
-               } /* End DataWord loop */
-                           
-            } /* End if non-zero data words */
-            else
-            {
-               sprintf(DumpRecord,"\n   }}");         
-               OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
-            }
-         } /* End if DataWords within range */
+            } /* End DataWord loop */
+                        
+         } /* End if non-zero data words */
+         else
+         {
+            DUMPWRITER_Printf("\n   }}");         
+         }
 
       } /* End message loop */
 
-      /* Close message-array and top-level object */      
-      sprintf(DumpRecord,"\n]}\n");
-      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+      /* 
+      ** Patch change log, oldest change first. It isn't loaded.
+      **
+      **   "patch-log": {
+      **      "patch-cnt": 3,
+      **      "staged": "false",
+      **      "change-array": [
+      **         {"patch": 2, "id": 101},
+      **         ...
+      */
+      
+      DUMPWRITER_Printf("\n],\n\"patch-log\": {\n   \"patch-cnt\": %d,\n   \"staged\": \"%s\",\n   \"change-array\": [",
+                        MsgTbl->PatchCnt, CMDMGR_BoolStr(MsgTbl->PatchStaged));
+      
+      FirstRecord = true;
+      for (i=0; i < MSGTBL_CHANGE_LOG_LEN; i++)
+      {
+         
+         Change = &MsgTbl->ChangeLog[(MsgTbl->ChangeLogIdx + i) % MSGTBL_CHANGE_LOG_LEN];
+         
+         if (Change->PatchCnt == 0)
+         {
+            continue;
+         }
+         
+         DUMPWRITER_Printf("%s\n      {\"patch\": %d, \"id\": %d}",
+                           (FirstRecord ? "" : ","), Change->PatchCnt, Change->Index);
+         FirstRecord = false;
+      
+      } /* End change log loop */
 
-      RetStatus = true;
+      /* Close patch-log and top-level object */      
+      DUMPWRITER_Printf("\n   ]\n}}\n");
 
-      OS_close(FileHandle);
+      RetStatus = DUMPWRITER_Close();
 
-      CFE_EVS_SendEvent(MSGTBL_DUMP_EID, CFE_EVS_EventType_INFORMATION,
-                        "Successfully dumped message table to %s", Filename);
+      if (RetStatus)
+      {
+         CFE_EVS_SendEvent(MSGTBL_DUMP_EID, CFE_EVS_EventType_INFORMATION,
+                           "Successfully dumped message table to %s", Filename);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(MSGTBL_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Error writing dump file %s", Filename);
+      }
 
    } /* End if file create */
    else
@@ -273,76 +624,340 @@ bool MSGTBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
    
    return RetStatus;
    
-} /* End of MSGTBL_DumpCmd() */
+} /* End of DumpData() */
 
 
 /******************************************************************************
-** Function: MSGTBL_LoadCmd
+** Function: AllocLoadData
 **
-** Notes:
-**  1. Function signature must match TBLMGR_LoadTblFuncPtr.
-**  2. Can assume valid table file name because this is a callback from 
-**     the app framework table manager that has verified the file.
+** Allocate the load working data from the load arena and clear the loaded
+** definitions.
 */
-bool MSGTBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
+static bool AllocLoadData(void)
 {
 
-   bool  RetStatus = false;
-
-   if (CJSON_ProcessFile(Filename, MsgTbl->JsonBuf, MSGTBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+   bool RetStatus = false;
+   
+   LOADARENA_Reset();
+   TblData   = LOADARENA_Alloc(sizeof(MSGTBL_Data_t));
+   PackData  = LOADARENA_Alloc(sizeof(MSGTBL_Data_t));
+   LoadEntry = LOADARENA_Alloc(MSGTBL_MAX_ENTRIES*sizeof(uint16));
+   
+   if ((TblData == NULL) || (PackData == NULL) || (LoadEntry == NULL))
    {
-      MsgTbl->Loaded = true;
-      MsgTbl->LastLoadStatus = TBLMGR_STATUS_VALID;
-      RetStatus = true;
+      CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Message table load rejected. Load arena size %d is too small for the working data",
+                        LOADARENA_SIZE);
    }
    else
    {
-      MsgTbl->LastLoadStatus = TBLMGR_STATUS_INVALID;
+      memset(TblData->Entry, 0, sizeof(TblData->Entry));
+      TblData->StoreUsed = 0;
+      LoadEntryCnt = 0;
+      RetStatus = true;
    }
 
    return RetStatus;
    
-} /* End MSGTBL_LoadCmd() */
+} /* End AllocLoadData() */
 
 
 /******************************************************************************
-** Function: MSGTBL_ResetStatus
+** Function: ValidStore
 **
+** Verify every defined entry lies within a table's used store.
 */
-void MSGTBL_ResetStatus(void)
+static bool ValidStore(const MSGTBL_Data_t* Data)
 {
+
+   uint16 i;
+   bool   RetStatus = (Data->StoreUsed <= MSGTBL_STORE_WORDS);
    
-   MsgTbl->LastLoadStatus = TBLMGR_STATUS_UNDEF;
-   MsgTbl->LastLoadCnt = 0;
-    
-} /* End MSGTBL_ResetStatus() */
+   for (i=0; RetStatus && (i < MSGTBL_MAX_ENTRIES); i++)
+   {
+      if (Data->Entry[i].WordCnt > 0)
+      {
+         RetStatus = (Data->Entry[i].WordCnt >= MSGTBL_HDR_WORDS) &&
+                     (Data->Entry[i].WordCnt <= MSGTBL_MAX_MSG_WORDS) &&
+                     ((Data->Entry[i].Offset + Data->Entry[i].WordCnt) <= Data->StoreUsed);
+      }
+   }
+   
+   if (!RetStatus)
+   {
+      CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Message table load rejected. Invalid message store definitions");
+   }
+   
+   return RetStatus;
+   
+} /* End ValidStore() */
+
+
+/******************************************************************************
+** Function: DefinedInData
+**
+** Return true if a table's entry defines a message with a valid message ID.
+*/
+static bool DefinedInData(const MSGTBL_Data_t* Data, uint16 Index)
+{
+
+   bool   RetStatus = false;
+   uint16 MsgIdWord;
+   
+   if (Data->Entry[Index].WordCnt > 0)
+   {
+      MsgIdWord = Data->Store[Data->Entry[Index].Offset];
+      RetStatus = (MsgIdWord != 0) &&
+                  CFE_SB_IsValidMsgId(CFE_SB_ValueToMsgId(MsgIdWord));
+   }
+   
+   return RetStatus;
+   
+} /* End DefinedInData() */
+
+
+/******************************************************************************
+** Function: RemovesReferencedEntry
+**
+** Return true after sending an error event if a new table would undefine a
+** message that is sent by an enabled scheduler table entry or trigger.
+**
+** Notes:
+**   1. The scheduler table's reference index is used so the check is only
+**      made for messages that change from defined to undefined.
+*/
+static bool RemovesReferencedEntry(const MSGTBL_Data_t* NewData)
+{
+
+   uint16 i;
+   
+   for (i=0; i < MSGTBL_MAX_ENTRIES; i++)
+   {
+      if (DefinedInData(&MsgTbl->Data, i) && !DefinedInData(NewData, i) &&
+          SCHTBL_MsgReferenced(i))
+      {
+         CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Message table load rejected. Entry %d is undefined but it is sent by the scheduler table",
+                           i);
+         return true;
+      }
+   }
+   
+   return false;
+   
+} /* End RemovesReferencedEntry() */
+
+
+/******************************************************************************
+** Function: StageEntry
+**
+** Add a definition from the file being loaded to the working data and to the
+** list of entries defined by the file. An entry defined more than once is
+** only listed once and its last definition is used.
+*/
+static bool StageEntry(uint16 Index, const uint16* Words, uint16 WordCnt)
+{
+
+   uint16 i;
+   
+   if ((TblData->StoreUsed + WordCnt) > MSGTBL_STORE_WORDS)
+   {
+      CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Message table entry %d exceeds the %d word message store",
+                        Index, MSGTBL_STORE_WORDS);
+      return false;
+   }
+   
+   memcpy(&TblData->Store[TblData->StoreUsed], Words, WordCnt*sizeof(uint16));
+   TblData->Entry[Index].Offset  = TblData->StoreUsed;
+   TblData->Entry[Index].WordCnt = WordCnt;
+   TblData->StoreUsed += WordCnt;
+   
+   for (i=0; i < LoadEntryCnt; i++)
+   {
+      if (LoadEntry[i] == Index) return true;
+   }
+   
+   LoadEntry[LoadEntryCnt++] = Index;
+
+   return true;
+   
+} /* End StageEntry() */
 
 
 /******************************************************************************
-** Function: ConstructJsonMessage
+** Function: PackLoad
 **
+** Pack the loaded definitions and the current definitions of the entries
+** that weren't loaded into PackData.
+**
+** Notes:
+**   1. Returns false if the packed definitions don't fit in the message
+**      store or if an entry used by the scheduler table is undefined.
+**   2. The unused store is cleared so a table's image only depends on its
+**      definitions.
 */
-static void ConstructJsonMessage(JsonMessage_t* JsonMessage, uint16 MsgArrayIdx)
+static bool PackLoad(void)
 {
 
-   char KeyStr[64];
+   uint16  i;
+   uint16  WordCnt;
+   const MSGTBL_Data_t* SrcData;
+   
+   PackData->StoreUsed = 0;
+   for (i=0; i < MSGTBL_MAX_ENTRIES; i++)
+   {
+      
+      SrcData = (TblData->Entry[i].WordCnt > 0) ? TblData : &MsgTbl->Data;
+      WordCnt = SrcData->Entry[i].WordCnt;
+      
+      if ((PackData->StoreUsed + WordCnt) > MSGTBL_STORE_WORDS)
+      {
+         CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Message table load rejected. Definitions exceed the %d word message store",
+                           MSGTBL_STORE_WORDS);
+         return false;
+      }
+      
+      memcpy(&PackData->Store[PackData->StoreUsed], &SrcData->Store[SrcData->Entry[i].Offset], 
+             WordCnt*sizeof(uint16));
+      PackData->Entry[i].Offset  = (WordCnt > 0) ? PackData->StoreUsed : 0;
+      PackData->Entry[i].WordCnt = WordCnt;
+      PackData->StoreUsed += WordCnt;
+   
+   } /* End entry loop */
+   
+   if (RemovesReferencedEntry(PackData))
+   {
+      return false;
+   }
+   
+   memset(&PackData->Store[PackData->StoreUsed], 0, 
+          (MSGTBL_STORE_WORDS - PackData->StoreUsed)*sizeof(uint16));
+   
+   return true;
+   
+} /* End PackLoad() */
 
-   sprintf(KeyStr,"message-array[%d].message.id", MsgArrayIdx);
-   CJSON_ObjConstructor(&JsonMessage->Id.Obj, KeyStr, JSONNumber, &JsonMessage->Id.Value, 4);
 
-   sprintf(KeyStr,"message-array[%d].message.topic-id", MsgArrayIdx);
-   CJSON_ObjConstructor(&JsonMessage->TopicId.Obj, KeyStr, JSONNumber, &JsonMessage->TopicId.Value, 4);
+/******************************************************************************
+** Function: CommitLoad
+**
+** Pack the loaded definitions and make the packed table the active table.
+**
+** Notes:
+**   1. The table isn't changed if PackLoad() rejects the definitions.
+*/
+static bool CommitLoad(void)
+{
 
-   sprintf(KeyStr,"message-array[%d].message.seq-seg", MsgArrayIdx);
-   CJSON_ObjConstructor(&JsonMessage->SeqSeg.Obj, KeyStr, JSONNumber, &JsonMessage->SeqSeg.Value, 4);
+   uint16  i;
+   
+   if (!PackLoad())
+   {
+      return false;
+   }
+   
+   memcpy(&MsgTbl->Data, PackData, sizeof(MSGTBL_Data_t));
 
-   sprintf(KeyStr,"message-array[%d].message.length", MsgArrayIdx);
-   CJSON_ObjConstructor(&JsonMessage->Length.Obj, KeyStr, JSONNumber, &JsonMessage->Length.Value, 4);
+   if (LoadPatch)
+   {
+      MsgTbl->PatchCnt++;
+      for (i=0; i < LoadEntryCnt; i++)
+      {
+         MsgTbl->ChangeLog[MsgTbl->ChangeLogIdx].PatchCnt = MsgTbl->PatchCnt;
+         MsgTbl->ChangeLog[MsgTbl->ChangeLogIdx].Index    = LoadEntry[i];
+         MsgTbl->ChangeLogIdx = (MsgTbl->ChangeLogIdx + 1) % MSGTBL_CHANGE_LOG_LEN;
+      }
+      CFE_EVS_SendEvent(MSGTBL_PATCH_EID, CFE_EVS_EventType_INFORMATION,
+                        "Message table patch %d changed %d entries", 
+                        MsgTbl->PatchCnt, LoadEntryCnt);
+   }
 
-   sprintf(KeyStr,"message-array[%d].message.data-words", MsgArrayIdx);
-   CJSON_ObjConstructor(&JsonMessage->DataWords.Obj, KeyStr, JSONString, JsonMessage->DataWords.Value, JSON_DATA_WORD_STR_MAX);
+   InitCmdMsgs();
+   
+   return true;
+   
+} /* End CommitLoad() */
 
-} /* ConstructJsonMessage() */
+
+/******************************************************************************
+** Function: StagePatch
+**
+** Validate the loaded patch definitions and save them as the staged patch.
+**
+** Notes:
+**   1. The definitions are packed with the current table to validate them
+**      but the table isn't changed. A staged patch replaces a previously
+**      staged patch.
+*/
+static bool StagePatch(void)
+{
+
+   if (!PackLoad())
+   {
+      return false;
+   }
+   
+   memcpy(&MsgTbl->Staged, TblData, sizeof(MSGTBL_Data_t));
+   memcpy(MsgTbl->StagedEntry, LoadEntry, LoadEntryCnt*sizeof(uint16));
+   MsgTbl->StagedEntryCnt = LoadEntryCnt;
+   MsgTbl->PatchStaged    = true;
+   
+   CFE_EVS_SendEvent(MSGTBL_PATCH_EID, CFE_EVS_EventType_INFORMATION,
+                     "Message table patch of %d entries staged. It is applied when it is activated", 
+                     LoadEntryCnt);
+   
+   return true;
+   
+} /* End StagePatch() */
+
+
+/******************************************************************************
+** Function: InitCmdMsgs
+**
+** Build the software bus messages sent for the message table entries.
+**
+** Notes:
+**   1. A message is a command header followed by the definition's data
+**      words. Messages are packed in entry order.
+*/
+static void InitCmdMsgs(void)
+{
+
+   uint16  i;
+   uint16  BufIdx = 0;
+   uint16  DataWords;
+   CFE_MSG_Size_t     MsgBytes;
+   CFE_MSG_Message_t* MsgPtr;
+   const uint16*      Words;
+   
+   for (i=0; i < MSGTBL_MAX_ENTRIES; i++)
+   {
+      
+      if (MsgTbl->Data.Entry[i].WordCnt == 0)
+      {
+         MsgTbl->Cmd.Offset[i] = MSGTBL_CMD_UNDEF;
+      }
+      else
+      {
+         
+         Words     = &MsgTbl->Data.Store[MsgTbl->Data.Entry[i].Offset];
+         DataWords = MsgTbl->Data.Entry[i].WordCnt - MSGTBL_HDR_WORDS;
+         MsgBytes  = sizeof(CFE_MSG_CommandHeader_t) + DataWords*2;
+         MsgPtr    = (CFE_MSG_Message_t*)&MsgTbl->Cmd.Buf[BufIdx];
+         
+         CFE_MSG_Init(MsgPtr, CFE_SB_ValueToMsgId(Words[0]), MsgBytes);
+         memcpy((uint8*)MsgPtr + sizeof(CFE_MSG_CommandHeader_t), &Words[MSGTBL_HDR_WORDS], DataWords*2);
+         
+         MsgTbl->Cmd.Offset[i] = BufIdx;
+         BufIdx += (MsgBytes + 3)/4;
+      }
+      
+   } /* End entry loop */
+
+} /* End InitCmdMsgs() */
 
 
 /******************************************************************************
@@ -363,8 +978,11 @@ static void ConstructJsonMessage(JsonMessage_t* JsonMessage, uint16 MsgArrayIdx)
 **        "length": 1792,
 **        "data-words": "0,1,2,3,4,5"  # Optional field
 **
-**        The data words contain the secondary header if it is present. No
+**        The data words are sent following the command header. No
 **        integrity checks are made on the packet.
+**  3. The message-array is walked once using jsonwalk so the load time is
+**     linear in the file length. Each message's fields are only searched
+**     for within the message object.
 */
 static bool LoadJsonData(size_t JsonFileLen)
 {
@@ -374,90 +992,98 @@ static bool LoadJsonData(size_t JsonFileLen)
    uint16  i;
    uint16  AttributeCnt;
    uint16  MsgArrayIdx;
+   int     Id, TopicId, SeqSeg, Length;
+   char    DataWords[JSON_DATA_WORD_STR_MAX];
    char*   DataStrPtr;
 
-   JsonMessage_t   JsonMessage;
-   MSGTBL_Entry_t  MsgEntry;
-   MSGTBL_CmdMsg_t *CmdMsg;
+   JSONWALK_Cursor_t  JsonRoot;
+   JSONWALK_Cursor_t  JsonMsgArray;
+   JSONWALK_Cursor_t  JsonMsgIterator;
+   JSONWALK_Cursor_t  JsonMsgElement;
+   JSONWALK_Cursor_t  JsonMessage;
+   uint16             MsgWords[MSGTBL_MAX_MSG_WORDS];
 
    MsgTbl->JsonFileLen = JsonFileLen;
+   LOADARENA_TrimTail(JsonFileLen + 1);
 
    /* 
-   ** 1. Copy table owner data into local table buffer
-   ** 2. Process JSON file which updates local table buffer with JSON supplied values
-   ** 3. If valid, copy local buffer over owner's data 
+   ** 1. Process JSON file which stages the JSON supplied definitions
+   ** 2. If valid, pack the staged and current definitions into the owner's data
    */
    
-   memcpy(&TblData, &MsgTbl->Data, sizeof(MSGTBL_Data_t));
-
    MsgArrayIdx = 0;
-   while (ReadMsg)
+   JSONWALK_Init(&JsonRoot, JsonBuf, MsgTbl->JsonFileLen);
+   if (!JSONWALK_GetMember(&JsonRoot, "message-array", &JsonMsgArray) ||
+       !JSONWALK_EnterArray(&JsonMsgArray, &JsonMsgIterator))
+   {
+      ReadMsg = false;
+   }
+   
+   while (ReadMsg && JSONWALK_NextElement(&JsonMsgIterator, &JsonMsgElement))
    {
-
-      ConstructJsonMessage(&JsonMessage, MsgArrayIdx);
-      memset((void*)&MsgEntry,0,sizeof(MSGTBL_Entry_t));
 
       /*
       ** Use 'id' field to determine whether processing the file
       ** is complete. A missing or malformed 'id' field error will
       ** not be caught or reported.
-      ** The 'id' field is required but CJSON_LoadObjOptional() is
-      ** used so the 'object not found' event will be suppressed 
       */      
       
-      if (CJSON_LoadObjOptional(&JsonMessage.Id.Obj, MsgTbl->JsonBuf, MsgTbl->JsonFileLen))
+      if (JSONWALK_GetMember(&JsonMsgElement, "message", &JsonMessage) &&
+          JSONWALK_GetInt(&JsonMessage, "id", &Id))
       {
-         if (JsonMessage.Id.Value < MSGTBL_MAX_ENTRIES)
+         if ((Id >= 0) && (Id < MSGTBL_MAX_ENTRIES))
          {
             
             AttributeCnt = 0;
-            if (CJSON_LoadObj(&JsonMessage.TopicId.Obj,  MsgTbl->JsonBuf, MsgTbl->JsonFileLen)) AttributeCnt++;
-            if (CJSON_LoadObj(&JsonMessage.SeqSeg.Obj,   MsgTbl->JsonBuf, MsgTbl->JsonFileLen)) AttributeCnt++;
-            if (CJSON_LoadObj(&JsonMessage.Length.Obj,   MsgTbl->JsonBuf, MsgTbl->JsonFileLen)) AttributeCnt++;
+            if (JSONWALK_GetInt(&JsonMessage, "topic-id", &TopicId)) AttributeCnt++;
+            if (JSONWALK_GetInt(&JsonMessage, "seq-seg",  &SeqSeg))  AttributeCnt++;
+            if (JSONWALK_GetInt(&JsonMessage, "length",   &Length))  AttributeCnt++;
             
             if (AttributeCnt == 3)
             {
                /* TODO - This is not 'on the wire' so native works
-               MsgEntry.Buffer[0] = CFE_MAKE_BIG16((uint16)JsonMessage.TopicId.Value);
-               MsgEntry.Buffer[1] = CFE_MAKE_BIG16((uint16)JsonMessage.SeqSeg.Value);
-               MsgEntry.Buffer[2] = CFE_MAKE_BIG16((uint16)JsonMessage.Length.Value);
+               MsgWords[0] = CFE_MAKE_BIG16((uint16)TopicId);
+               MsgWords[1] = CFE_MAKE_BIG16((uint16)SeqSeg);
+               MsgWords[2] = CFE_MAKE_BIG16((uint16)Length);
                */
-               MsgEntry.Buffer[0] = (uint16)JsonMessage.TopicId.Value;
-               MsgEntry.Buffer[1] = (uint16)JsonMessage.SeqSeg.Value;
-               MsgEntry.Buffer[2] = (uint16)JsonMessage.Length.Value;
+               MsgWords[0] = (uint16)TopicId;
+               MsgWords[1] = (uint16)SeqSeg;
+               MsgWords[2] = (uint16)Length;
+               i = MSGTBL_HDR_WORDS;
 
                CFE_EVS_SendEvent(KIT_SCH_INIT_DEBUG_EID, KIT_SCH_INIT_EVS_TYPE,
-                                 "MsgEntry.Buffer: [0]=%d, [1]=%d, [2]=%d", 
-                                 MsgEntry.Buffer[0], MsgEntry.Buffer[1], MsgEntry.Buffer[2]);
+                                 "MsgWords: [0]=%d, [1]=%d, [2]=%d", 
+                                 MsgWords[0], MsgWords[1], MsgWords[2]);
 
-               if (CJSON_LoadObjOptional(&JsonMessage.DataWords.Obj, MsgTbl->JsonBuf, MsgTbl->JsonFileLen))
+               if (JSONWALK_GetStr(&JsonMessage, "data-words", DataWords, JSON_DATA_WORD_STR_MAX))
                {
-                  if (strlen(JsonMessage.DataWords.Value) > 0)
+                  if (strlen(DataWords) > 0)
                   {
-                     i = 3;
                      /* No protection against malformed data array */
-                     DataStrPtr = SplitStr(JsonMessage.DataWords.Value,",");
-                     if (DataStrPtr != NULL)
+                     DataStrPtr = SplitStr(DataWords,",");
+                     while ((DataStrPtr != NULL) && (i < MSGTBL_MAX_MSG_WORDS))
                      {
-                        MsgEntry.Buffer[i++] = atoi(DataStrPtr);
+                        MsgWords[i++] = atoi(DataStrPtr);
                         CFE_EVS_SendEvent(KIT_SCH_INIT_DEBUG_EID, KIT_SCH_INIT_EVS_TYPE,
-                                          "MSGTBL::LoadJsonData data[%d] = 0x%4X, DataStrPtr=%s\n",
-                                          i-1,MsgEntry.Buffer[i-1],DataStrPtr);         
-                        while ((DataStrPtr = SplitStr(NULL,",")) != NULL)
-                        {
-                           MsgEntry.Buffer[i++] = atoi(DataStrPtr);
-                           CFE_EVS_SendEvent(KIT_SCH_INIT_DEBUG_EID, KIT_SCH_INIT_EVS_TYPE,
-                                             "MSGTBL::LoadJsonData data[%d] = 0x%4X, DataStrPtr=%s",i-1,MsgEntry.Buffer[i-1],DataStrPtr);
-                        }
+                                          "MSGTBL::LoadJsonData data[%d] = 0x%4X, DataStrPtr=%s",i-1,MsgWords[i-1],DataStrPtr);
+                        DataStrPtr = SplitStr(NULL,",");
+                     }
+                     if (DataStrPtr != NULL)
+                     {
+                        CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                                          "Message[%d] data-words exceed the %d word message buffer",
+                                          MsgArrayIdx, MSGTBL_MAX_MSG_WORDS);
+                        ReadMsg = false;
+                        RetStatus = false;
                      }
-                     MsgEntry.PayloadWordCnt = 3 - i;
                   } /* End if strlen > 0 */
                } /* End if DataWords */
                
-               memcpy(&TblData.Entry[JsonMessage.Id.Value],&MsgEntry,sizeof(MSGTBL_Entry_t));
-               
-               CmdMsg = &MsgTbl->Cmd.Msg[JsonMessage.Id.Value];
-               CFE_MSG_Init(CFE_MSG_PTR(CmdMsg->Header),  CFE_SB_ValueToMsgId(MsgEntry.Buffer[0]), sizeof(CmdMsg->Header)+MsgEntry.PayloadWordCnt*2);
+               if (RetStatus && !StageEntry(Id, MsgWords, i))
+               {
+                  ReadMsg = false;
+                  RetStatus = false;
+               }
 
             } /* End if valid attributes */
             else
@@ -473,7 +1099,7 @@ static bool LoadJsonData(size_t JsonFileLen)
          {
             CFE_EVS_SendEvent(MSGTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
                               "Message[%d] has an invalid ID value of %d. Valid ID range is 0 to %d",
-                              MsgArrayIdx, JsonMessage.Id.Value, (MSGTBL_MAX_ENTRIES-1));
+                              MsgArrayIdx, Id, (MSGTBL_MAX_ENTRIES-1));
          }
          
          MsgArrayIdx++;
@@ -495,10 +1121,15 @@ static bool LoadJsonData(size_t JsonFileLen)
    {
       if (RetStatus == true)
       {
-         memcpy(&MsgTbl->Data,&TblData, sizeof(MSGTBL_Data_t));
+         RetStatus = LoadPatch ? StagePatch() : CommitLoad();
+      }
+      if (RetStatus == true)
+      {
+         
          MsgTbl->LastLoadCnt = MsgArrayIdx;
          CFE_EVS_SendEvent(MSGTBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
-                           "Message Table load updated %d entries", MsgArrayIdx);
+                           "Message Table %s %d entries", 
+                           LoadPatch ? "patch staged" : "load updated", MsgArrayIdx);
       }
    }
    
@@ -577,10 +1208,7 @@ static char *SplitStr(char *Str, const char *Delim) {
    Str[i] = '\0';
 
    /* save the rest of the string */
-   if ((Str + i + 1) != 0)
-      StaticStr = (Str + i + 1);
-   else
-      StaticStr = NULL;
+   StaticStr = (Str + i + 1);
 
    return Str;
 
@@ -21,6 +21,12 @@
 **       is passed to the constructor and saved for all other operations.
 **       This is a table-specific file so it doesn't need to be re-entrant.
 **    2. The table file is a JSON text file.
+**    3. Message definitions are packed into a MSGTBL_STORE_WORDS store
+**       and each entry records its offset and length so memory is
+**       proportional to the defined messages rather than MSGTBL_MAX_ENTRIES
+**       worst-case messages. The store is repacked when a load is
+**       accepted. The software bus messages built from the definitions are
+**       packed the same way.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide
@@ -51,6 +57,32 @@
 #define MSGTBL_LOAD_ERR_EID  (MSGTBL_BASE_EID + 1)
 #define MSGTBL_DUMP_EID      (MSGTBL_BASE_EID + 2)
 #define MSGTBL_DUMP_ERR_EID  (MSGTBL_BASE_EID + 3)
+#define MSGTBL_PATCH_EID     (MSGTBL_BASE_EID + 4)
+#define MSGTBL_TIMING_EID    (MSGTBL_BASE_EID + 5)
+#define MSGTBL_PATCH_ERR_EID (MSGTBL_BASE_EID + 6)
+
+/*
+** A definition is the primary header's topic-id, seq-seg and length words
+** followed by the data words
+*/
+
+#define MSGTBL_HDR_WORDS  3
+
+/*
+** Command message storage. Messages are 4-byte aligned. Each definition's
+** message is its data words following a command header so the buffer holds
+** every store word plus each entry's header growth and alignment padding.
+*/
+
+#define MSGTBL_CMD_UNDEF      0xFFFF
+#define MSGTBL_CMD_BUF_BYTES  (MSGTBL_STORE_WORDS*2 + \
+                               MSGTBL_MAX_ENTRIES*(sizeof(CFE_MSG_CommandHeader_t) - MSGTBL_HDR_WORDS*2 + 3))
+
+/*
+** Patch load change log
+*/
+
+#define MSGTBL_CHANGE_LOG_LEN  16
 
 
 /**********************/
@@ -65,8 +97,8 @@
 typedef struct
 {
    
-   uint16  Buffer[MSGTBL_MAX_MSG_WORDS];
-   uint16  PayloadWordCnt;
+   uint16  Offset;    /* First definition word in the store */
+   uint16  WordCnt;   /* Header and data words, 0 if the entry is undefined */
     
 } MSGTBL_Entry_t;
 
@@ -75,24 +107,32 @@ typedef struct
 {
 
    MSGTBL_Entry_t Entry[MSGTBL_MAX_ENTRIES];
+   uint16         StoreUsed;
+   uint16         Store[MSGTBL_STORE_WORDS];
 
 } MSGTBL_Data_t;
 
 
 typedef struct
 {
-    CFE_MSG_CommandHeader_t Header;
-    uint16                  Payload[MSGTBL_MAX_MSG_WORDS - sizeof(CFE_MSG_CommandHeader_t)/2];
 
-} MSGTBL_CmdMsg_t;
+   uint16  Offset[MSGTBL_MAX_ENTRIES];     /* In Buf elements, MSGTBL_CMD_UNDEF if undefined */
+   uint32  Buf[(MSGTBL_CMD_BUF_BYTES+3)/4];
+
+} MSGTBL_Commands_t;
 
+/*
+** Patch load change log entry
+*/
 
 typedef struct
 {
 
-   MSGTBL_CmdMsg_t Msg[MSGTBL_MAX_ENTRIES];
+   uint16  PatchCnt;      /* Patch load that made the change */
+   uint16  Index;         /* Message table index */
+
+} MSGTBL_Change_t;
 
-} MSGTBL_Commands_t;
 
 typedef struct
 {
@@ -117,9 +157,26 @@ typedef struct
    bool         Loaded;   /* Has entire table been loaded? */
    uint8        LastLoadStatus;
    uint16       LastLoadCnt;
+   uint32       LoadPerfId;
+   uint32       LastLoadUs;   /* Time to read the last successful load */
+   uint32       LastDumpUs;   /* Time to write the last successful dump */
+   
+   /*
+   ** Patch loads. A patch file is validated into the staged patch and it is
+   ** only packed into Data when it is activated. The change log is a
+   ** circular buffer of the most recent entries changed by patches.
+   */
+   
+   bool            PatchStaged;
+   uint16          StagedEntryCnt;
+   uint16          StagedEntry[MSGTBL_MAX_ENTRIES];
+   MSGTBL_Data_t   Staged;         /* Only the listed entries are defined */
+   
+   uint16          PatchCnt;
+   uint16          ChangeLogIdx;   /* Next change log entry to be written */
+   MSGTBL_Change_t ChangeLog[MSGTBL_CHANGE_LOG_LEN];
    
    size_t       JsonObjCnt;
-   char         JsonBuf[MSGTBL_JSON_FILE_MAX_CHAR];   
    size_t       JsonFileLen;
    
 } MSGTBL_Class_t;
@@ -138,8 +195,9 @@ typedef struct
 **   1. This must be called prior to any other function.
 **   2. The local table data is not populated. This is done when the table is 
 **      registered with the app framework table manager.
+**   3. LoadPerfId is the performance log ID that marks JSON file loads.
 */
-void MSGTBL_Constructor(MSGTBL_Class_t* ObjPtr, const char* AppName);
+void MSGTBL_Constructor(MSGTBL_Class_t* ObjPtr, const char* AppName, uint32 LoadPerfId);
 
 
 /******************************************************************************
@@ -165,11 +223,91 @@ bool MSGTBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename);
 **  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
 **  2. Can assume valid table file name because this is a callback from 
 **     the app framework table manager.
+**  3. A KIT_SCH_LOAD_TBL_PATCH load only stages the entries listed in the
+**     file and the table isn't changed until MSGTBL_ActivatePatch() is
+**     called.
+**  4. A load is rejected if it undefines an entry that is sent by an
+**     enabled scheduler table entry or trigger.
 **
 */
 bool MSGTBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
 
 
+/******************************************************************************
+** Function: MSGTBL_ActivatePatch
+**
+** Pack the staged patch entries into the table and record them in the change
+** log.
+**
+** Notes:
+**  1. The patch is packed with the current table so it is validated again.
+**     The patch remains staged if it is rejected.
+**  2. Caller must ensure the scheduler isn't sending table messages.
+**
+*/
+bool MSGTBL_ActivatePatch(void);
+
+
+/******************************************************************************
+** Function: MSGTBL_DiscardPatch
+**
+** Discard the staged patch without changing the table.
+*/
+bool MSGTBL_DiscardPatch(void);
+
+
+/******************************************************************************
+** Function: MSGTBL_EntryDefined
+**
+** Return true if a message table entry has a valid message ID.
+**
+*/
+bool MSGTBL_EntryDefined(uint16 Index);
+
+
+/******************************************************************************
+** Function: MSGTBL_GetCmdMsg
+**
+** Return the software bus message for an entry or NULL if the entry is
+** undefined.
+**
+*/
+CFE_MSG_Message_t* MSGTBL_GetCmdMsg(uint16 Index);
+
+
+/******************************************************************************
+** Function: MSGTBL_GetMsgBytes
+**
+** Return the length of the message sent for an entry or 0 if the entry is
+** undefined.
+**
+*/
+uint16 MSGTBL_GetMsgBytes(uint16 Index);
+
+
+/******************************************************************************
+** Function: MSGTBL_GetEntryWords
+**
+** Return an entry's definition word count and set Words to the definition.
+**
+** Notes:
+**   1. Returns 0 and Words is not set if the entry is undefined.
+**
+*/
+uint16 MSGTBL_GetEntryWords(uint16 Index, const uint16** Words);
+
+
+/******************************************************************************
+** Function: MSGTBL_PatchEntry
+**
+** Define a single entry using the same validation and change log as a
+** KIT_SCH_LOAD_TBL_PATCH load. The entry is changed immediately, it isn't
+** staged.
+**
+*/
+bool MSGTBL_PatchEntry(uint16 Index, const uint16* Words, uint16 WordCnt);
+
+
 /******************************************************************************
 ** Function: MSGTBL_ResetStatus
 **
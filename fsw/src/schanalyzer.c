@@ -0,0 +1,361 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the scheduler table static analyzer
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "schanalyzer.h"
+#include "msgtbl.h"
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static uint32 AnalyzeSlot(uint16 Slot);
+static bool   CheckEntry(uint16 EntryIdx);
+static void   CheckTriggers(void);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCHANALYZER_Class_t*  SchAnalyzer = NULL;
+static const SCHTBL_Data_t*  SchTblData  = NULL;
+
+
+/******************************************************************************
+** Function: SCHANALYZER_Constructor
+**
+*/
+void SCHANALYZER_Constructor(SCHANALYZER_Class_t* ObjPtr, const INITBL_Class_t* IniTbl,
+                             const SCHTBL_Data_t* TblData)
+{
+
+   SchAnalyzer = ObjPtr;
+   SchTblData  = TblData;
+
+   CFE_PSP_MemSet((void*)SchAnalyzer, 0, sizeof(SCHANALYZER_Class_t));
+
+   CFE_MSG_Init(CFE_MSG_PTR(SchAnalyzer->TlmPkt.TlmHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_KIT_SCH_ANALYSIS_TLM_TOPICID)), SCHANALYZER_TLM_LEN);
+
+} /* End SCHANALYZER_Constructor() */
+
+
+/******************************************************************************
+** Function: SCHANALYZER_Run
+**
+*/
+bool SCHANALYZER_Run(void)
+{
+
+   SCHANALYZER_TlmPkt_t* TlmPkt = &SchAnalyzer->TlmPkt;
+   uint32 Hyperperiod = 1;
+   uint16 Slot;
+   uint16 EntryIdx;
+   const SCHTBL_Entry_t* Entry;
+
+   TlmPkt->AnalysisCnt++;
+   TlmPkt->UnreachableCnt    = 0;
+   TlmPkt->DanglingCnt       = 0;
+   TlmPkt->FirstUnreachable  = SCHANALYZER_ENTRY_NONE;
+   TlmPkt->FirstDangling     = SCHANALYZER_ENTRY_NONE;
+   TlmPkt->OverloadedSlotCnt = 0;
+   TlmPkt->WorstSlot         = 0;
+
+   for (Slot=0; Slot < SCHTBL_SLOTS; Slot++)
+   {
+
+      Hyperperiod = SCHANALYZER_LeastCommonMultiple(Hyperperiod, AnalyzeSlot(Slot));
+
+      if (TlmPkt->Slot[Slot].WorstBytes > TlmPkt->Slot[TlmPkt->WorstSlot].WorstBytes)
+      {
+         TlmPkt->WorstSlot = Slot;
+      }
+
+      if (TlmPkt->Slot[Slot].Overloaded)
+      {
+         TlmPkt->OverloadedSlotCnt++;
+         CFE_EVS_SendEvent(SCHANALYZER_SLOT_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Scheduler table slot %d worst case of %d messages and %d bytes exceeds the %d message and %d byte budget",
+                           Slot, TlmPkt->Slot[Slot].WorstMsgCnt, TlmPkt->Slot[Slot].WorstBytes,
+                           SCHANALYZER_SLOT_MSG_BUDGET, SCHANALYZER_SLOT_BYTE_BUDGET);
+      }
+
+   } /* End slot loop */
+
+   CheckTriggers();
+
+   TlmPkt->Hyperperiod = Hyperperiod;
+
+   if (TlmPkt->UnreachableCnt > 0)
+   {
+      EntryIdx = TlmPkt->FirstUnreachable;
+      Entry    = &SchTblData->Entry[EntryIdx];
+      CFE_EVS_SendEvent(SCHANALYZER_ENTRY_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Scheduler table has %d unreachable entries. First is slot %d activity %d with (Period,Offset)=>(%d,%d)",
+                        TlmPkt->UnreachableCnt, (EntryIdx / SCHTBL_ACTIVITIES_PER_SLOT),
+                        (EntryIdx % SCHTBL_ACTIVITIES_PER_SLOT), Entry->Period, Entry->Offset);
+   }
+
+   if (TlmPkt->DanglingCnt > 0)
+   {
+      EntryIdx = TlmPkt->FirstDangling;
+      if (EntryIdx < SCHTBL_MAX_ENTRIES)
+      {
+         CFE_EVS_SendEvent(SCHANALYZER_ENTRY_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Scheduler table has %d references to undefined messages. First is slot %d activity %d with message %d",
+                           TlmPkt->DanglingCnt, (EntryIdx / SCHTBL_ACTIVITIES_PER_SLOT),
+                           (EntryIdx % SCHTBL_ACTIVITIES_PER_SLOT), SchTblData->Entry[EntryIdx].MsgTblIndex);
+      }
+      else
+      {
+         EntryIdx -= SCHTBL_MAX_ENTRIES;
+         CFE_EVS_SendEvent(SCHANALYZER_ENTRY_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Scheduler table has %d references to undefined messages. First is trigger %d with message %d",
+                           TlmPkt->DanglingCnt, EntryIdx, SchTblData->Trigger[EntryIdx].MsgTblIndex);
+      }
+   }
+
+   CFE_EVS_SendEvent(SCHANALYZER_RESULT_EID, CFE_EVS_EventType_INFORMATION,
+                     "Scheduler table analysis: Hyperperiod %d, worst slot %d with %d bytes, %d unreachable, %d dangling, %d overloaded slots",
+                     TlmPkt->Hyperperiod, TlmPkt->WorstSlot, TlmPkt->Slot[TlmPkt->WorstSlot].WorstBytes,
+                     TlmPkt->UnreachableCnt, TlmPkt->DanglingCnt, TlmPkt->OverloadedSlotCnt);
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(TlmPkt->TlmHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(TlmPkt->TlmHeader), true);
+
+   return ((TlmPkt->UnreachableCnt == 0) && (TlmPkt->DanglingCnt == 0) && (TlmPkt->OverloadedSlotCnt == 0));
+
+} /* End SCHANALYZER_Run() */
+
+
+/******************************************************************************
+** Function: SCHANALYZER_AnalyzeCmd
+**
+*/
+bool SCHANALYZER_AnalyzeCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   SCHANALYZER_Run();
+
+   /* Analysis errors are reported in events and telemetry. The command succeeded. */
+   return true;
+
+} /* End SCHANALYZER_AnalyzeCmd() */
+
+
+/******************************************************************************
+** Function: SCHANALYZER_LeastCommonMultiple
+**
+*/
+uint32 SCHANALYZER_LeastCommonMultiple(uint32 A, uint32 B)
+{
+
+   uint32 Gcd = A;
+   uint32 Rem = B;
+   uint32 Tmp;
+   uint32 Lcm = 0;
+
+   if ((A > 0) && (B > 0))
+   {
+
+      while (Rem != 0)
+      {
+         Tmp = Gcd % Rem;
+         Gcd = Rem;
+         Rem = Tmp;
+      }
+
+      Lcm = (A / Gcd) * B;
+      if (Lcm > SCHANALYZER_MAX_PASSES)
+      {
+         Lcm = 0;
+      }
+
+   }
+
+   return Lcm;
+
+} /* End SCHANALYZER_LeastCommonMultiple() */
+
+
+/******************************************************************************
+** Function: AnalyzeSlot
+**
+** Compute a slot's worst-case load and return the least common multiple of
+** its enabled periods or 0 if it's greater than SCHANALYZER_MAX_PASSES.
+**
+** Notes:
+**   1. Every pass in the slot's period is evaluated. The slot repeats after
+**      its period so this covers every pass in the hyperperiod.
+**   2. Entries that can't be sent don't contribute to the load.
+**
+*/
+static uint32 AnalyzeSlot(uint16 Slot)
+{
+
+   SCHANALYZER_Slot_t* SlotLoad = &SchAnalyzer->TlmPkt.Slot[Slot];
+   const SCHTBL_Entry_t* Entry[SCHTBL_ACTIVITIES_PER_SLOT];
+   uint16 Bytes[SCHTBL_ACTIVITIES_PER_SLOT];
+   uint16 EntryCnt = 0;
+   uint16 Activity, i;
+   uint16 EntryIdx;
+   uint16 PassMsgCnt, PassBytes;
+   uint32 Pass;
+   uint32 SlotPeriod = 1;
+
+   SlotLoad->WorstMsgCnt = 0;
+   SlotLoad->WorstBytes  = 0;
+
+   for (Activity=0; Activity < SCHTBL_ACTIVITIES_PER_SLOT; Activity++)
+   {
+
+      EntryIdx = SCHTBL_INDEX(Slot, Activity);
+      if (CheckEntry(EntryIdx))
+      {
+         Entry[EntryCnt] = &SchTblData->Entry[EntryIdx];
+         Bytes[EntryCnt] = MSGTBL_GetMsgBytes(Entry[EntryCnt]->MsgTblIndex);
+         SlotPeriod = SCHANALYZER_LeastCommonMultiple(SlotPeriod, Entry[EntryCnt]->Period);
+         EntryCnt++;
+      }
+
+   } /* End activity loop */
+
+   SlotLoad->ActivityCnt = EntryCnt;
+   SlotLoad->Bounded     = (SlotPeriod == 0);
+
+   if (SlotLoad->Bounded)
+   {
+
+      for (i=0; i < EntryCnt; i++)
+      {
+         SlotLoad->WorstBytes += Bytes[i];
+      }
+      SlotLoad->WorstMsgCnt = EntryCnt;
+
+   }
+   else
+   {
+
+      for (Pass=0; Pass < SlotPeriod; Pass++)
+      {
+
+         PassMsgCnt = 0;
+         PassBytes  = 0;
+         for (i=0; i < EntryCnt; i++)
+         {
+            if ((Pass % Entry[i]->Period) == Entry[i]->Offset)
+            {
+               PassMsgCnt++;
+               PassBytes += Bytes[i];
+            }
+         }
+
+         if (PassMsgCnt > SlotLoad->WorstMsgCnt) SlotLoad->WorstMsgCnt = PassMsgCnt;
+         if (PassBytes  > SlotLoad->WorstBytes)  SlotLoad->WorstBytes  = PassBytes;
+
+      } /* End pass loop */
+   }
+
+   SlotLoad->Overloaded = ((SlotLoad->WorstMsgCnt > SCHANALYZER_SLOT_MSG_BUDGET) ||
+                           (SlotLoad->WorstBytes  > SCHANALYZER_SLOT_BYTE_BUDGET));
+
+   return SlotPeriod;
+
+} /* End AnalyzeSlot() */
+
+
+/******************************************************************************
+** Function: CheckEntry
+**
+** Return true if an entry is enabled and can be sent. Unreachable entries and
+** dangling message references are counted.
+**
+*/
+static bool CheckEntry(uint16 EntryIdx)
+{
+
+   const SCHTBL_Entry_t* Entry = &SchTblData->Entry[EntryIdx];
+   SCHANALYZER_TlmPkt_t* TlmPkt = &SchAnalyzer->TlmPkt;
+   bool RetStatus = false;
+
+   if (Entry->Enabled)
+   {
+
+      if ((Entry->Period == 0) || (Entry->Offset >= Entry->Period))
+      {
+         if (TlmPkt->UnreachableCnt++ == 0)
+         {
+            TlmPkt->FirstUnreachable = EntryIdx;
+         }
+      }
+      else if (!MSGTBL_EntryDefined(Entry->MsgTblIndex))
+      {
+         if (TlmPkt->DanglingCnt++ == 0)
+         {
+            TlmPkt->FirstDangling = EntryIdx;
+         }
+      }
+      else
+      {
+         RetStatus = true;
+      }
+
+   } /* End if enabled */
+
+   return RetStatus;
+
+} /* End CheckEntry() */
+
+
+/******************************************************************************
+** Function: CheckTriggers
+**
+** Count enabled triggers that reference undefined messages.
+**
+*/
+static void CheckTriggers(void)
+{
+
+   SCHANALYZER_TlmPkt_t* TlmPkt = &SchAnalyzer->TlmPkt;
+   uint16 i;
+
+   for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+   {
+      if (SchTblData->Trigger[i].Enabled && !MSGTBL_EntryDefined(SchTblData->Trigger[i].MsgTblIndex))
+      {
+         if (TlmPkt->DanglingCnt++ == 0)
+         {
+            TlmPkt->FirstDangling = SCHTBL_MAX_ENTRIES + i;
+         }
+      }
+   }
+
+} /* End CheckTriggers() */
+
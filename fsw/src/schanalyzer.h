@@ -0,0 +1,179 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the scheduler table static analyzer
+**
+**  Notes:
+**    1. The analyzer computes each slot's worst-case message count and
+**       message bytes over the table's hyperperiod and flags entries that
+**       can never be sent or that reference undefined messages. It runs
+**       after each scheduler or message table load and on command. It isn't
+**       run when a schedule mode is activated because that is done by the
+**       scheduler task between slots.
+**    2. An entry is sent when TablePassCount % Period equals its Offset.
+**       The hyperperiod is the least common multiple of the enabled
+**       periods so every combination of passes occurs within it.
+**    3. Worst cases assume every group is enabled and nothing is shed.
+**       Event-triggered activities aren't periodic so they aren't included
+**       in the slot loads.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _schanalyzer_
+#define _schanalyzer_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "schtbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SCHANALYZER_ENTRY_NONE  0xFFFF
+
+/*
+** Event Message IDs
+*/
+
+#define SCHANALYZER_RESULT_EID     (SCHANALYZER_BASE_EID + 0)
+#define SCHANALYZER_ENTRY_ERR_EID  (SCHANALYZER_BASE_EID + 1)
+#define SCHANALYZER_SLOT_ERR_EID   (SCHANALYZER_BASE_EID + 2)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Telemetry Packets
+*/
+
+/*
+** Slot load. Bounded is true if the slot's periods have a least common
+** multiple greater than SCHANALYZER_MAX_PASSES. The worst case is then the
+** sum of every reachable activity in the slot.
+*/
+
+typedef struct
+{
+
+   uint16  WorstMsgCnt;    /* Most messages sent by the slot in one pass */
+   uint16  WorstBytes;     /* Most message bytes sent by the slot in one pass */
+   uint16  ActivityCnt;    /* Enabled activities that can be sent */
+   bool    Bounded;
+   bool    Overloaded;     /* Worst case exceeds a SCHANALYZER_SLOT_*_BUDGET */
+
+} SCHANALYZER_Slot_t;
+
+
+typedef struct
+{
+
+   CFE_MSG_TelemetryHeader_t TlmHeader;
+
+   uint32  AnalysisCnt;
+   uint32  Hyperperiod;         /* Major frames, 0 if greater than SCHANALYZER_MAX_PASSES */
+
+   uint16  UnreachableCnt;      /* Enabled entries with a zero Period or Offset >= Period */
+   uint16  DanglingCnt;         /* Enabled entries and triggers that reference undefined messages */
+   uint16  FirstUnreachable;    /* Entry index or SCHANALYZER_ENTRY_NONE */
+   uint16  FirstDangling;       /* Entry index, SCHTBL_MAX_ENTRIES+trigger index or SCHANALYZER_ENTRY_NONE */
+   uint16  OverloadedSlotCnt;
+   uint16  WorstSlot;           /* Slot with the most worst-case bytes */
+
+   SCHANALYZER_Slot_t Slot[SCHTBL_SLOTS];
+
+} SCHANALYZER_TlmPkt_t;
+#define SCHANALYZER_TLM_LEN sizeof (SCHANALYZER_TlmPkt_t)
+
+
+/******************************************************************************
+** Schedule Analyzer Class
+*/
+
+typedef struct
+{
+
+   SCHANALYZER_TlmPkt_t  TlmPkt;
+
+} SCHANALYZER_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCHANALYZER_Constructor
+**
+** Notes:
+**   1. This must be called prior to any other function and before the
+**      tables are loaded.
+**   2. TblData is the active scheduler table's data.
+**
+*/
+void SCHANALYZER_Constructor(SCHANALYZER_Class_t* ObjPtr, const INITBL_Class_t* IniTbl,
+                             const SCHTBL_Data_t* TblData);
+
+
+/******************************************************************************
+** Function: SCHANALYZER_Run
+**
+** Analyze the active scheduler table and send the analysis telemetry
+** packet.
+**
+** Notes:
+**   1. An error event is sent for the first unreachable entry, the first
+**      dangling message reference and each overloaded slot.
+**   2. Returns true if no errors were found.
+**
+*/
+bool SCHANALYZER_Run(void);
+
+
+/******************************************************************************
+** Function: SCHANALYZER_AnalyzeCmd
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**
+*/
+bool SCHANALYZER_AnalyzeCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCHANALYZER_LeastCommonMultiple
+**
+** Return the least common multiple of two periods.
+**
+** Notes:
+**   1. Returns 0 if either argument is 0 or the result is greater than
+**      SCHANALYZER_MAX_PASSES.
+**
+*/
+uint32 SCHANALYZER_LeastCommonMultiple(uint32 A, uint32 B);
+
+
+#endif /* _schanalyzer_ */
@@ -0,0 +1,454 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the scheduler table offset balancer
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "schbalancer.h"
+#include "schanalyzer.h"
+#include "msgtbl.h"
+#include "loadarena.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint16  EntryIdx;
+   uint16  Weight;
+
+} Candidate_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static bool   Schedulable(const SCHTBL_Entry_t* Entry);
+static uint32 Hyperperiod(void);
+static void   UpdateLoad(uint16 Slot, const SCHTBL_Entry_t* Entry, uint16 Weight, bool Add);
+static void   PlacementCost(uint16 Slot, uint8 Period, uint8 Offset, uint16 Weight,
+                            uint32* Peak, uint32* Sum);
+static uint16 PeakLoad(void);
+static uint16 FreeActivity(uint16 Slot);
+static uint16 BuildLoads(Candidate_t* Candidate, uint8 Metric);
+static bool   PlaceCandidate(const Candidate_t* Candidate, bool MoveSlots);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCHBALANCER_Class_t*  SchBalancer = NULL;
+static const SCHTBL_Data_t*  SchTblData  = NULL;
+
+static uint16*  Load = NULL;   /* [SCHTBL_SLOTS][Hyperperiod] in the load arena */
+
+
+/******************************************************************************
+** Function: SCHBALANCER_Constructor
+**
+*/
+void SCHBALANCER_Constructor(SCHBALANCER_Class_t* ObjPtr, const SCHTBL_Data_t* TblData)
+{
+
+   SchBalancer = ObjPtr;
+   SchTblData  = TblData;
+
+   CFE_PSP_MemSet((void*)SchBalancer, 0, sizeof(SCHBALANCER_Class_t));
+
+} /* End SCHBALANCER_Constructor() */
+
+
+/******************************************************************************
+** Function: SCHBALANCER_BalanceCmd
+**
+*/
+bool SCHBALANCER_BalanceCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const SCHBALANCER_BalanceCmdMsg_t *BalanceCmd = (const SCHBALANCER_BalanceCmdMsg_t *) MsgPtr;
+   Candidate_t  Candidate[SCHTBL_MAX_ENTRIES];
+   uint16       CandidateCnt;
+   uint16       RecordCnt;
+   uint16       i;
+   char         Filename[OS_MAX_PATH_LEN];
+
+   if (BalanceCmd->Metric > SCHBALANCER_METRIC_BYTES)
+   {
+      CFE_EVS_SendEvent(SCHBALANCER_BALANCE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Balance command rejected. Invalid metric %d, must be %d(messages) or %d(bytes)",
+                        BalanceCmd->Metric, SCHBALANCER_METRIC_MSGS, SCHBALANCER_METRIC_BYTES);
+      return false;
+   }
+
+   strncpy(Filename, BalanceCmd->Filename, OS_MAX_PATH_LEN);
+   Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+   SchBalancer->Hyperperiod = Hyperperiod();
+   if (SchBalancer->Hyperperiod == 0)
+   {
+      CFE_EVS_SendEvent(SCHBALANCER_BALANCE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Balance command rejected. Table hyperperiod exceeds %d major frames",
+                        SCHANALYZER_MAX_PASSES);
+      return false;
+   }
+
+   LOADARENA_Reset();
+   Load = LOADARENA_Alloc(SCHTBL_SLOTS * SchBalancer->Hyperperiod * sizeof(uint16));
+   if (Load == NULL)
+   {
+      CFE_EVS_SendEvent(SCHBALANCER_BALANCE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Balance command rejected. Slot loads for a %d major frame hyperperiod exceed the %d byte load arena",
+                        SchBalancer->Hyperperiod, LOADARENA_SIZE);
+      return false;
+   }
+   memset(Load, 0, SCHTBL_SLOTS * SchBalancer->Hyperperiod * sizeof(uint16));
+
+   memcpy(&SchBalancer->Shadow, SchTblData, sizeof(SCHTBL_Data_t));
+   SchBalancer->BalanceCnt++;
+   SchBalancer->MovedCnt = 0;
+
+   CandidateCnt = BuildLoads(Candidate, BalanceCmd->Metric);
+   SchBalancer->PeakBefore = PeakLoad();
+
+   /* Remove all of the movable loads so each is placed against the fixed loads */
+   for (i=0; i < CandidateCnt; i++)
+   {
+      UpdateLoad(Candidate[i].EntryIdx / SCHTBL_ACTIVITIES_PER_SLOT,
+                 &SchTblData->Entry[Candidate[i].EntryIdx], Candidate[i].Weight, false);
+   }
+
+   for (i=0; i < CandidateCnt; i++)
+   {
+      if (PlaceCandidate(&Candidate[i], (BalanceCmd->MoveSlots != 0)))
+      {
+         SchBalancer->MovedCnt++;
+      }
+   }
+
+   SchBalancer->PeakAfter = PeakLoad();
+
+   if (SchBalancer->PeakAfter >= SchBalancer->PeakBefore)
+   {
+      memcpy(&SchBalancer->Shadow, SchTblData, sizeof(SCHTBL_Data_t));
+      SchBalancer->PeakAfter = SchBalancer->PeakBefore;
+      SchBalancer->MovedCnt  = 0;
+   }
+
+   CFE_EVS_SendEvent(SCHBALANCER_BALANCE_EID, CFE_EVS_EventType_INFORMATION,
+                     "Balanced %d movable activities by %s over %d major frames. Peak slot load %d => %d, %d activities moved",
+                     CandidateCnt, (BalanceCmd->Metric == SCHBALANCER_METRIC_BYTES) ? "bytes" : "messages",
+                     SchBalancer->Hyperperiod, SchBalancer->PeakBefore, SchBalancer->PeakAfter,
+                     SchBalancer->MovedCnt);
+
+   return SCHTBL_DumpData(&SchBalancer->Shadow, KIT_SCH_DUMP_TBL_FULL, Filename, &RecordCnt);
+
+} /* End SCHBALANCER_BalanceCmd() */
+
+
+/******************************************************************************
+** Function: Schedulable
+**
+** Return true if an entry is enabled and can be sent.
+**
+*/
+static bool Schedulable(const SCHTBL_Entry_t* Entry)
+{
+
+   return (Entry->Enabled && (Entry->Period > 0) && (Entry->Offset < Entry->Period) &&
+           MSGTBL_EntryDefined(Entry->MsgTblIndex));
+
+} /* End Schedulable() */
+
+
+/******************************************************************************
+** Function: Hyperperiod
+**
+** Return the least common multiple of the schedulable entries' periods or 0
+** if it's greater than SCHANALYZER_MAX_PASSES.
+**
+*/
+static uint32 Hyperperiod(void)
+{
+
+   uint32 Lcm = 1;
+   uint16 EntryIdx;
+
+   for (EntryIdx=0; (EntryIdx < SCHTBL_MAX_ENTRIES) && (Lcm > 0); EntryIdx++)
+   {
+      if (Schedulable(&SchTblData->Entry[EntryIdx]))
+      {
+         Lcm = SCHANALYZER_LeastCommonMultiple(Lcm, SchTblData->Entry[EntryIdx].Period);
+      }
+   }
+
+   return Lcm;
+
+} /* End Hyperperiod() */
+
+
+/******************************************************************************
+** Function: UpdateLoad
+**
+** Add or remove an entry's weight from every pass it's sent in.
+**
+*/
+static void UpdateLoad(uint16 Slot, const SCHTBL_Entry_t* Entry, uint16 Weight, bool Add)
+{
+
+   uint16* SlotLoad = &Load[Slot * SchBalancer->Hyperperiod];
+   uint32  Pass;
+
+   for (Pass=Entry->Offset; Pass < SchBalancer->Hyperperiod; Pass += Entry->Period)
+   {
+      if (Add)
+      {
+         SlotLoad[Pass] += Weight;
+      }
+      else
+      {
+         SlotLoad[Pass] -= Weight;
+      }
+   }
+
+} /* End UpdateLoad() */
+
+
+/******************************************************************************
+** Function: PlacementCost
+**
+** Compute the peak and total load of the passes a placement is sent in
+** including its own weight.
+**
+*/
+static void PlacementCost(uint16 Slot, uint8 Period, uint8 Offset, uint16 Weight,
+                          uint32* Peak, uint32* Sum)
+{
+
+   const uint16* SlotLoad = &Load[Slot * SchBalancer->Hyperperiod];
+   uint32  Pass;
+
+   *Peak = 0;
+   *Sum  = 0;
+
+   for (Pass=Offset; Pass < SchBalancer->Hyperperiod; Pass += Period)
+   {
+      if (SlotLoad[Pass] > *Peak)
+      {
+         *Peak = SlotLoad[Pass];
+      }
+      *Sum += SlotLoad[Pass] + Weight;
+   }
+
+   *Peak += Weight;
+
+} /* End PlacementCost() */
+
+
+/******************************************************************************
+** Function: PeakLoad
+**
+*/
+static uint16 PeakLoad(void)
+{
+
+   uint16 Peak = 0;
+   uint32 i;
+
+   for (i=0; i < (SCHTBL_SLOTS * SchBalancer->Hyperperiod); i++)
+   {
+      if (Load[i] > Peak)
+      {
+         Peak = Load[i];
+      }
+   }
+
+   return Peak;
+
+} /* End PeakLoad() */
+
+
+/******************************************************************************
+** Function: FreeActivity
+**
+** Return the index of the first unused shadow table entry in a slot or
+** SCHTBL_MAX_ENTRIES if the slot is full.
+**
+*/
+static uint16 FreeActivity(uint16 Slot)
+{
+
+   uint16 Activity;
+   uint16 EntryIdx = SCHTBL_MAX_ENTRIES;
+
+   for (Activity=0; Activity < SCHTBL_ACTIVITIES_PER_SLOT; Activity++)
+   {
+      if (SCHTBL_EmptyEntry(&SchBalancer->Shadow.Entry[SCHTBL_INDEX(Slot,Activity)]))
+      {
+         EntryIdx = SCHTBL_INDEX(Slot,Activity);
+         break;
+      }
+   }
+
+   return EntryIdx;
+
+} /* End FreeActivity() */
+
+
+/******************************************************************************
+** Function: BuildLoads
+**
+** Add every schedulable entry to the slot loads and return the movable
+** entries ordered for placement.
+**
+** Notes:
+**   1. Heavier entries are placed first followed by entries with shorter
+**      periods because they have the fewest placements. Ties keep table
+**      order.
+**
+*/
+static uint16 BuildLoads(Candidate_t* Candidate, uint8 Metric)
+{
+
+   const SCHTBL_Entry_t* Entry;
+   Candidate_t  Next;
+   uint16       CandidateCnt = 0;
+   uint16       EntryIdx;
+   uint16       Weight;
+   int16        i;
+
+   for (EntryIdx=0; EntryIdx < SCHTBL_MAX_ENTRIES; EntryIdx++)
+   {
+
+      Entry = &SchTblData->Entry[EntryIdx];
+      if (!Schedulable(Entry))
+      {
+         continue;
+      }
+
+      Weight = (Metric == SCHBALANCER_METRIC_BYTES) ? MSGTBL_GetMsgBytes(Entry->MsgTblIndex) : 1;
+      UpdateLoad(EntryIdx / SCHTBL_ACTIVITIES_PER_SLOT, Entry, Weight, true);
+
+      if (Entry->Movable)
+      {
+
+         Next.EntryIdx = EntryIdx;
+         Next.Weight   = Weight;
+
+         for (i=CandidateCnt-1; i >= 0; i--)
+         {
+            if ((Candidate[i].Weight > Weight) ||
+                ((Candidate[i].Weight == Weight) &&
+                 (SchTblData->Entry[Candidate[i].EntryIdx].Period <= Entry->Period)))
+            {
+               break;
+            }
+            Candidate[i+1] = Candidate[i];
+         }
+         Candidate[i+1] = Next;
+         CandidateCnt++;
+
+      } /* End if movable */
+
+   } /* End entry loop */
+
+   return CandidateCnt;
+
+} /* End BuildLoads() */
+
+
+/******************************************************************************
+** Function: PlaceCandidate
+**
+** Place a movable entry at the slot and offset with the lowest peak load and
+** update the shadow table. Returns true if the entry was moved.
+**
+** Notes:
+**   1. The entry's current placement is evaluated first so it's only moved
+**      if another placement has a lower peak or the same peak with a lower
+**      total load.
+**
+*/
+static bool PlaceCandidate(const Candidate_t* Candidate, bool MoveSlots)
+{
+
+   SCHTBL_Entry_t  Entry = SchTblData->Entry[Candidate->EntryIdx];
+   uint16  EntrySlot = Candidate->EntryIdx / SCHTBL_ACTIVITIES_PER_SLOT;
+   uint16  BestSlot  = EntrySlot;
+   uint8   BestOffset = Entry.Offset;
+   uint32  BestPeak, BestSum;
+   uint32  Peak, Sum;
+   uint16  Slot;
+   uint16  NewIdx;
+   uint8   Offset;
+
+   PlacementCost(EntrySlot, Entry.Period, Entry.Offset, Candidate->Weight, &BestPeak, &BestSum);
+
+   for (Slot=0; Slot < SCHTBL_SLOTS; Slot++)
+   {
+
+      if ((Slot != EntrySlot) && (!MoveSlots || (FreeActivity(Slot) == SCHTBL_MAX_ENTRIES)))
+      {
+         continue;
+      }
+
+      for (Offset=0; Offset < Entry.Period; Offset++)
+      {
+         PlacementCost(Slot, Entry.Period, Offset, Candidate->Weight, &Peak, &Sum);
+         if ((Peak < BestPeak) || ((Peak == BestPeak) && (Sum < BestSum)))
+         {
+            BestSlot   = Slot;
+            BestOffset = Offset;
+            BestPeak   = Peak;
+            BestSum    = Sum;
+         }
+      }
+
+   } /* End slot loop */
+
+   Entry.Offset = BestOffset;
+   UpdateLoad(BestSlot, &Entry, Candidate->Weight, true);
+
+   if (BestSlot == EntrySlot)
+   {
+      SchBalancer->Shadow.Entry[Candidate->EntryIdx].Offset = BestOffset;
+   }
+   else
+   {
+      NewIdx = FreeActivity(BestSlot);
+      SchBalancer->Shadow.Entry[NewIdx] = Entry;
+      CFE_PSP_MemSet(&SchBalancer->Shadow.Entry[Candidate->EntryIdx], 0, sizeof(SCHTBL_Entry_t));
+   }
+
+   return ((BestSlot != EntrySlot) || (BestOffset != SchTblData->Entry[Candidate->EntryIdx].Offset));
+
+} /* End PlaceCandidate() */
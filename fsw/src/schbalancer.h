@@ -0,0 +1,142 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the scheduler table offset balancer
+**
+**  Notes:
+**    1. On command the balancer reassigns the Offset, and optionally the
+**       slot, of each movable activity to minimize the peak number of
+**       messages or message bytes sent in a slot over the table's
+**       hyperperiod. Activities that aren't movable are left in place.
+**    2. The result is built in a shadow copy of the active table and dumped
+**       to a file for review. The active table isn't changed. The dump can
+**       be loaded with the normal scheduler table load command.
+**    3. The balancer is greedy. Movable activities are placed one at a time,
+**       heaviest and most frequent first, at the offset that minimizes the
+**       resulting peak. An activity stays where it is unless a placement is
+**       strictly better. If the overall peak isn't reduced the shadow table
+**       is the same as the active table.
+**    4. The per-slot load over the hyperperiod is held in the load arena so
+**       the hyperperiod is limited by SCHANALYZER_MAX_PASSES and by
+**       LOADARENA_SIZE.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _schbalancer_
+#define _schbalancer_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "schtbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Balance metrics
+*/
+
+#define SCHBALANCER_METRIC_MSGS   0   /* Messages sent per slot */
+#define SCHBALANCER_METRIC_BYTES  1   /* Message bytes sent per slot */
+
+/*
+** Event Message IDs
+*/
+
+#define SCHBALANCER_BALANCE_EID      (SCHBALANCER_BASE_EID + 0)
+#define SCHBALANCER_BALANCE_ERR_EID  (SCHBALANCER_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Command Packets
+*/
+
+typedef struct
+{
+
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   uint8   Metric;       /* SCHBALANCER_METRIC_MSGS or SCHBALANCER_METRIC_BYTES */
+   uint8   MoveSlots;    /* true: Movable activities may be moved to other slots */
+   char    Filename[OS_MAX_PATH_LEN];
+
+} SCHBALANCER_BalanceCmdMsg_t;
+#define SCHBALANCER_BALANCE_CMD_DATA_LEN  (sizeof(SCHBALANCER_BalanceCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+
+/******************************************************************************
+** Schedule Balancer Class
+*/
+
+typedef struct
+{
+
+   uint32  BalanceCnt;
+   uint32  Hyperperiod;   /* Major frames in the last balance */
+   uint16  PeakBefore;    /* Peak slot load of the active table */
+   uint16  PeakAfter;     /* Peak slot load of the shadow table */
+   uint16  MovedCnt;      /* Activities with a new slot or offset */
+
+   SCHTBL_Data_t  Shadow;
+
+} SCHBALANCER_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCHBALANCER_Constructor
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. TblData is the active scheduler table's data.
+**
+*/
+void SCHBALANCER_Constructor(SCHBALANCER_Class_t* ObjPtr, const SCHTBL_Data_t* TblData);
+
+
+/******************************************************************************
+** Function: SCHBALANCER_BalanceCmd
+**
+** Balance the active table's movable activities into the shadow table and
+** dump it to the command's file.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. Only enabled activities that can be sent contribute to the load and
+**      only those that are movable are changed.
+**   3. An activity is only moved to another slot if the slot has an unused
+**      activity. The original activity is cleared.
+**
+*/
+bool SCHBALANCER_BalanceCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _schbalancer_ */
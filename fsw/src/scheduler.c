@@ -33,11 +33,18 @@
 ** Include Files:
 */
 
+#include <stdio.h>
 #include "cfe_endian.h"
 #include "cfe_time_msg.h"
 
 #include "scheduler.h"
 
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
 /******************************/
 /** File Function Prototypes **/
 /******************************/
@@ -48,6 +55,26 @@ static uint32  GetCurrentSlotNumber(void);
 static uint32  GetMETSlotNumber(void);
 static int32   ProcessNextSlot(void);
 static bool    SendTblEntryTlm(uint16 SchTblIndex, uint16 MsgTblIndex, bool UseSchTblIndex);
+static void    PublishStats(void);
+static bool    CopyFrameCounters(SCHEDULER_Stats_t* Stats);
+static int32   SendMsgTblEntry(uint16 MsgTblIndex, uint16 Slot, uint32 RefUs);
+static void    SyncTriggerSubscriptions(void);
+static int32   WaitForSlot(void);
+static void    ProcessTriggers(void);
+static void    DispatchTrigger(uint16 TriggerIndex, uint16 Slot, uint32 RefUs, uint16* FailCnt);
+static void    StartTablePass(void);
+static void    SendRateTlm(void);
+static bool    ConsumeFault(uint8 Fault);
+static void    ReportFaultInjection(void);
+static void    ClearLatency(void);
+static bool    MeasureLatency(const CFE_MSG_Message_t *CmdMsg, uint16 MsgTblIndex, uint32 RefUs);
+static uint32  MetUs(CFE_TIME_SysTime_t Met);
+static void    SendLatencyTlm(void);
+static void    UpdateHealth(void);
+static void    StartHealthWindow(void);
+static void    UpdateShedLevel(void);
+static bool    LimitEvent(uint8 Limit, uint16 Slot, uint32 Value);
+static void    SummarizeEvents(void);
 
 /**********************/
 /** Global File Data **/
@@ -55,6 +82,20 @@ static bool    SendTblEntryTlm(uint16 SchTblIndex, uint16 MsgTblIndex, bool UseS
 
 static SCHEDULER_Class_t*  Scheduler = NULL;
 
+/* Indexed by SCHEDULER_EVS_LIMIT_* */
+static const struct
+{
+   uint16       Eid;
+   uint16       EventType;
+   const char*  Name;
+} EvsLimitDef[SCHEDULER_EVS_LIMITS] =
+{
+   { SCHEDULER_SKIPPED_SLOTS_EID,    CFE_EVS_EventType_ERROR,       "Slots skipped"            },
+   { SCHEDULER_MULTI_SLOTS_EID,      CFE_EVS_EventType_INFORMATION, "Multiple slots"           },
+   { SCHEDULER_PACKET_SEND_ERR_EID,  CFE_EVS_EventType_ERROR,       "Activity error"           },
+   { SCHEDULER_TRIGGER_SEND_ERR_EID, CFE_EVS_EventType_ERROR,       "Triggered activity error" }
+};
+
 
 /************************/
 /** Exported Functions **/
@@ -67,10 +108,13 @@ static SCHEDULER_Class_t*  Scheduler = NULL;
 void SCHEDULER_Constructor(SCHEDULER_Class_t* ObjPtr, const INITBL_Class_t* IniTbl)
 {
 
-   int32 Status = CFE_SUCCESS;
+   int32  Status = CFE_SUCCESS;
+   uint16 i;
 
    Scheduler = ObjPtr;
 
+   SCHTRACE_Constructor(&Scheduler->Trace);
+
    Scheduler->SlotsProcessedCount = 0;
    Scheduler->SkippedSlotsCount   = 0;
    Scheduler->MultipleSlotsCount  = 0;
@@ -94,8 +138,53 @@ void SCHEDULER_Constructor(SCHEDULER_Class_t* ObjPtr, const INITBL_Class_t* IniT
    Scheduler->UnexpectedMajorFrameCount   = 0;
    Scheduler->MissedMajorFrameCount       = 0;
    Scheduler->ValidMajorFrameCount        = 0;
+   Scheduler->ResetUnexpectedMajorFrameCount = 0;
+   Scheduler->ResetMissedMajorFrameCount     = 0;
+   Scheduler->ResetValidMajorFrameCount      = 0;
+   Scheduler->ConsecutiveNoisyFrameCounter   = 0;
+   Scheduler->ToneSequence        = 0;
+   Scheduler->TimerSequence       = 0;
+   Scheduler->ToneResetPending    = false;
    Scheduler->WorstCaseSlotsPerMinorFrame = 1;
 
+   Scheduler->TriggerTblUpdateCnt   = 0;
+   Scheduler->TriggersPending       = 0;
+   Scheduler->TriggerDispatchCount  = 0;
+   Scheduler->TriggerCoalescedCount = 0;
+   Scheduler->ImmediateTriggers     = false;
+   Scheduler->DisabledGroups        = 0;
+   Scheduler->PendingDisabledGroups = 0;
+   Scheduler->PendingMode           = 0;
+   Scheduler->ShedLevel             = 0;
+   Scheduler->ShedClearFrames       = 0;
+   Scheduler->ShedFrameFailures     = 0;
+   Scheduler->ShedFrameOverruns     = 0;
+   Scheduler->ShedActivityCount     = 0;
+   Scheduler->PerfId                = INITBL_GetIntConfig(IniTbl, CFG_APP_PERF_ID);
+   Scheduler->InjectFault           = SCHEDULER_FAULT_NONE;
+   Scheduler->InjectSettleFrames    = 0;
+   Scheduler->InjectCnt             = 0;
+   Scheduler->LatencyEnabled        = false;
+   Scheduler->LatencyStamp          = false;
+   Scheduler->HealthWindow          = INITBL_GetIntConfig(IniTbl, CFG_HEALTH_WINDOW_FRAMES);
+   if (Scheduler->HealthWindow == 0)
+   {
+      Scheduler->HealthWindow = 1;
+   }
+   CFE_PSP_MemSet(&Scheduler->Health, 0, sizeof(SCHEDULER_Health_t));
+   StartHealthWindow();
+   CFE_PSP_MemSet(Scheduler->EvsLimit, 0, sizeof(Scheduler->EvsLimit));
+   Scheduler->EvsLimitFrames        = 0;
+   Scheduler->EventsSuppressedCount = 0;
+   CFE_PSP_MemSet(Scheduler->RateSlotMsgs, 0, sizeof(Scheduler->RateSlotMsgs));
+   CFE_PSP_MemSet(Scheduler->RateSlotFailures, 0, sizeof(Scheduler->RateSlotFailures));
+   CFE_PSP_MemSet(Scheduler->RateSlotBytes, 0, sizeof(Scheduler->RateSlotBytes));
+   CFE_PSP_MemSet(&Scheduler->RatePkt, 0, SCHEDULER_RATE_TLM_LEN);
+   for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+   {
+      Scheduler->TriggerMid[i] = CFE_SB_INVALID_MSG_ID;
+   }
+
    /*
    ** Configure Major Frame and Minor Frame sources
    */
@@ -153,16 +242,83 @@ void SCHEDULER_Constructor(SCHEDULER_Class_t* ObjPtr, const INITBL_Class_t* IniT
 
    } /* End if minor frame timer created */
 
+   /*
+   ** Subscriptions to trigger messages are made when the scheduler table
+   ** is loaded. See SyncTriggerSubscriptions().
+   */
+   Status = CFE_SB_CreatePipe(&Scheduler->TriggerPipe, SCHEDULER_TRIGGER_PIPE_DEPTH, SCHEDULER_TRIGGER_PIPE_NAME);
+   
+   if (Status != CFE_SUCCESS)
+   {
+   
+      CFE_EVS_SendEvent(SCHEDULER_TRIGGER_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating trigger message pipe (RC=0x%08X)", Status);
+   }
  
    CFE_MSG_Init(CFE_MSG_PTR(Scheduler->TblEntryPkt.TlmHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_KIT_SCH_TBL_ENTRY_TLM_TOPICID)), SCHEDULER_TBL_ENTRY_TLM_LEN);
    CFE_MSG_Init(CFE_MSG_PTR(Scheduler->DiagPkt.TlmHeader),     CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_KIT_SCH_DIAG_TLM_TOPICID)),      SCHEDULER_DIAG_TLM_LEN);
-
-   MSGTBL_Constructor(&Scheduler->MsgTbl, INITBL_GetStrConfig(IniTbl, CFG_APP_CFE_NAME));
-   SCHTBL_Constructor(&Scheduler->SchTbl, INITBL_GetStrConfig(IniTbl, CFG_APP_CFE_NAME));
+   CFE_MSG_Init(CFE_MSG_PTR(Scheduler->RatePkt.TlmHeader),     CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_KIT_SCH_RATE_TLM_TOPICID)),      SCHEDULER_RATE_TLM_LEN);
+   CFE_MSG_Init(CFE_MSG_PTR(Scheduler->LatencyPkt.TlmHeader),  CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_KIT_SCH_LATENCY_TLM_TOPICID)),   SCHEDULER_LATENCY_TLM_LEN);
+   CFE_MSG_Init(CFE_MSG_PTR(Scheduler->LatencyStampPkt.TlmHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_KIT_SCH_LATENCY_STAMP_TLM_TOPICID)), SCHEDULER_LATENCY_STAMP_TLM_LEN);
+   ClearLatency();
+
+   MSGTBL_Constructor(&Scheduler->MsgTbl, INITBL_GetStrConfig(IniTbl, CFG_APP_CFE_NAME),
+                      Scheduler->PerfId + KIT_SCH_PERF_TBL_LOAD);
+   SCHTBL_Constructor(&Scheduler->SchTbl, INITBL_GetStrConfig(IniTbl, CFG_APP_CFE_NAME),
+                      Scheduler->PerfId + KIT_SCH_PERF_TBL_LOAD);
+   SCHANALYZER_Constructor(&Scheduler->SchAnalyzer, IniTbl, &Scheduler->SchTbl.Data);
+   SCHBALANCER_Constructor(&Scheduler->SchBalancer, &Scheduler->SchTbl.Data);
+   SCHPROFILE_Constructor(&Scheduler->Profile, IniTbl);
  
+   PublishStats();
+   
 } /* End SCHEDULER_Constructor() */
 
 
+/******************************************************************************
+** Function: SCHEDULER_ActivatePatchCmd
+**
+*/
+bool SCHEDULER_ActivatePatchCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const SCHEDULER_ActivatePatchCmdMsg_t *ActivatePatchCmd = (const SCHEDULER_ActivatePatchCmdMsg_t *) MsgPtr;
+   bool  RetStatus = false;
+
+   if (!CMDMGR_ValidBoolArg(ActivatePatchCmd->Activate))
+   {
+      
+      CFE_EVS_SendEvent(SCHEDULER_ACTIVATE_PATCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Activate patch command rejected. Invalid activate value %d. Must be True(%d) or False(%d)",
+                        ActivatePatchCmd->Activate, true, false);    
+   
+   }
+   else if (ActivatePatchCmd->Tbl == SCHEDULER_PATCH_MSG_TBL)
+   {
+      
+      RetStatus = ActivatePatchCmd->Activate ? MSGTBL_ActivatePatch() : MSGTBL_DiscardPatch();
+   
+   }
+   else if (ActivatePatchCmd->Tbl == SCHEDULER_PATCH_SCH_TBL)
+   {
+      
+      RetStatus = ActivatePatchCmd->Activate ? SCHTBL_ActivatePatch() : SCHTBL_DiscardPatch();
+   
+   }
+   else
+   {
+      
+      CFE_EVS_SendEvent(SCHEDULER_ACTIVATE_PATCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Activate patch command rejected. Invalid table %d. Must be message(%d) or scheduler(%d)",
+                        ActivatePatchCmd->Tbl, SCHEDULER_PATCH_MSG_TBL, SCHEDULER_PATCH_SCH_TBL);
+   
+   }
+   
+   return RetStatus;
+
+} /* End SCHEDULER_ActivatePatchCmd() */
+
+
 /******************************************************************************
 ** Function: SCHEDULER_ConfigSchEntryCmd
 **
@@ -191,7 +347,7 @@ bool SCHEDULER_ConfigSchEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgP
             SCHTBL_Entry_t *Entry = &(Scheduler->SchTbl.Data.Entry[Index]);
             
             if (SCHTBL_ValidEntry("Scheduler table config cmd failed to enable entry", 
-                Entry->Enabled, Entry->Period, Entry->Offset, Entry->MsgTblIndex))
+                true, Entry->Period, Entry->Offset, Entry->MsgTblIndex))
             {
                RetStatus = true;
             }
@@ -208,6 +364,7 @@ bool SCHEDULER_ConfigSchEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgP
          {
             
             Scheduler->SchTbl.Data.Entry[Index].Enabled = ConfigSchEntryCmd->Enabled;
+            SCHTBL_EntryChanged(Index);
             CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
                               "Configured scheduler table slot %d activity %d to %s",
                               ConfigSchEntryCmd->Slot, ConfigSchEntryCmd->Activity,
@@ -229,6 +386,96 @@ bool SCHEDULER_ConfigSchEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgP
 } /* End SCHEDULER_ConfigSchEntryCmd() */
 
 
+/******************************************************************************
+** Function: SCHEDULER_ConfigGroupCmd
+**
+*/
+bool SCHEDULER_ConfigGroupCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const SCHEDULER_ConfigGroupCmdMsg_t *ConfigGroupCmd = (const SCHEDULER_ConfigGroupCmdMsg_t *) MsgPtr;
+   bool  RetStatus = false;
+
+   if (CMDMGR_ValidBoolArg(ConfigGroupCmd->Enabled))
+   {
+      
+      if (ConfigGroupCmd->Enabled == true)
+      {
+         Scheduler->PendingDisabledGroups &= ~ConfigGroupCmd->Groups;
+      }
+      else
+      {
+         Scheduler->PendingDisabledGroups |= ConfigGroupCmd->Groups;
+      }
+      
+      CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
+                        "Configured groups 0x%08X to %s. Disabled groups will be 0x%08X at the next major frame",
+                        ConfigGroupCmd->Groups, CMDMGR_BoolStr(ConfigGroupCmd->Enabled),
+                        Scheduler->PendingDisabledGroups);
+      
+      RetStatus = true;
+      
+   }    
+   else
+   {
+
+      CFE_EVS_SendEvent(SCHEDULER_CONFIG_GROUP_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Scheduler group config command rejected. Invalid config value %d. Must be True(%d) or False(%d)",
+                        ConfigGroupCmd->Enabled, true, false);    
+      
+   } /* End if valid boolean config */
+   
+   return RetStatus;
+
+} /* End SCHEDULER_ConfigGroupCmd() */
+
+
+/******************************************************************************
+** Function: SCHEDULER_ConfigLatencyCmd
+**
+*/
+bool SCHEDULER_ConfigLatencyCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const SCHEDULER_ConfigLatencyCmdMsg_t *ConfigLatencyCmd = (const SCHEDULER_ConfigLatencyCmdMsg_t *) MsgPtr;
+   bool  RetStatus = false;
+
+   if (CMDMGR_ValidBoolArg(ConfigLatencyCmd->Enabled) && CMDMGR_ValidBoolArg(ConfigLatencyCmd->Stamp))
+   {
+      
+      Scheduler->LatencyEnabled = false;
+      KIT_SCH_MEM_BARRIER();
+      
+      Scheduler->LatencyStamp = ConfigLatencyCmd->Stamp;
+      if (ConfigLatencyCmd->Enabled == true)
+      {
+         ClearLatency();
+         KIT_SCH_MEM_BARRIER();
+         Scheduler->LatencyEnabled = true;
+      }
+      
+      CFE_EVS_SendEvent(SCHEDULER_CFG_LATENCY_EID, CFE_EVS_EventType_INFORMATION, 
+                        "Wakeup lateness measurement %s, latency stamps %s",
+                        (ConfigLatencyCmd->Enabled ? "enabled" : "disabled"),
+                        ((ConfigLatencyCmd->Enabled && ConfigLatencyCmd->Stamp) ? "enabled" : "disabled"));
+      
+      RetStatus = true;
+      
+   }    
+   else
+   {
+
+      CFE_EVS_SendEvent(SCHEDULER_CFG_LATENCY_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Wakeup lateness config command rejected. Invalid enabled %d or stamp %d value. Must be True(%d) or False(%d)",
+                        ConfigLatencyCmd->Enabled, ConfigLatencyCmd->Stamp, true, false);    
+      
+   } /* End if valid boolean config */
+   
+   return RetStatus;
+
+} /* End SCHEDULER_ConfigLatencyCmd() */
+
+
 /******************************************************************************
 ** Function: SCHEDULER_Execute
 **
@@ -237,16 +484,28 @@ bool SCHEDULER_Execute(void)
 {
    uint32  CurrentSlot;
    uint32  ProcessCount;
+   uint32  SlotsBehind;
    int32   Result;
 
    /* Wait for the next slot (Major or Minor Frame) */
-   Result = OS_BinSemTake(Scheduler->TimeSemaphore);
+   CFE_ES_PerfLogExit(Scheduler->PerfId + KIT_SCH_PERF_APP);
+   CFE_ES_PerfLogEntry(Scheduler->PerfId + KIT_SCH_PERF_WAKEUP_WAIT);
+   
+   Result = WaitForSlot();
+   
+   CFE_ES_PerfLogExit(Scheduler->PerfId + KIT_SCH_PERF_WAKEUP_WAIT);
+   CFE_ES_PerfLogEntry(Scheduler->PerfId + KIT_SCH_PERF_APP);
+   
+   SCHTRACE_Record(SCHTRACE_SRC_TASK, SCHTRACE_SEM_TAKE, Scheduler->NextSlotNumber, 0, Result);
 
    if (Result == OS_SUCCESS)
    {
 
+      SCHPROFILE_WakeupStart();
       CFE_EVS_SendEvent(SCHEDULER_DEBUG_EID, CFE_EVS_EventType_DEBUG, "ProcessTable::OS_BinSemTake() success");
 
+      ProcessTriggers();
+
       if (Scheduler->IgnoreMajorFrame)
       {
          
@@ -279,6 +538,8 @@ bool SCHEDULER_Execute(void)
          
          ProcessCount = (CurrentSlot - Scheduler->NextSlotNumber) + 1;
       }
+      SlotsBehind = ProcessCount;
+      SCHPROFILE_SlotLag((ProcessCount == SCHTBL_SLOTS) ? 0 : ProcessCount);
 
       CFE_EVS_SendEvent(SCHEDULER_DEBUG_EID, CFE_EVS_EventType_DEBUG, "ProcessTable::CurrentSlot=%d, First ProcessCount=%d", CurrentSlot, ProcessCount);
 
@@ -346,10 +607,15 @@ bool SCHEDULER_Execute(void)
       {
          
          Scheduler->SkippedSlotsCount++;
+         Scheduler->ShedFrameOverruns++;
+         Scheduler->FrameCatchUp = true;
 
-         CFE_EVS_SendEvent(SCHEDULER_SKIPPED_SLOTS_EID, CFE_EVS_EventType_ERROR,
-                           "Slots skipped: slot = %d, count = %d",
-                           Scheduler->NextSlotNumber, (ProcessCount - 1));
+         if (LimitEvent(SCHEDULER_EVS_LIMIT_SKIPPED_SLOTS, Scheduler->NextSlotNumber, (ProcessCount - 1)))
+         {
+            CFE_EVS_SendEvent(SCHEDULER_SKIPPED_SLOTS_EID, CFE_EVS_EventType_ERROR,
+                              "Slots skipped: slot = %d, count = %d",
+                              Scheduler->NextSlotNumber, (ProcessCount - 1));
+         }
 
          /*
          ** Update the pass counter if we are skipping the rollover slot
@@ -357,7 +623,7 @@ bool SCHEDULER_Execute(void)
          if (CurrentSlot < Scheduler->NextSlotNumber)
          {
             
-            Scheduler->TablePassCount++;
+            StartTablePass();
          }
 
          /*
@@ -394,17 +660,33 @@ bool SCHEDULER_Execute(void)
          
          Scheduler->MultipleSlotsCount++;
 
-         /* Generate an event message if not syncing to MET or when there is more than two being processed */
+         /* 
+         ** Generate an event message if not syncing to MET or when there is more than two being processed.
+         ** Other multi-slot wakeups are routine catch-up from the timer's granularity so they aren't
+         ** counted as overruns by the load shedding controller or the health metrics.
+         */
          if ((ProcessCount > Scheduler->WorstCaseSlotsPerMinorFrame) || (Scheduler->SyncToMET == SCHEDULER_SYNCH_FALSE))
          {
-            CFE_EVS_SendEvent(SCHEDULER_MULTI_SLOTS_EID, CFE_EVS_EventType_INFORMATION,
-                             "Multiple slots processed: slot = %d, count = %d",
-                             Scheduler->NextSlotNumber, ProcessCount);
+            Scheduler->ShedFrameOverruns++;
+            Scheduler->FrameCatchUp = true;
+            
+            if (LimitEvent(SCHEDULER_EVS_LIMIT_MULTI_SLOTS, Scheduler->NextSlotNumber, ProcessCount))
+            {
+               CFE_EVS_SendEvent(SCHEDULER_MULTI_SLOTS_EID, CFE_EVS_EventType_INFORMATION,
+                                "Multiple slots processed: slot = %d, count = %d",
+                                Scheduler->NextSlotNumber, ProcessCount);
+            }
          }
 
       } /* End if ProcessCount > 1) */
 
       CFE_EVS_SendEvent(SCHEDULER_DEBUG_EID, CFE_EVS_EventType_DEBUG, "ProcessTable::Final ProcessCount=%d", ProcessCount);
+      SCHTRACE_Record(SCHTRACE_SRC_TASK, SCHTRACE_CATCH_UP, CurrentSlot, SlotsBehind, ProcessCount);
+      if (ProcessCount > Scheduler->WinPeakProcessCount)
+      {
+         Scheduler->WinPeakProcessCount = ProcessCount;
+      }
+      
       /* Process the slots (most often this will be just one) */
       while ((ProcessCount != 0) && (Result == CFE_SUCCESS))
       {
@@ -412,6 +694,9 @@ bool SCHEDULER_Execute(void)
          ProcessCount--;
       }
 
+      PublishStats();
+      SCHPROFILE_WakeupEnd();
+      
    } /* End Semaphore */
 
    return(Result == CFE_SUCCESS);
@@ -419,6 +704,78 @@ bool SCHEDULER_Execute(void)
 } /* End of SCHEDULER_Execute() */
 
 
+/******************************************************************************
+** Function: SCHEDULER_GetStats
+**
+*/
+void SCHEDULER_GetStats(SCHEDULER_Stats_t* Stats)
+{
+
+   CFE_PSP_MemCpy(Stats, &Scheduler->Stats, sizeof(SCHEDULER_Stats_t));
+
+} /* End SCHEDULER_GetStats() */
+
+
+/******************************************************************************
+** Function: SCHEDULER_InjectFaultCmd
+**
+*/
+bool SCHEDULER_InjectFaultCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const SCHEDULER_InjectFaultCmdMsg_t *InjectFaultCmd = (const SCHEDULER_InjectFaultCmdMsg_t *) MsgPtr;
+   bool  RetStatus = false;
+
+   if (!SCHEDULER_TIMING_FAULTS)
+   {
+      
+      CFE_EVS_SendEvent(SCHEDULER_INJECT_FAULT_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Inject timing fault command rejected. Fault injection is disabled in this build");
+   }
+   else if (InjectFaultCmd->Fault > SCHEDULER_FAULT_MAX)
+   {
+      
+      CFE_EVS_SendEvent(SCHEDULER_INJECT_FAULT_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Inject timing fault command rejected. Invalid fault %d greater than max %d",
+                        InjectFaultCmd->Fault, SCHEDULER_FAULT_MAX);
+   }
+   else
+   {
+      
+      /* Stop the callbacks from using the previous fault before it's replaced */
+      Scheduler->InjectFault = SCHEDULER_FAULT_NONE;
+      KIT_SCH_MEM_BARRIER();
+      
+      Scheduler->InjectCnt = 0;
+      if ((InjectFaultCmd->Fault != SCHEDULER_FAULT_NONE) && (InjectFaultCmd->Count > 0))
+      {
+         
+         SCHEDULER_GetStats(&Scheduler->InjectStats);
+         Scheduler->InjectSettleFrames = SCHEDULER_FAULT_SETTLE_FRAMES;
+         Scheduler->InjectCnt = InjectFaultCmd->Count;
+         KIT_SCH_MEM_BARRIER();
+         Scheduler->InjectFault = InjectFaultCmd->Fault;
+         
+         CFE_EVS_SendEvent(SCHEDULER_INJECT_FAULT_EID, CFE_EVS_EventType_INFORMATION,
+                           "Injecting %d timing faults of type %d",
+                           InjectFaultCmd->Count, InjectFaultCmd->Fault);
+      }
+      else
+      {
+         
+         CFE_EVS_SendEvent(SCHEDULER_INJECT_FAULT_EID, CFE_EVS_EventType_INFORMATION,
+                           "Timing fault injection cancelled");
+      }
+      
+      RetStatus = true;
+   
+   }
+
+   return RetStatus;
+
+} /* End SCHEDULER_InjectFaultCmd() */
+
+
 /******************************************************************************
 ** Function: SCHEDULER_LoadMsgEntryCmd
 **
@@ -432,21 +789,24 @@ bool SCHEDULER_LoadMsgEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
    const   SCHEDULER_LoadMsgEntryCmdMsg_t *LoadMsgEntryCmd = (const SCHEDULER_LoadMsgEntryCmdMsg_t *) MsgPtr;   
    bool    RetStatus = false;
    uint16  Index;
+   uint16  MsgWords[MSGTBL_HDR_WORDS];
 
    Index = LoadMsgEntryCmd->Index;
    if (Index < MSGTBL_MAX_ENTRIES)
    {
 
-      CFE_MSG_Init(CFE_MSG_PTR(Scheduler->MsgTbl.Data.Entry[Index]), CFE_SB_ValueToMsgId(LoadMsgEntryCmd->MsgId), sizeof(CFE_MSG_CommandHeader_t));
-
-      CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, "Loaded msg[%d]: 0x%X, 0x%X, 0x%X, 0x%X",
-                        Index, 
-                        Scheduler->MsgTbl.Data.Entry[Index].Buffer[0],
-                        Scheduler->MsgTbl.Data.Entry[Index].Buffer[1],
-                        Scheduler->MsgTbl.Data.Entry[Index].Buffer[2],
-                        Scheduler->MsgTbl.Data.Entry[Index].Buffer[3]);
+      /* Command header without data words */
+      MsgWords[0] = LoadMsgEntryCmd->MsgId;
+      MsgWords[1] = 0xC000;                                 /* Complete packet */
+      MsgWords[2] = sizeof(CFE_MSG_CommandHeader_t) - 7;    /* Total length - 7 */
       
-      RetStatus = true;
+      RetStatus = MSGTBL_PatchEntry(Index, MsgWords, MSGTBL_HDR_WORDS);
+
+      if (RetStatus)
+      {
+         CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, "Loaded msg[%d]: 0x%X, 0x%X, 0x%X",
+                           Index, MsgWords[0], MsgWords[1], MsgWords[2]);
+      }
       
    } /* End if valid message ID */
    else
@@ -491,6 +851,7 @@ bool SCHEDULER_LoadSchEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
          Entry->Period         = LoadSchEntryCmd->Period;
          Entry->Offset         = LoadSchEntryCmd->Offset;
          Entry->MsgTblIndex    = LoadSchEntryCmd->MsgTblIndex;
+         SCHTBL_EntryChanged(Index);
          RetStatus = true;
          
          CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
@@ -514,22 +875,49 @@ bool SCHEDULER_LoadSchEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
 void SCHEDULER_ResetStatus()
 {
 
+   SCHEDULER_Stats_t FrameCounters;
+   
    Scheduler->SlotsProcessedCount          = 0;
    Scheduler->SkippedSlotsCount            = 0;
    Scheduler->MultipleSlotsCount           = 0;
    Scheduler->SameSlotCount                = 0;
    Scheduler->ScheduleActivitySuccessCount = 0;
    Scheduler->ScheduleActivityFailureCount = 0;
-   Scheduler->ValidMajorFrameCount         = 0;
-   Scheduler->MissedMajorFrameCount        = 0;
-   Scheduler->UnexpectedMajorFrameCount    = 0;
    Scheduler->TablePassCount               = 0;
-   Scheduler->ConsecutiveNoisyFrameCounter = 0;
-   Scheduler->IgnoreMajorFrame             = false;
+   Scheduler->TriggerDispatchCount         = 0;
+   Scheduler->TriggerCoalescedCount        = 0;
+   Scheduler->ShedActivityCount            = 0;
+   Scheduler->EventsSuppressedCount        = 0;
+   
+   /*
+   ** The frame callbacks own their counters so the counts at the reset are
+   ** subtracted when they're published and the major frame callback clears
+   ** its noise state at the next tone
+   */
+   CopyFrameCounters(&FrameCounters);
+   Scheduler->ResetValidMajorFrameCount      = FrameCounters.ValidMajorFrameCount;
+   Scheduler->ResetMissedMajorFrameCount     = FrameCounters.MissedMajorFrameCount;
+   Scheduler->ResetUnexpectedMajorFrameCount = FrameCounters.UnexpectedMajorFrameCount;
+   Scheduler->ToneResetPending = true;
+   
+   /* An injection outcome is reported relative to the reset */
+   CFE_PSP_MemSet(&Scheduler->InjectStats, 0, sizeof(SCHEDULER_Stats_t));
+   
+   ClearLatency();
+   
+   CFE_PSP_MemSet(Scheduler->RateSlotMsgs, 0, sizeof(Scheduler->RateSlotMsgs));
+   CFE_PSP_MemSet(Scheduler->RateSlotFailures, 0, sizeof(Scheduler->RateSlotFailures));
+   CFE_PSP_MemSet(Scheduler->RateSlotBytes, 0, sizeof(Scheduler->RateSlotBytes));
+   CFE_PSP_MemSet(&Scheduler->RatePkt.FrameCnt, 0, SCHEDULER_RATE_TLM_LEN - sizeof(CFE_MSG_TelemetryHeader_t));
+   
+   CFE_PSP_MemSet(&Scheduler->Health, 0, sizeof(SCHEDULER_Health_t));
+   StartHealthWindow();
    
    MSGTBL_ResetStatus();
    SCHTBL_ResetStatus();
    
+   PublishStats();
+   
 } /* End SCHEDULER_ResetStatus() */
 
 
@@ -560,10 +948,20 @@ bool SCHEDULER_SendDiagTlmCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
       DiagPkt->TimeSemaphore    = Scheduler->TimeSemaphore;
       DiagPkt->ClockAccuracy    = Scheduler->ClockAccuracy;
       DiagPkt->WorstCaseSlotsPerMinorFrame  = Scheduler->WorstCaseSlotsPerMinorFrame;
-      DiagPkt->IgnoreMajorFrame = Scheduler->IgnoreMajorFrame;
+      DiagPkt->IgnoreMajorFrame = Scheduler->Stats.IgnoreMajorFrame;
       DiagPkt->SyncToMET        = Scheduler->SyncToMET;
       DiagPkt->MajorFrameSource = Scheduler->MajorFrameSource;
       DiagPkt->Spare            = 0;
+      DiagPkt->TriggerDispatchCount  = Scheduler->TriggerDispatchCount;
+      DiagPkt->TriggerCoalescedCount = Scheduler->TriggerCoalescedCount;
+      DiagPkt->TriggersPending       = Scheduler->TriggersPending;
+      DiagPkt->DisabledGroups        = Scheduler->DisabledGroups;
+      DiagPkt->PendingDisabledGroups = Scheduler->PendingDisabledGroups;
+      DiagPkt->ShedActivityCount     = Scheduler->ShedActivityCount;
+      DiagPkt->ShedLevel             = Scheduler->ShedLevel;
+      DiagPkt->ShedClearFrames       = Scheduler->ShedClearFrames;
+      DiagPkt->ShedSpare             = 0;
+      DiagPkt->EventsSuppressedCount = Scheduler->EventsSuppressedCount;
 
       for (Activity=0; Activity < SCHTBL_ACTIVITIES_PER_SLOT; Activity++)
       {
@@ -609,14 +1007,24 @@ bool SCHEDULER_SendMsgEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
 
    const   SCHEDULER_SendMsgEntryCmdMsg_t *SendMsgEntryCmd = (const SCHEDULER_SendMsgEntryCmdMsg_t *) MsgPtr;   
    bool    RetStatus = false;
+   bool    ValidType = false;
    uint16  MsgIndex;
-   uint16 *DataBuf=NULL;
+   uint16  DataBuf[4] = {0};
+   uint16  WordCnt, i;
    uint16  SchIndex;
-   bool    SchEntryFound;
+   const uint16* Words;
    
    MsgIndex = SendMsgEntryCmd->Index;
-   MsgPtr = (CFE_MSG_Message_t *) Scheduler->MsgTbl.Data.Entry[MsgIndex].Buffer;
-   if (MsgIndex < MSGTBL_MAX_ENTRIES)
+   MsgPtr = MSGTBL_GetCmdMsg(MsgIndex);
+   if (MsgIndex < MSGTBL_MAX_ENTRIES && MsgPtr == NULL)
+   {
+      
+      CFE_EVS_SendEvent (SCHEDULER_SEND_MSG_TYPE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Rejected send message table entry command: Entry %d is undefined",
+                         MsgIndex);
+   
+   }
+   else if (MsgIndex < MSGTBL_MAX_ENTRIES)
    {
       CFE_MSG_Size_t          Size;
       CFE_MSG_Type_t          Type;
@@ -640,7 +1048,7 @@ bool SCHEDULER_SendMsgEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
                            "Msg[%d]=Command(ApId,SeqCnt,Len,FuncCode,ValidChecksum)=>(0x%04X,%d,%ld,%d,0x%02X)",
                            MsgIndex,ApId,SeqCnt,Size,FuncCode,ValidChecksum);
             
-         DataBuf = &(Scheduler->MsgTbl.Data.Entry[MsgIndex].Buffer[sizeof(CFE_MSG_CommandHeader_t)/2]);
+         ValidType = true;
 
       } /* End if cmd */
       else if (Type == CFE_MSG_Type_Tlm)
@@ -654,7 +1062,7 @@ bool SCHEDULER_SendMsgEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
                            "Msg[%d]=Telemetry(ApId,SeqCnt,Len,Seconds,Subsecs)=>(0x%04X,%d,%ld,%d,%d)",
                            MsgIndex,ApId,SeqCnt,Size,Time.Seconds,Time.Subseconds);
            
-         DataBuf = &(Scheduler->MsgTbl.Data.Entry[MsgIndex].Buffer[sizeof(CFE_MSG_TelemetryHeader_t)/2]);
+         ValidType = true;
       
       }  /* End if tlm */
       else
@@ -666,32 +1074,23 @@ bool SCHEDULER_SendMsgEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
          
       } /* Invalid type */
 
-      if (DataBuf != NULL)
+      if (ValidType)
       {
          
+         WordCnt = MSGTBL_GetEntryWords(MsgIndex, &Words);
+         for (i=MSGTBL_HDR_WORDS; (i < WordCnt) && ((i-MSGTBL_HDR_WORDS) < 4); i++)
+         {
+            DataBuf[i-MSGTBL_HDR_WORDS] = Words[i];
+         }
+         
          CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
                            "Data[0..3]: 0x%04X, 0x%04X, 0x%04X, 0x%04X",
                            DataBuf[0],DataBuf[1],DataBuf[2],DataBuf[3]);
          
-         SchEntryFound = false;
-         SchIndex = 0;
-         do
-         {
-            
-            if (Scheduler->SchTbl.Data.Entry[SchIndex].MsgTblIndex == MsgIndex)
-            {
-               SchEntryFound = true;
-            }
-            else
-            {
-               ++SchIndex;
-            }
-            
-         } while (!SchEntryFound && SchIndex < SCHTBL_MAX_ENTRIES);
-         
-         RetStatus = SendTblEntryTlm(SchIndex, MsgIndex, SchEntryFound);    
+         SchIndex  = SCHTBL_GetFirstMsgRef(MsgIndex);
+         RetStatus = SendTblEntryTlm(SchIndex, MsgIndex, (SchIndex != SCHTBL_MSG_REF_NONE));    
       
-      } /* End if DataBuf != NULL */
+      } /* End if ValidType */
    
    } /* End if valid activity ID */
    else
@@ -708,6 +1107,85 @@ bool SCHEDULER_SendMsgEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
 } /* End SCHEDULER_SendMsgEntryCmd() */
 
 
+/******************************************************************************
+** Function: SCHEDULER_SendMsgRefsCmd
+**
+** Send informational event messages listing the scheduler table entries and
+** triggers that reference the command-specified message table entry.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. The (slot,activity) pairs are listed in ascending order using
+**      SCHEDULER_MSG_REFS_PER_EVENT pairs per event.
+**
+*/
+bool SCHEDULER_SendMsgRefsCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const   SCHEDULER_SendMsgRefsCmdMsg_t *SendMsgRefsCmd = (const SCHEDULER_SendMsgRefsCmdMsg_t *) MsgPtr;   
+   uint16  MsgIndex = SendMsgRefsCmd->Index;
+   uint16  SchIndex;
+   uint16  EntryCnt = 0;
+   uint16  TriggerCnt = 0;
+   uint16  PairCnt = 0;
+   uint16  i;
+   size_t  StrLen = 0;
+   char    PairStr[SCHEDULER_MSG_REFS_PER_EVENT*12+1];
+   
+   
+   if (MsgIndex >= MSGTBL_MAX_ENTRIES)
+   {
+      
+      CFE_EVS_SendEvent (SCHEDULER_SEND_MSG_EVENT_CMD_INDEX_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Rejected send message references command: Invalid index %d greater than max %d",
+                         MsgIndex, (MSGTBL_MAX_ENTRIES-1));
+      return false;
+   
+   }
+   
+   for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+   {
+      if (Scheduler->SchTbl.Data.Trigger[i].Enabled && 
+          (Scheduler->SchTbl.Data.Trigger[i].MsgTblIndex == MsgIndex))
+      {
+         TriggerCnt++;
+      }
+   }
+   
+   for (SchIndex = SCHTBL_GetFirstMsgRef(MsgIndex); SchIndex != SCHTBL_MSG_REF_NONE; 
+        SchIndex = SCHTBL_GetNextMsgRef(SchIndex))
+   {
+      EntryCnt++;
+   }
+   
+   CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
+                     "Msg[%d] is referenced by %d scheduler table entries and %d enabled triggers",
+                     MsgIndex, EntryCnt, TriggerCnt);
+   
+   for (SchIndex = SCHTBL_GetFirstMsgRef(MsgIndex); SchIndex != SCHTBL_MSG_REF_NONE; 
+        SchIndex = SCHTBL_GetNextMsgRef(SchIndex))
+   {
+      
+      StrLen += snprintf(&PairStr[StrLen], sizeof(PairStr)-StrLen, "(%d,%d)%s",
+                         (SchIndex / SCHTBL_ACTIVITIES_PER_SLOT), (SchIndex % SCHTBL_ACTIVITIES_PER_SLOT),
+                         Scheduler->SchTbl.Data.Entry[SchIndex].Enabled ? "" : "d");
+      PairCnt++;
+      
+      if ((PairCnt == SCHEDULER_MSG_REFS_PER_EVENT) || (SCHTBL_GetNextMsgRef(SchIndex) == SCHTBL_MSG_REF_NONE))
+      {
+         CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
+                           "Msg[%d] (slot,activity): %s", MsgIndex, PairStr);
+         PairCnt = 0;
+         StrLen  = 0;
+      }
+   
+   } /* End reference loop */
+
+   return true;
+   
+} /* End SCHEDULER_SendMsgRefsCmd() */
+
+
 /******************************************************************************
 ** Function: SCHEDULER_SendSchEntryCmd
 **
@@ -751,20 +1229,65 @@ bool SCHEDULER_SendSchEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
 
 
 /******************************************************************************
-** Function: SCHEDULER_StartTimers
+** Function: SCHEDULER_SwitchModeCmd
 **
 */
-int32 SCHEDULER_StartTimers(void)
+bool SCHEDULER_SwitchModeCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
-   int32 Status = CFE_SUCCESS;
+   const SCHEDULER_SwitchModeCmdMsg_t *SwitchModeCmd = (const SCHEDULER_SwitchModeCmdMsg_t *) MsgPtr;
+   bool  RetStatus = false;
 
-   /*
-   ** Connect to cFE TIME's time reference marker (typically 1 Hz)
-   ** to use it as the Major Frame synchronization source
-   */
+   if (SwitchModeCmd->Mode < SCHTBL_MODES)
+   {
+      
+      if (SCHTBL_ModeLoaded(SwitchModeCmd->Mode))
+      {
+         
+         Scheduler->PendingMode = SwitchModeCmd->Mode;
+         
+         CFE_EVS_SendEvent(SCHEDULER_CMD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
+                           "Schedule mode %d will be activated at the next major frame",
+                           SwitchModeCmd->Mode);
+         RetStatus = true;
+      
+      }
+      else
+      {
+         
+         CFE_EVS_SendEvent(SCHEDULER_SWITCH_MODE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Switch mode command rejected. Schedule mode %d has not been loaded",
+                           SwitchModeCmd->Mode);
+      }
+   } /* End if valid mode */   
+   else
+   {
+   
+      CFE_EVS_SendEvent(SCHEDULER_SWITCH_MODE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Switch mode command rejected. Invalid mode %d greater than max %d",
+                        SwitchModeCmd->Mode, (SCHTBL_MODES-1));
+   }
 
-   Status = CFE_TIME_RegisterSynchCallback((CFE_TIME_SynchCallbackPtr_t)&MajorFrameCallback);
+   return RetStatus;
+
+} /* End SCHEDULER_SwitchModeCmd() */
+
+
+/******************************************************************************
+** Function: SCHEDULER_StartTimers
+**
+*/
+int32 SCHEDULER_StartTimers(void)
+{
+
+   int32 Status = CFE_SUCCESS;
+
+   /*
+   ** Connect to cFE TIME's time reference marker (typically 1 Hz)
+   ** to use it as the Major Frame synchronization source
+   */
+
+   Status = CFE_TIME_RegisterSynchCallback((CFE_TIME_SynchCallbackPtr_t)&MajorFrameCallback);
 
    if (Status != CFE_SUCCESS)
    {
@@ -897,17 +1420,41 @@ static void MajorFrameCallback(void)
    */
     
    uint16 StateFlags;
+   uint16 ToneSlot  = Scheduler->MinorFramesSinceTone;
+   uint32 ToneFlags = SCHTRACE_TONE_FLYWHEEL;
 
    CFE_EVS_SendEvent(SCHEDULER_DEBUG_EID, CFE_EVS_EventType_DEBUG, "MajorFrameCallback()\n");
     
+   if (ConsumeFault(SCHEDULER_FAULT_MISS_TONE))
+   {
+      return;
+   }
+   
+   /* Counter updates are bracketed by sequence increments, see SCHEDULER_Class_t */
+   Scheduler->ToneSequence++;
+   KIT_SCH_MEM_BARRIER();
+   
+   if (Scheduler->ToneResetPending)
+   {
+      Scheduler->ConsecutiveNoisyFrameCounter = 0;
+      Scheduler->IgnoreMajorFrame = false;
+      Scheduler->ToneResetPending = false;
+   }
+   
    /*
    ** If cFE TIME is in FLYWHEEL mode, then ignore all synchronization signals
    */
    StateFlags = CFE_TIME_GetClockInfo();
+   if (ConsumeFault(SCHEDULER_FAULT_FLYWHEEL))
+   {
+      StateFlags |= CFE_TIME_FLAG_FLYING;
+   }
 
    if ((StateFlags & CFE_TIME_FLAG_FLYING) == 0)
    {
        
+      ToneFlags = 0;
+      
       /*
       ** Determine whether the major frame is noisy or not
       **
@@ -934,6 +1481,7 @@ static void MajorFrameCallback(void)
          */
          Scheduler->UnexpectedMajorFrame = true;
          Scheduler->UnexpectedMajorFrameCount++;
+         ToneFlags |= SCHTRACE_TONE_UNEXPECTED;
 
          /*
          ** If the Major Frame is not being ignored yet, then increment the consecutive noisy
@@ -986,6 +1534,10 @@ static void MajorFrameCallback(void)
          ** Set current slot = zero to synchronize activities
          */
          Scheduler->MinorFramesSinceTone = 0;
+         if (Scheduler->LatencyEnabled)
+         {
+            Scheduler->SlotStartUs[0] = MetUs(CFE_TIME_GetMET());
+         }
 
          /*
          ** Major Frame Source is now from CFE TIME
@@ -1002,15 +1554,24 @@ static void MajorFrameCallback(void)
          OS_BinSemGive(Scheduler->TimeSemaphore);
 
       } /* End if IgnoreMajorFrame == FLASE */
+      else
+      {
+         ToneFlags |= SCHTRACE_TONE_IGNORED;
+      }
 
    } /* End if clock not fly wheeling */
 
+   SCHTRACE_Record(SCHTRACE_SRC_TONE, SCHTRACE_TONE, ToneSlot, ToneFlags, 0);
+
    /*
    ** We should assume that the next Major Frame will be in the same
    ** MET slot as this
    */
    Scheduler->LastSyncMETSlot = GetMETSlotNumber();
 
+   KIT_SCH_MEM_BARRIER();
+   Scheduler->ToneSequence++;
+
    return;
 
 } /* End MajorFrameCallback() */
@@ -1033,7 +1594,24 @@ static void MinorFrameCallback(uint32 TimerId)
    ** easiest solution is to uncomment the event if needed.
    ** CFE_EVS_SendEvent(SCHEDULER_DEBUG_EID, CFE_EVS_EventType_DEBUG, "MinorFrameCallback()\n");
    */
+   
+   SCHTRACE_Record(SCHTRACE_SRC_TIMER, SCHTRACE_MINOR_TICK, Scheduler->MinorFramesSinceTone, Scheduler->SyncToMET, 0);
     
+   if (ConsumeFault(SCHEDULER_FAULT_SKIP_TICK))
+   {
+      return;
+   }
+   
+   /*
+   ** The interval since the previous tick is nominal unless the previous
+   ** tick started the long sync slot or short slot timer, a tone reset the
+   ** timer or MET synchronization is in progress
+   */
+   SCHPROFILE_MinorTick(((Scheduler->MinorFramesSinceTone > 0) &&
+                         (Scheduler->MinorFramesSinceTone < SCHEDULER_TIME_SYNC_SLOT) &&
+                         ((Scheduler->SyncToMET & SCHEDULER_SYNCH_MAJOR_PENDING) == 0)) ?
+                        SCHEDULER_NORMAL_SLOT_PERIOD : 0);
+   
    /*
    ** If this is the very first timer interrupt, then the initial
    ** Major Frame Synchronization timed out.  This can occur when
@@ -1047,8 +1625,12 @@ static void MinorFrameCallback(uint32 TimerId)
 
       /* Synchronize timing to MET */
       Scheduler->SyncToMET |= SCHEDULER_SYNCH_MAJOR_PENDING;
+      Scheduler->TimerSequence++;
+      KIT_SCH_MEM_BARRIER();
       Scheduler->SyncAttemptsLeft = SCHEDULER_MAX_SYNC_ATTEMPTS;
       Scheduler->LastSyncMETSlot = 0;
+      KIT_SCH_MEM_BARRIER();
+      Scheduler->TimerSequence++;
    }
 
    /* 
@@ -1063,7 +1645,11 @@ static void MinorFrameCallback(uint32 TimerId)
       OS_TimerSet(Scheduler->TimerId, SCHEDULER_NORMAL_SLOT_PERIOD, SCHEDULER_NORMAL_SLOT_PERIOD);
 
       /* Determine if this was the last attempt */
+      Scheduler->TimerSequence++;
+      KIT_SCH_MEM_BARRIER();
       Scheduler->SyncAttemptsLeft--;
+      KIT_SCH_MEM_BARRIER();
+      Scheduler->TimerSequence++;
 
       CurrentSlot = GetMETSlotNumber();
       if ((CurrentSlot != 0) && (Scheduler->SyncAttemptsLeft > 0))
@@ -1087,7 +1673,11 @@ static void MinorFrameCallback(uint32 TimerId)
          ** is the best estimate we can use 
          */
          Scheduler->MinorFramesSinceTone = CurrentSlot;
+         Scheduler->TimerSequence++;
+         KIT_SCH_MEM_BARRIER();
          Scheduler->LastSyncMETSlot = 0;
+         KIT_SCH_MEM_BARRIER();
+         Scheduler->TimerSequence++;
       }
    } /* End if subsec synch */
    else
@@ -1097,6 +1687,10 @@ static void MinorFrameCallback(uint32 TimerId)
       ** If we are already synchronized with MET or don't care to be, increment current slot
       */
       Scheduler->MinorFramesSinceTone++;
+      if (ConsumeFault(SCHEDULER_FAULT_EXTRA_TICK))
+      {
+         Scheduler->MinorFramesSinceTone++;
+      }
    }
 
    if (Scheduler->MinorFramesSinceTone >= SCHTBL_SLOTS)
@@ -1115,7 +1709,11 @@ static void MinorFrameCallback(uint32 TimerId)
 
       Scheduler->MinorFramesSinceTone = 0;
 
+      Scheduler->TimerSequence++;
+      KIT_SCH_MEM_BARRIER();
       Scheduler->MissedMajorFrameCount++;
+      KIT_SCH_MEM_BARRIER();
+      Scheduler->TimerSequence++;
    }
 
    /*
@@ -1137,10 +1735,18 @@ static void MinorFrameCallback(uint32 TimerId)
    ** with software response times to timer interrupts.
    */
 
+   if (Scheduler->LatencyEnabled)
+   {
+      Scheduler->SlotStartUs[Scheduler->MinorFramesSinceTone] = MetUs(CFE_TIME_GetMET());
+   }
+
    /*
    ** Give "wakeup SCH" semaphore
    */
-   OS_BinSemGive(Scheduler->TimeSemaphore);
+   if (!ConsumeFault(SCHEDULER_FAULT_LATE_WAKEUP))
+   {
+      OS_BinSemGive(Scheduler->TimeSemaphore);
+   }
 
    return;
 
@@ -1159,10 +1765,33 @@ static int32 ProcessNextSlot(void)
    int32  SlotIndex;
    uint32 Remainder;
    SCHTBL_Entry_t *NextEntry;
-   uint16 *MsgBufPtr;
    int32  MsgSendStatus;
-   MSGTBL_CmdMsg_t *CmdMsg;
-
+   uint16 Trigger;
+   uint16 SendCnt = 0;
+   uint16 FailCnt = 0;
+   uint16 TriggerFailCnt = 0;
+   uint16 Slot = Scheduler->NextSlotNumber;
+   uint32 SlotUs;
+   OS_time_t StartTime;
+
+   CFE_ES_PerfLogEntry(Scheduler->PerfId + KIT_SCH_PERF_SLOT);
+   CFE_PSP_GetTime(&StartTime);
+   SCHPROFILE_SlotStart();
+   SCHTRACE_Record(SCHTRACE_SRC_TASK, SCHTRACE_SLOT_START, Scheduler->NextSlotNumber, Scheduler->TablePassCount, 0);
+
+   /* Event-triggered activities deferred to this slot are sent first */
+   if (Scheduler->TriggersPending != 0)
+   {
+      for (Trigger = 0; Trigger < SCHTBL_MAX_TRIGGERS; Trigger++)
+      {
+         if (Scheduler->TriggersPending & (1u << Trigger))
+         {
+            DispatchTrigger(Trigger, Slot, Scheduler->SlotStartUs[Slot], &TriggerFailCnt);
+         }
+      }
+      Scheduler->TriggersPending = 0;
+   }
+   
    SlotIndex = Scheduler->NextSlotNumber * SCHTBL_ACTIVITIES_PER_SLOT;
    NextEntry = &Scheduler->SchTbl.Data.Entry[SlotIndex];
 
@@ -1170,36 +1799,51 @@ static int32 ProcessNextSlot(void)
    for (EntryNumber = 0; EntryNumber < SCHTBL_ACTIVITIES_PER_SLOT; EntryNumber++)
    {
       
-      if (NextEntry->Enabled == true)
+      if ((NextEntry->Enabled == true) && ((NextEntry->Groups & Scheduler->DisabledGroups) == 0))
       {
 
          Remainder = Scheduler->TablePassCount % NextEntry->Period;
 
-         if (Remainder == NextEntry->Offset)
+         if ((Remainder == NextEntry->Offset) &&
+             (NextEntry->ShedPriority != 0) && (NextEntry->ShedPriority <= Scheduler->ShedLevel))
+         {
+            
+            Scheduler->ShedActivityCount++;
+         
+         }
+         else if (Remainder == NextEntry->Offset)
          {
 
             CFE_EVS_SendEvent(SCHEDULER_DEBUG_EID, CFE_EVS_EventType_DEBUG,"Scheduler ProcessNextSlot(): slot %d, entry %d, msgid %d", Scheduler->NextSlotNumber, EntryNumber, NextEntry->MsgTblIndex);
              
-            MsgSendStatus = CFE_SB_NO_MESSAGE;  /* use any non-success error code */
-            if (NextEntry->MsgTblIndex < MSGTBL_MAX_ENTRIES)
-            {
-            
-               MsgBufPtr = Scheduler->MsgTbl.Data.Entry[NextEntry->MsgTblIndex].Buffer;
-               
-               CFE_EVS_SendEvent(KIT_SCH_INIT_DEBUG_EID, KIT_SCH_INIT_EVS_TYPE,
-                                 "Scheduler MsgTbl Entry: Id = %d, Buffer[0] = 0x%04x(%d)",
-                                 NextEntry->MsgTblIndex, MsgBufPtr[0], MsgBufPtr[0]);
-            
-               CmdMsg = &Scheduler->MsgTbl.Cmd.Msg[NextEntry->MsgTblIndex];
-               MsgSendStatus = CFE_SB_TransmitMsg(CFE_MSG_PTR(CmdMsg->Header), true);
-
-            } /* End if valid EntryId */
+            MsgSendStatus = SendMsgTblEntry(NextEntry->MsgTblIndex, Slot, Scheduler->SlotStartUs[Slot]);
+            SendCnt++;
 
             if (MsgSendStatus == CFE_SUCCESS)
             {
                
                Scheduler->ScheduleActivitySuccessCount++;
             
+            }
+            else if (NextEntry->ShedPriority != 0)
+            {
+               
+               /* 
+               ** Sheddable entries stay enabled and the failure is handled by
+               ** the load shedding controller. The controller's summary event
+               ** reports the failures so this one is only a debug event.
+               */
+               Scheduler->ScheduleActivityFailureCount++;
+               Scheduler->ShedFrameFailures++;
+               FailCnt++;
+
+               if (LimitEvent(SCHEDULER_EVS_LIMIT_SEND_ERR, Slot, FailCnt))
+               {
+                  CFE_EVS_SendEvent(SCHEDULER_PACKET_SEND_ERR_EID, CFE_EVS_EventType_DEBUG,
+                                    "Sheddable activity error: slot = %d, entry = %d, err = 0x%08X",
+                                    Scheduler->NextSlotNumber, EntryNumber, MsgSendStatus);
+               }
+            
             }
             else 
             {
@@ -1207,10 +1851,15 @@ static int32 ProcessNextSlot(void)
                /* Disable entry with invalid message: Bad index or didn't send properly */
                NextEntry->Enabled = false;
                Scheduler->ScheduleActivityFailureCount++;
-
-               CFE_EVS_SendEvent(SCHEDULER_PACKET_SEND_ERR_EID, CFE_EVS_EventType_ERROR,
-                                 "Activity error: slot = %d, entry = %d, err = 0x%08X",
-                                 Scheduler->NextSlotNumber, EntryNumber, MsgSendStatus);
+               Scheduler->ShedFrameFailures++;
+               FailCnt++;
+
+               if (LimitEvent(SCHEDULER_EVS_LIMIT_SEND_ERR, Slot, FailCnt))
+               {
+                  CFE_EVS_SendEvent(SCHEDULER_PACKET_SEND_ERR_EID, CFE_EVS_EventType_ERROR,
+                                    "Activity error: slot = %d, entry = %d, err = 0x%08X",
+                                    Scheduler->NextSlotNumber, EntryNumber, MsgSendStatus);
+               }
             
             } /* End if msg send error */
          
@@ -1233,22 +1882,966 @@ static int32 ProcessNextSlot(void)
       /* TODO - Move to app level Result = SCH_ProcessCommands(); */
    }
 
+   SCHTRACE_Record(SCHTRACE_SRC_TASK, SCHTRACE_SLOT_END, Scheduler->NextSlotNumber, SendCnt, 0);
+
    Scheduler->NextSlotNumber++;
 
    if (Scheduler->NextSlotNumber == SCHTBL_SLOTS)
    {
        
       Scheduler->NextSlotNumber = 0;
-      Scheduler->TablePassCount++;
+      StartTablePass();
    }
 
    Scheduler->SlotsProcessedCount++;
 
+   SCHPROFILE_SlotEnd(Slot, SendCnt);
+   SlotUs = SCHPROFILE_ElapsedUs(StartTime);
+   if (SlotUs > Scheduler->WinPeakSlotUs)
+   {
+      Scheduler->WinPeakSlotUs = SlotUs;
+   }
+   CFE_ES_PerfLogExit(Scheduler->PerfId + KIT_SCH_PERF_SLOT);
+
    return(Result);
 
 } /* End ProcessNextSlot() */
 
 
+/******************************************************************************
+** Function: PublishStats
+**
+** Copy the live counters into the statistics snapshot.
+**
+** Notes:
+**   1. Must only be called from the scheduler task. The task's own counters
+**      are copied directly and the frame callback counters are copied with
+**      CopyFrameCounters() so they're consistent with each other.
+**   2. Frame counters are published relative to the last reset.
+**   3. If a consistent copy of the frame counters can't be made the
+**      previous snapshot's frame counters are kept. The callbacks are
+**      short so the next publish normally succeeds.
+*/
+static void PublishStats(void)
+{
+
+   SCHEDULER_Stats_t* Stats = &Scheduler->Stats;
+   SCHEDULER_Stats_t  FrameCounters;
+   
+   if (CopyFrameCounters(&FrameCounters))
+   {
+      Stats->ValidMajorFrameCount         = FrameCounters.ValidMajorFrameCount - Scheduler->ResetValidMajorFrameCount;
+      Stats->MissedMajorFrameCount        = FrameCounters.MissedMajorFrameCount - Scheduler->ResetMissedMajorFrameCount;
+      Stats->UnexpectedMajorFrameCount    = FrameCounters.UnexpectedMajorFrameCount - Scheduler->ResetUnexpectedMajorFrameCount;
+      Stats->ConsecutiveNoisyFrameCounter = FrameCounters.ConsecutiveNoisyFrameCounter;
+      Stats->SyncAttemptsLeft             = FrameCounters.SyncAttemptsLeft;
+      Stats->LastSyncMETSlot              = FrameCounters.LastSyncMETSlot;
+      Stats->IgnoreMajorFrame             = FrameCounters.IgnoreMajorFrame;
+      Stats->UnexpectedMajorFrame         = FrameCounters.UnexpectedMajorFrame;
+   }
+
+   Stats->SlotsProcessedCount          = Scheduler->SlotsProcessedCount;
+   Stats->ScheduleActivitySuccessCount = Scheduler->ScheduleActivitySuccessCount;
+   Stats->ScheduleActivityFailureCount = Scheduler->ScheduleActivityFailureCount;
+   Stats->TablePassCount               = Scheduler->TablePassCount;
+   Stats->SkippedSlotsCount            = Scheduler->SkippedSlotsCount;
+   Stats->MultipleSlotsCount           = Scheduler->MultipleSlotsCount;
+   Stats->SameSlotCount                = Scheduler->SameSlotCount;
+   Stats->Health                       = Scheduler->Health;
+
+} /* End PublishStats() */
+
+
+/******************************************************************************
+** Function: CopyFrameCounters
+**
+** Copy the counters owned by the frame callbacks into their Stats fields.
+**
+** Notes:
+**   1. A callback's sequence counter is odd while it is updating its
+**      counters. The copy is retried if either callback was updating or
+**      completed an update during the copy.
+**   2. Returns false if a consistent copy couldn't be made within
+**      SCHEDULER_STATS_READ_RETRIES attempts. Stats contains the last copy.
+**
+*/
+static bool CopyFrameCounters(SCHEDULER_Stats_t* Stats)
+{
+
+   bool   Consistent = false;
+   uint16 Attempt = 0;
+   uint32 ToneSequence;
+   uint32 TimerSequence;
+
+   do
+   {
+      
+      ToneSequence  = Scheduler->ToneSequence;
+      TimerSequence = Scheduler->TimerSequence;
+      KIT_SCH_MEM_BARRIER();
+      
+      Stats->ValidMajorFrameCount         = Scheduler->ValidMajorFrameCount;
+      Stats->MissedMajorFrameCount        = Scheduler->MissedMajorFrameCount;
+      Stats->UnexpectedMajorFrameCount    = Scheduler->UnexpectedMajorFrameCount;
+      Stats->ConsecutiveNoisyFrameCounter = Scheduler->ConsecutiveNoisyFrameCounter;
+      Stats->SyncAttemptsLeft             = Scheduler->SyncAttemptsLeft;
+      Stats->LastSyncMETSlot              = Scheduler->LastSyncMETSlot;
+      Stats->IgnoreMajorFrame             = Scheduler->IgnoreMajorFrame;
+      Stats->UnexpectedMajorFrame         = Scheduler->UnexpectedMajorFrame;
+      
+      KIT_SCH_MEM_BARRIER();
+      Consistent = (((ToneSequence & 1) == 0) && (ToneSequence == Scheduler->ToneSequence) &&
+                    ((TimerSequence & 1) == 0) && (TimerSequence == Scheduler->TimerSequence));
+      
+   } while (!Consistent && (++Attempt < SCHEDULER_STATS_READ_RETRIES));
+
+   return Consistent;
+
+} /* End CopyFrameCounters() */
+
+
+/******************************************************************************
+** Function: StartTablePass
+**
+** Called when slot processing rolls over to the start of the scheduler
+** table which is the major frame boundary. Configuration changes that must
+** apply to a complete table pass are made here.
+*/
+static void StartTablePass(void)
+{
+
+   Scheduler->TablePassCount++;
+
+   SendRateTlm();
+   if (Scheduler->LatencyEnabled)
+   {
+      SendLatencyTlm();
+   }
+   SCHPROFILE_FrameEnd();
+   UpdateHealth();
+   UpdateShedLevel();
+   SummarizeEvents();
+   
+   if ((Scheduler->InjectFault != SCHEDULER_FAULT_NONE) && (Scheduler->InjectCnt == 0))
+   {
+      if (Scheduler->InjectSettleFrames > 0)
+      {
+         Scheduler->InjectSettleFrames--;
+      }
+      else
+      {
+         ReportFaultInjection();
+      }
+   }
+   
+   if (Scheduler->PendingDisabledGroups != Scheduler->DisabledGroups)
+   {
+      
+      CFE_EVS_SendEvent(SCHEDULER_GROUP_APPLIED_EID, CFE_EVS_EventType_INFORMATION,
+                        "Disabled groups changed from 0x%08X to 0x%08X at table pass %d",
+                        Scheduler->DisabledGroups, Scheduler->PendingDisabledGroups,
+                        Scheduler->TablePassCount);
+      
+      Scheduler->DisabledGroups = Scheduler->PendingDisabledGroups;
+   }
+
+   /*
+   ** The table copy is done in the scheduler task between slots so the
+   ** new mode takes effect for the complete table pass. Trigger
+   ** subscriptions are updated when the next wakeup reads the triggers. 
+   */
+   if (Scheduler->PendingMode != Scheduler->SchTbl.ActiveMode)
+   {
+      
+      CFE_EVS_SendEvent(SCHEDULER_MODE_SWITCHED_EID, CFE_EVS_EventType_INFORMATION,
+                        "Schedule mode switched from %d to %d at table pass %d",
+                        Scheduler->SchTbl.ActiveMode, Scheduler->PendingMode,
+                        Scheduler->TablePassCount);
+      
+      SCHTBL_ActivateMode(Scheduler->PendingMode);
+   }
+
+} /* End StartTablePass() */
+
+
+/******************************************************************************
+** Function: SendRateTlm
+**
+** Fold the major frame's Software Bus utilization into the rate telemetry
+** packet, send it and start a new frame.
+**
+** Notes:
+**   1. Called at the major frame boundary from the scheduler task, which is
+**      the only writer of the rate counters.
+*/
+static void SendRateTlm(void)
+{
+
+   SCHEDULER_RatePkt_t*  RatePkt = &Scheduler->RatePkt;
+   SCHEDULER_SlotRate_t* SlotRate;
+   uint16 Slot;
+   
+   RatePkt->FrameCnt++;
+   RatePkt->FrameMsgCnt  = 0;
+   RatePkt->FrameFailCnt = 0;
+   RatePkt->FrameBytes   = 0;
+   
+   for (Slot=0; Slot < SCHTBL_SLOTS; Slot++)
+   {
+      
+      SlotRate = &RatePkt->Slot[Slot];
+      
+      SlotRate->MsgCnt  += Scheduler->RateSlotMsgs[Slot];
+      SlotRate->FailCnt += Scheduler->RateSlotFailures[Slot];
+      SlotRate->Bytes   += Scheduler->RateSlotBytes[Slot];
+      
+      if (Scheduler->RateSlotMsgs[Slot] > SlotRate->PeakMsgCnt)
+      {
+         SlotRate->PeakMsgCnt = Scheduler->RateSlotMsgs[Slot];
+      }
+      if (Scheduler->RateSlotBytes[Slot] > SlotRate->PeakBytes)
+      {
+         SlotRate->PeakBytes = Scheduler->RateSlotBytes[Slot];
+      }
+
+      RatePkt->FrameMsgCnt  += Scheduler->RateSlotMsgs[Slot];
+      RatePkt->FrameFailCnt += Scheduler->RateSlotFailures[Slot];
+      RatePkt->FrameBytes   += Scheduler->RateSlotBytes[Slot];
+      
+   } /* End slot loop */
+   
+   if (RatePkt->FrameMsgCnt > RatePkt->PeakFrameMsgCnt)
+   {
+      RatePkt->PeakFrameMsgCnt = RatePkt->FrameMsgCnt;
+   }
+   if (RatePkt->FrameBytes > RatePkt->PeakFrameBytes)
+   {
+      RatePkt->PeakFrameBytes = RatePkt->FrameBytes;
+   }
+   
+   CFE_PSP_MemSet(Scheduler->RateSlotMsgs, 0, sizeof(Scheduler->RateSlotMsgs));
+   CFE_PSP_MemSet(Scheduler->RateSlotFailures, 0, sizeof(Scheduler->RateSlotFailures));
+   CFE_PSP_MemSet(Scheduler->RateSlotBytes, 0, sizeof(Scheduler->RateSlotBytes));
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(RatePkt->TlmHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(RatePkt->TlmHeader), true);
+
+} /* End SendRateTlm() */
+
+
+/******************************************************************************
+** Function: ConsumeFault
+**
+** Return true if the frame signal should be affected by the fault being
+** injected.
+**
+** Notes:
+**   1. Each fault type is only consumed by one frame callback so the count
+**      has a single writer after the command sets it.
+**   2. Always false when SCHEDULER_TIMING_FAULTS is false so the compiler
+**      removes the checks from the frame callbacks.
+*/
+static bool ConsumeFault(uint8 Fault)
+{
+
+   bool Consumed = false;
+   
+   if (SCHEDULER_TIMING_FAULTS && (Scheduler->InjectFault == Fault) && (Scheduler->InjectCnt > 0))
+   {
+      Scheduler->InjectCnt--;
+      Consumed = true;
+   }
+
+   return Consumed;
+
+} /* End ConsumeFault() */
+
+
+/******************************************************************************
+** Function: ReportFaultInjection
+**
+** Report the change in the frame and slot counters since the fault
+** injection was commanded and end the injection.
+*/
+static void ReportFaultInjection(void)
+{
+
+   const SCHEDULER_Stats_t* Start = &Scheduler->InjectStats;
+   const SCHEDULER_Stats_t* Now   = &Scheduler->Stats;
+   
+   PublishStats();
+   
+   CFE_EVS_SendEvent(SCHEDULER_INJECT_FAULT_EID, CFE_EVS_EventType_INFORMATION,
+                     "Timing fault %d outcome: Major frames valid %d, missed %d, unexpected %d. Slot wakeups skipped %d, multiple %d, same %d. Major frame %s",
+                     Scheduler->InjectFault,
+                     (Now->ValidMajorFrameCount - Start->ValidMajorFrameCount),
+                     (Now->MissedMajorFrameCount - Start->MissedMajorFrameCount),
+                     (Now->UnexpectedMajorFrameCount - Start->UnexpectedMajorFrameCount),
+                     (uint16)(Now->SkippedSlotsCount - Start->SkippedSlotsCount),
+                     (uint16)(Now->MultipleSlotsCount - Start->MultipleSlotsCount),
+                     (uint16)(Now->SameSlotCount - Start->SameSlotCount),
+                     (Now->IgnoreMajorFrame ? "ignored" : "in use"));
+
+   Scheduler->InjectFault = SCHEDULER_FAULT_NONE;
+
+} /* End ReportFaultInjection() */
+
+
+/******************************************************************************
+** Function: ClearLatency
+**
+** Clear the wakeup lateness statistics and slot start times.
+*/
+static void ClearLatency(void)
+{
+
+   CFE_PSP_MemSet(&Scheduler->LatencyPkt.FrameCnt, 0, SCHEDULER_LATENCY_TLM_LEN - sizeof(CFE_MSG_TelemetryHeader_t));
+   CFE_PSP_MemSet((void*)Scheduler->SlotStartUs, 0, sizeof(Scheduler->SlotStartUs));
+   CFE_PSP_MemSet(Scheduler->LatencyTotalUs, 0, sizeof(Scheduler->LatencyTotalUs));
+
+} /* End ClearLatency() */
+
+
+/******************************************************************************
+** Function: MeasureLatency
+**
+** Accumulate the lateness of a message that is about to be sent. Return
+** true if stamping is enabled and LatencyStampPkt has been loaded for the
+** message.
+**
+** Notes:
+**   1. RefUs is the MET in microseconds the lateness is measured from, the
+**      slot's start for slot activities and the trigger's receive time for
+**      immediate triggers. It isn't used if it's 0, because the slot start
+**      hasn't been recorded since measurement was enabled, or if it's a
+**      major frame or more old because the tone or timer stopped.
+**   2. The reference MET is rebuilt from the send MET and the lateness
+**      because only the low 32 bits of its microseconds are recorded.
+*/
+static bool MeasureLatency(const CFE_MSG_Message_t *CmdMsg, uint16 MsgTblIndex, uint32 RefUs)
+{
+
+   SCHEDULER_LatencyPkt_t* LatencyPkt = &Scheduler->LatencyPkt;
+   SCHEDULER_MsgLatency_t* MsgLatency = &LatencyPkt->Msg[MsgTblIndex];
+   SCHEDULER_LatencyStampPkt_t* StampPkt = &Scheduler->LatencyStampPkt;
+   uint32  LatenessUs;
+   CFE_TIME_SysTime_t Sent;
+   CFE_TIME_SysTime_t Lateness;
+   CFE_SB_MsgId_t     MsgId;
+   
+   if (RefUs == 0)
+   {
+      return false;
+   }
+   
+   Sent = CFE_TIME_GetMET();
+   LatenessUs = MetUs(Sent) - RefUs;
+   if (LatenessUs >= SCHEDULER_MICROS_PER_MAJOR_FRAME)
+   {
+      return false;
+   }
+   
+   MsgLatency->SendCnt++;
+   Scheduler->LatencyTotalUs[MsgTblIndex] += LatenessUs;
+   if (LatenessUs > MsgLatency->MaxUs)
+   {
+      MsgLatency->MaxUs = LatenessUs;
+   }
+   
+   LatencyPkt->SendCnt++;
+   if (LatenessUs > LatencyPkt->MaxUs)
+   {
+      LatencyPkt->MaxUs = LatenessUs;
+      LatencyPkt->MaxMsgTblIndex = MsgTblIndex;
+   }
+
+   if (Scheduler->LatencyStamp)
+   {
+   
+      Lateness.Seconds    = LatenessUs / 1000000;
+      Lateness.Subseconds = CFE_TIME_Micro2SubSecs(LatenessUs % 1000000);
+      
+      CFE_MSG_GetMsgId(CmdMsg, &MsgId);
+      StampPkt->MsgTblIndex = MsgTblIndex;
+      StampPkt->MsgId       = (uint16)CFE_SB_MsgIdToValue(MsgId);
+      StampPkt->SlotStart   = CFE_TIME_Subtract(Sent, Lateness);
+      StampPkt->Sent        = Sent;
+      
+   } /* End if stamp */
+   
+   return Scheduler->LatencyStamp;
+
+} /* End MeasureLatency() */
+
+
+/******************************************************************************
+** Function: MetUs
+**
+** Return the low 32 bits of a MET in microseconds. Differences between two
+** values are valid for about 71 minutes.
+*/
+static uint32 MetUs(CFE_TIME_SysTime_t Met)
+{
+
+   return (Met.Seconds * 1000000) + CFE_TIME_Sub2MicroSecs(Met.Subseconds);
+
+} /* End MetUs() */
+
+
+/******************************************************************************
+** Function: SendLatencyTlm
+**
+** Compute the average lateness and send the lateness telemetry packet.
+*/
+static void SendLatencyTlm(void)
+{
+
+   SCHEDULER_LatencyPkt_t* LatencyPkt = &Scheduler->LatencyPkt;
+   uint64  TotalUs = 0;
+   uint16  i;
+   
+   LatencyPkt->FrameCnt++;
+   
+   for (i=0; i < MSGTBL_MAX_ENTRIES; i++)
+   {
+      if (LatencyPkt->Msg[i].SendCnt > 0)
+      {
+         LatencyPkt->Msg[i].AvgUs = (uint32)(Scheduler->LatencyTotalUs[i] / LatencyPkt->Msg[i].SendCnt);
+         TotalUs += Scheduler->LatencyTotalUs[i];
+      }
+   }
+   
+   if (LatencyPkt->SendCnt > 0)
+   {
+      LatencyPkt->AvgUs = (uint32)(TotalUs / LatencyPkt->SendCnt);
+   }
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(LatencyPkt->TlmHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(LatencyPkt->TlmHeader), true);
+
+} /* End SendLatencyTlm() */
+
+
+/******************************************************************************
+** Function: UpdateHealth
+**
+** Called at the end of each major frame to count the frame in the health
+** window and compute the health rates when the window completes.
+**
+** Notes:
+**   1. The rates use the nominal major frame period rather than the measured
+**      window duration so they're comparable across windows.
+**
+*/
+static void UpdateHealth(void)
+{
+
+   SCHEDULER_Health_t* Health = &Scheduler->Health;
+   uint64 WindowUs;
+   
+   Scheduler->WinFrames++;
+   if (Scheduler->FrameCatchUp)
+   {
+      Scheduler->WinCatchUpFrames++;
+      Scheduler->FrameCatchUp = false;
+   }
+   
+   if (Scheduler->WinFrames >= Scheduler->HealthWindow)
+   {
+      
+      WindowUs = (uint64)Scheduler->WinFrames * SCHEDULER_MICROS_PER_MAJOR_FRAME;
+      
+      Health->WindowFrames     = Scheduler->WinFrames;
+      Health->CatchUpFramePct  = (Scheduler->WinCatchUpFrames * 100) / Scheduler->WinFrames;
+      Health->SlotRate         = (uint32)(((uint64)(Scheduler->SlotsProcessedCount - Scheduler->WinStartSlots) * 100000000) / WindowUs);
+      Health->ActivityRate     = (uint32)(((uint64)(Scheduler->ScheduleActivitySuccessCount - Scheduler->WinStartSuccess) * 100000000) / WindowUs);
+      Health->FailureRate      = (uint32)(((uint64)(Scheduler->ScheduleActivityFailureCount - Scheduler->WinStartFailures) * 100000000) / WindowUs);
+      Health->PeakProcessCount = Scheduler->WinPeakProcessCount;
+      Health->PeakSlotUs       = Scheduler->WinPeakSlotUs;
+      
+      StartHealthWindow();
+   
+   }
+
+} /* End UpdateHealth() */
+
+
+/******************************************************************************
+** Function: StartHealthWindow
+**
+** Start a new health window from the current counters.
+*/
+static void StartHealthWindow(void)
+{
+
+   Scheduler->WinFrames           = 0;
+   Scheduler->WinCatchUpFrames    = 0;
+   Scheduler->WinPeakProcessCount = 0;
+   Scheduler->WinPeakSlotUs       = 0;
+   Scheduler->WinStartSlots       = Scheduler->SlotsProcessedCount;
+   Scheduler->WinStartSuccess     = Scheduler->ScheduleActivitySuccessCount;
+   Scheduler->WinStartFailures    = Scheduler->ScheduleActivityFailureCount;
+   Scheduler->FrameCatchUp        = false;
+
+} /* End StartHealthWindow() */
+
+
+/******************************************************************************
+** Function: UpdateShedLevel
+**
+** Load shedding controller that is run at the end of each major frame.
+**
+** Notes:
+**   1. Software Bus congestion shows up as send failures when destination
+**      pipes are full and as slot overruns when the scheduler's own sends
+**      take too long. Either raises the shed level by one per major frame
+**      so the lowest priority sheddable activities are dropped first.
+**   2. The level is lowered one step at a time after consecutive clear
+**      frames so activities are restored gradually.
+*/
+static void UpdateShedLevel(void)
+{
+
+   uint16 i;
+   uint16 ShedEntries = 0;
+   uint8  PrevShedLevel = Scheduler->ShedLevel;
+   bool   Congested = ((Scheduler->ShedFrameFailures >= SCHEDULER_SHED_FAILURE_THRESHOLD) ||
+                       (Scheduler->ShedFrameOverruns >= SCHEDULER_SHED_OVERRUN_THRESHOLD));
+
+   if (Congested)
+   {
+      
+      Scheduler->ShedClearFrames = 0;
+      if (Scheduler->ShedLevel < SCHTBL_SHED_PRIORITIES)
+      {
+         Scheduler->ShedLevel++;
+      }
+   }
+   else if (Scheduler->ShedLevel > 0)
+   {
+      
+      Scheduler->ShedClearFrames++;
+      if (Scheduler->ShedClearFrames >= SCHEDULER_SHED_CLEAR_FRAMES)
+      {
+         Scheduler->ShedLevel--;
+         Scheduler->ShedClearFrames = 0;
+      }
+   }
+
+   if (Scheduler->ShedLevel != PrevShedLevel)
+   {
+      
+      for (i=0; i < SCHTBL_MAX_ENTRIES; i++)
+      {
+         if ((Scheduler->SchTbl.Data.Entry[i].ShedPriority != 0) &&
+             (Scheduler->SchTbl.Data.Entry[i].ShedPriority <= Scheduler->ShedLevel))
+         {
+            ShedEntries++;
+         }
+      }
+      
+      CFE_EVS_SendEvent(SCHEDULER_LOAD_SHED_EID, 
+                        Congested ? CFE_EVS_EventType_ERROR : CFE_EVS_EventType_INFORMATION,
+                        "Load shedding level %s from %d to %d, %d entries shed. Last major frame had %d send failures and %d slot overruns",
+                        Congested ? "raised" : "lowered", PrevShedLevel, Scheduler->ShedLevel,
+                        ShedEntries, Scheduler->ShedFrameFailures, Scheduler->ShedFrameOverruns);
+   }
+
+   Scheduler->ShedFrameFailures = 0;
+   Scheduler->ShedFrameOverruns = 0;
+
+} /* End UpdateShedLevel() */
+
+
+/******************************************************************************
+** Function: LimitEvent
+**
+** Return true if a limited event should be sent. Otherwise the event is
+** counted in the limiter's summary.
+**
+** Notes:
+**   1. Slot and Value are the suppressed event's slot and the value that is
+**      reported as the worst in the summary.
+**
+*/
+static bool LimitEvent(uint8 Limit, uint16 Slot, uint32 Value)
+{
+
+   SCHEDULER_EvsLimit_t* EvsLimit = &Scheduler->EvsLimit[Limit];
+   bool SendEvent = false;
+   
+   if (EvsLimit->SentCnt < SCHEDULER_EVS_LIMIT_CNT)
+   {
+      EvsLimit->SentCnt++;
+      SendEvent = true;
+   }
+   else
+   {
+      
+      if (EvsLimit->SuppressedCnt == 0)
+      {
+         EvsLimit->FirstSlot  = Slot;
+         EvsLimit->WorstValue = Value;
+      }
+      else if (Value > EvsLimit->WorstValue)
+      {
+         EvsLimit->WorstValue = Value;
+      }
+      EvsLimit->LastSlot = Slot;
+      EvsLimit->SuppressedCnt++;
+      
+      Scheduler->EventsSuppressedCount++;
+   
+   }
+   
+   return SendEvent;
+
+} /* End LimitEvent() */
+
+
+/******************************************************************************
+** Function: SummarizeEvents
+**
+** Called at the end of each major frame. At the end of an event limiting
+** window send one summary event for each limited event that was suppressed
+** and start a new window.
+*/
+static void SummarizeEvents(void)
+{
+
+   SCHEDULER_EvsLimit_t* EvsLimit;
+   uint8 Limit;
+   
+   Scheduler->EvsLimitFrames++;
+   if (Scheduler->EvsLimitFrames >= SCHEDULER_EVS_LIMIT_FRAMES)
+   {
+      
+      for (Limit=0; Limit < SCHEDULER_EVS_LIMITS; Limit++)
+      {
+         
+         EvsLimit = &Scheduler->EvsLimit[Limit];
+         if (EvsLimit->SuppressedCnt > 0)
+         {
+            CFE_EVS_SendEvent(EvsLimitDef[Limit].Eid, EvsLimitDef[Limit].EventType,
+                              "%s events suppressed: count = %d, slots = %d to %d, worst = %d",
+                              EvsLimitDef[Limit].Name, EvsLimit->SuppressedCnt,
+                              EvsLimit->FirstSlot, EvsLimit->LastSlot, EvsLimit->WorstValue);
+         }
+         
+      } /* End limit loop */
+      
+      CFE_PSP_MemSet(Scheduler->EvsLimit, 0, sizeof(Scheduler->EvsLimit));
+      Scheduler->EvsLimitFrames = 0;
+   
+   }
+
+} /* End SummarizeEvents() */
+
+
+/******************************************************************************
+** Function: SendMsgTblEntry
+**
+** Send the message table entry's message on the software bus. A non-success
+** status is returned for an invalid index or an undefined entry. The send is
+** counted against Slot for the rate telemetry and its lateness is measured
+** from RefUs (see MeasureLatency()).
+*/
+static int32 SendMsgTblEntry(uint16 MsgTblIndex, uint16 Slot, uint32 RefUs)
+{
+
+   int32  MsgSendStatus = CFE_SB_NO_MESSAGE;  /* use any non-success error code */
+   bool   SendStamp = false;
+   CFE_MSG_Message_t *CmdMsg;
+   CFE_MSG_Size_t     MsgSize;
+   
+   CmdMsg = MSGTBL_GetCmdMsg(MsgTblIndex);
+   if (CmdMsg != NULL)
+   {
+   
+      if (Scheduler->LatencyEnabled)
+      {
+         SendStamp = MeasureLatency(CmdMsg, MsgTblIndex, RefUs);
+      }
+      
+      CFE_ES_PerfLogEntry(Scheduler->PerfId + KIT_SCH_PERF_SEND);
+      MsgSendStatus = CFE_SB_TransmitMsg(CmdMsg, true);
+      CFE_ES_PerfLogExit(Scheduler->PerfId + KIT_SCH_PERF_SEND);
+
+      if (SendStamp && (MsgSendStatus == CFE_SUCCESS))
+      {
+         CFE_SB_TimeStampMsg(CFE_MSG_PTR(Scheduler->LatencyStampPkt.TlmHeader));
+         CFE_SB_TransmitMsg(CFE_MSG_PTR(Scheduler->LatencyStampPkt.TlmHeader), true);
+      }
+
+   } /* End if defined entry */
+
+   if (MsgSendStatus == CFE_SUCCESS)
+   {
+      CFE_MSG_GetSize(CmdMsg, &MsgSize);
+      Scheduler->RateSlotMsgs[Slot]++;
+      Scheduler->RateSlotBytes[Slot] += MsgSize;
+   }
+   else
+   {
+      Scheduler->RateSlotFailures[Slot]++;
+   }
+
+   SCHTRACE_Record(SCHTRACE_SRC_TASK, SCHTRACE_SEND, Slot, MsgTblIndex, MsgSendStatus);
+
+   return MsgSendStatus;
+   
+} /* End SendMsgTblEntry() */
+
+
+/******************************************************************************
+** Function: SyncTriggerSubscriptions
+**
+** Subscribe to the trigger messages defined in the scheduler table.
+**
+** Notes:
+**   1. Called when the scheduler table has been loaded since the last
+**      synchronization. All previous subscriptions are removed and pending
+**      triggers are discarded because their definitions may have changed.
+**   2. Multiple triggers can use the same message ID. Only one subscription
+**      is made for each message ID.
+*/
+static void SyncTriggerSubscriptions(void)
+{
+
+   int32  Status;
+   uint16 i, j;
+   bool   Subscribed;
+   const SCHTBL_Trigger_t* Trigger;
+   
+   Scheduler->ImmediateTriggers = false;
+   
+   for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+   {
+      
+      if (CFE_SB_IsValidMsgId(Scheduler->TriggerMid[i]))
+      {
+         
+         Subscribed = false;
+         for (j=0; j < i; j++)
+         {
+            Subscribed |= CFE_SB_MsgId_Equal(Scheduler->TriggerMid[j], Scheduler->TriggerMid[i]);
+         }
+         if (!Subscribed)
+         {
+            CFE_SB_Unsubscribe(Scheduler->TriggerMid[i], Scheduler->TriggerPipe);
+         }
+      }
+   } /* End unsubscribe loop */
+   
+   for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+   {
+   
+      Trigger = &Scheduler->SchTbl.Data.Trigger[i];
+      Scheduler->TriggerMid[i] = CFE_SB_INVALID_MSG_ID;
+      
+      if (Trigger->Enabled)
+      {
+         
+         Subscribed = false;
+         for (j=0; j < i; j++)
+         {
+            Subscribed |= CFE_SB_MsgId_Equal(Scheduler->TriggerMid[j], CFE_SB_ValueToMsgId(Trigger->TopicId));
+         }
+         
+         Status = Subscribed ? CFE_SUCCESS : 
+                  CFE_SB_Subscribe(CFE_SB_ValueToMsgId(Trigger->TopicId), Scheduler->TriggerPipe);
+         
+         if (Status == CFE_SUCCESS)
+         {
+            Scheduler->TriggerMid[i] = CFE_SB_ValueToMsgId(Trigger->TopicId);
+            if (Trigger->Dispatch == SCHTBL_TRIGGER_IMMEDIATE)
+            {
+               Scheduler->ImmediateTriggers = true;
+            }
+         }
+         else
+         {
+            CFE_EVS_SendEvent(SCHEDULER_TRIGGER_SUB_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Error subscribing to trigger[%d] message 0x%04X (RC=0x%08X). Trigger disabled.",
+                              i, Trigger->TopicId, Status);
+         }
+      } /* End if enabled */
+   } /* End subscribe loop */
+
+   Scheduler->TriggersPending     = 0;
+   Scheduler->TriggerTblUpdateCnt = Scheduler->SchTbl.UpdateCnt;
+
+} /* End SyncTriggerSubscriptions() */
+
+
+/******************************************************************************
+** Function: WaitForSlot
+**
+** Wait for a frame callback to signal the next slot and return the
+** semaphore status.
+**
+** Notes:
+**   1. If any immediate triggers are enabled the wait is divided into
+**      SCHEDULER_TRIGGER_POLL_MS intervals and the trigger pipe is read
+**      after each one so immediate triggers don't wait for the next slot.
+**
+*/
+static int32 WaitForSlot(void)
+{
+
+   int32 Result;
+   
+   if (Scheduler->SchTbl.UpdateCnt != Scheduler->TriggerTblUpdateCnt)
+   {
+      SyncTriggerSubscriptions();
+   }
+
+   if (Scheduler->ImmediateTriggers)
+   {
+      
+      do
+      {
+         
+         Result = OS_BinSemTimedWait(Scheduler->TimeSemaphore, SCHEDULER_TRIGGER_POLL_MS);
+         
+         if (Result == OS_SEM_TIMEOUT)
+         {
+            ProcessTriggers();
+         }
+      
+      } while (Result == OS_SEM_TIMEOUT);
+   
+   }
+   else
+   {
+      
+      Result = OS_BinSemTake(Scheduler->TimeSemaphore);
+   
+   }
+   
+   return Result;
+
+} /* End WaitForSlot() */
+
+
+/******************************************************************************
+** Function: ProcessTriggers
+**
+** Read the trigger messages that arrived since the trigger pipe was last
+** read.
+**
+** Notes:
+**   1. Called after each wakeup and, if immediate triggers are enabled,
+**      while waiting for the next slot. Immediate triggers are dispatched
+**      here up to SCHEDULER_MAX_IMMEDIATE_TRIGGERS each call. All other
+**      triggers are marked pending and dispatched by ProcessNextSlot().
+**   2. A trigger that arrives while it is already pending is coalesced so
+**      at most one activity is performed per trigger per slot.
+**   3. The slot being processed hasn't started so immediate triggers are
+**      counted against the last slot processed and their lateness is
+**      measured from when they were received.
+*/
+static void ProcessTriggers(void)
+{
+
+   int32  SbStatus;
+   uint16 MsgCnt = 0;
+   uint16 ImmediateCnt = 0;
+   uint16 FailCnt = 0;
+   uint16 LastSlot = (Scheduler->NextSlotNumber + SCHTBL_SLOTS - 1) % SCHTBL_SLOTS;
+   uint32 ReceiveUs = 0;
+   uint16 i;
+   CFE_SB_Buffer_t* SbBufPtr;
+   CFE_SB_MsgId_t   MsgId;
+   
+   if (Scheduler->SchTbl.UpdateCnt != Scheduler->TriggerTblUpdateCnt)
+   {
+      SyncTriggerSubscriptions();
+   }
+
+   do
+   {
+   
+      SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Scheduler->TriggerPipe, CFE_SB_POLL);
+   
+      if (SbStatus == CFE_SUCCESS)
+      {
+         
+         CFE_MSG_GetMsgId(&SbBufPtr->Msg, &MsgId);
+         if (Scheduler->LatencyEnabled)
+         {
+            ReceiveUs = MetUs(CFE_TIME_GetMET());
+         }
+
+         for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+         {
+            
+            if (CFE_SB_IsValidMsgId(Scheduler->TriggerMid[i]) && 
+                CFE_SB_MsgId_Equal(Scheduler->TriggerMid[i], MsgId))
+            {
+               
+               if ((Scheduler->SchTbl.Data.Trigger[i].Dispatch == SCHTBL_TRIGGER_IMMEDIATE) &&
+                   (ImmediateCnt < SCHEDULER_MAX_IMMEDIATE_TRIGGERS) &&
+                   ((Scheduler->TriggersPending & (1u << i)) == 0))
+               {
+                  ImmediateCnt++;
+                  DispatchTrigger(i, LastSlot, ReceiveUs, &FailCnt);
+               }
+               else if (Scheduler->TriggersPending & (1u << i))
+               {
+                  Scheduler->TriggerCoalescedCount++;
+               }
+               else
+               {
+                  Scheduler->TriggersPending |= (1u << i);
+               }
+            } /* End if trigger matched */
+         } /* End trigger loop */
+      } /* End if received message */
+      
+   } while ((SbStatus == CFE_SUCCESS) && (++MsgCnt < SCHEDULER_TRIGGER_PIPE_DEPTH));
+
+} /* End ProcessTriggers() */
+
+
+/******************************************************************************
+** Function: DispatchTrigger
+**
+** Slot and RefUs are passed to SendMsgTblEntry(). FailCnt is the caller's
+** count of failed dispatches and is reported to the event limiter.
+*/
+static void DispatchTrigger(uint16 TriggerIndex, uint16 Slot, uint32 RefUs, uint16* FailCnt)
+{
+
+   int32 MsgSendStatus;
+   
+   MsgSendStatus = SendMsgTblEntry(Scheduler->SchTbl.Data.Trigger[TriggerIndex].MsgTblIndex, Slot, RefUs);
+
+   if (MsgSendStatus == CFE_SUCCESS)
+   {
+      
+      Scheduler->ScheduleActivitySuccessCount++;
+      Scheduler->TriggerDispatchCount++;
+   
+   }
+   else 
+   {
+      
+      Scheduler->ScheduleActivityFailureCount++;
+      (*FailCnt)++;
+
+      if (LimitEvent(SCHEDULER_EVS_LIMIT_TRIGGER_ERR, Slot, *FailCnt))
+      {
+         CFE_EVS_SendEvent(SCHEDULER_TRIGGER_SEND_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Triggered activity error: trigger = %d, msg index = %d, err = 0x%08X",
+                           TriggerIndex, Scheduler->SchTbl.Data.Trigger[TriggerIndex].MsgTblIndex, MsgSendStatus);
+      }
+   
+   } /* End if msg send error */
+
+} /* End DispatchTrigger() */
+
+
 /******************************************************************************
 ** Function: SendTblEntryTlm
 **
@@ -1257,11 +2850,10 @@ static int32 ProcessNextSlot(void)
 */
 static bool SendTblEntryTlm(uint16 SchTblIndex, uint16 MsgTblIndex, bool UseSchTblIndex)
 {
-   uint8 i;
-   int32 CfeStatus;
-   uint16 MsgDataIndex;
-   CFE_MSG_Type_t     MsgType;
-   CFE_MSG_Message_t* MsgPtr = (CFE_MSG_Message_t *) Scheduler->MsgTbl.Data.Entry[MsgTblIndex].Buffer;
+   uint16 i;
+   uint16 WordCnt;
+   int32  CfeStatus;
+   const uint16* Words;
    
    SCHEDULER_TblEntryPkt_t *TlmPkt = &(Scheduler->TblEntryPkt);
    
@@ -1275,6 +2867,9 @@ static bool SendTblEntryTlm(uint16 SchTblIndex, uint16 MsgTblIndex, bool UseSchT
       TlmPkt->SchTblEntry.Period      = SchEntry->Period;
       TlmPkt->SchTblEntry.Offset      = SchEntry->Offset;
       TlmPkt->SchTblEntry.MsgTblIndex = SchEntry->MsgTblIndex;
+      TlmPkt->SchTblEntry.Groups      = SchEntry->Groups;
+      TlmPkt->SchTblEntry.ShedPriority = SchEntry->ShedPriority;
+      TlmPkt->SchTblEntry.Movable      = SchEntry->Movable;
       
    }
    else
@@ -1286,30 +2881,25 @@ static bool SendTblEntryTlm(uint16 SchTblIndex, uint16 MsgTblIndex, bool UseSchT
       TlmPkt->SchTblEntry.Period      = SCHEDULER_UNDEF_SCHTBL_ENTRY_VAL;
       TlmPkt->SchTblEntry.Offset      = SCHEDULER_UNDEF_SCHTBL_ENTRY_VAL;
       TlmPkt->SchTblEntry.MsgTblIndex = SCHEDULER_UNDEF_SCHTBL_ENTRY_VAL;
+      TlmPkt->SchTblEntry.Groups      = 0;
+      TlmPkt->SchTblEntry.ShedPriority = 0;
+      TlmPkt->SchTblEntry.Movable      = false;
 
    }
    
-   if (MsgTblIndex == MSGTBL_MAX_ENTRIES)
-   {
-  
-      CFE_PSP_MemSet(&(TlmPkt->MsgTblEntry),0,sizeof(MSGTBL_Entry_t));       
-   }
-   else
+   CFE_PSP_MemSet(TlmPkt->MsgTblEntry,0,sizeof(TlmPkt->MsgTblEntry));       
+   TlmPkt->MsgTblWordCnt = 0;
+   
+   if (MsgTblIndex < MSGTBL_MAX_ENTRIES)
    {
 
-      /* In rare case it's a telemetry packet the time field will be zeroed out */
+      WordCnt = MSGTBL_GetEntryWords(MsgTblIndex, &Words);
       
-      for (i=0; i < PKTUTIL_TLM_HDR_WORDS; i++)
+      for (i=0; i < WordCnt; i++)
       {
-         TlmPkt->MsgTblEntry.Buffer[i] = CFE_MAKE_BIG16(Scheduler->MsgTbl.Data.Entry[MsgTblIndex].Buffer[i]);
+         TlmPkt->MsgTblEntry[i] = (i < MSGTBL_HDR_WORDS) ? CFE_MAKE_BIG16(Words[i]) : Words[i];
       }
-     
-      CFE_MSG_GetType(MsgPtr, &MsgType);
-      MsgDataIndex = (MsgType == CFE_MSG_Type_Cmd) ? sizeof(CFE_MSG_CommandHeader_t)/2 : sizeof(CFE_MSG_TelemetryHeader_t)/2;
-
-      CFE_PSP_MemCpy(&(TlmPkt->MsgTblEntry.Buffer[MsgDataIndex]),
-                     &(Scheduler->MsgTbl.Data.Entry[MsgTblIndex].Buffer[MsgDataIndex]),
-                    (MSGTBL_MAX_MSG_WORDS-MsgDataIndex)*2);
+      TlmPkt->MsgTblWordCnt = WordCnt;
 
    }
  
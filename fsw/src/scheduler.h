@@ -36,6 +36,10 @@
 #include "app_cfg.h"
 #include "msgtbl.h"
 #include "schtbl.h"
+#include "schanalyzer.h"
+#include "schbalancer.h"
+#include "schtrace.h"
+#include "schprofile.h"
 
 
 /***********************/
@@ -52,6 +56,13 @@
 #define SCHEDULER_SEM_OPTIONS  0
 
 
+/*
+** Event-triggered activity message pipe
+*/
+
+#define SCHEDULER_TRIGGER_PIPE_NAME  "KIT_SCH_TRIGGER"
+
+
 /*
 ** Synchronized to Mission Elapsed Time States
 */
@@ -110,6 +121,39 @@
 #define SCHEDULER_MAX_SYNC_ATTEMPTS   (SCHTBL_SLOTS * 3)
 
 
+/*
+** Number of times the scheduler task attempts to get a consistent copy of
+** the frame callback counters. A callback only holds its counters for a few
+** instructions so a retry is only needed if the task's copy overlaps a
+** callback running on another processor.
+*/
+
+#define SCHEDULER_STATS_READ_RETRIES  4
+
+
+/*
+** Timing faults. See SCHEDULER_InjectFaultCmd().
+*/
+
+#define SCHEDULER_FAULT_NONE         0   /* Cancel an injection in progress */
+#define SCHEDULER_FAULT_MISS_TONE    1   /* Major frame signal is lost */
+#define SCHEDULER_FAULT_FLYWHEEL     2   /* Major frame signal arrives while cFE TIME is flywheeling */
+#define SCHEDULER_FAULT_LATE_WAKEUP  3   /* Minor frame timer doesn't wake the scheduler task */
+#define SCHEDULER_FAULT_SKIP_TICK    4   /* Minor frame timer tick is lost (slow timer) */
+#define SCHEDULER_FAULT_EXTRA_TICK   5   /* Minor frame timer tick is counted twice (fast timer) */
+#define SCHEDULER_FAULT_MAX          5
+
+/*
+** Limited events. See SCHEDULER_EVS_LIMIT_CNT.
+*/
+
+#define SCHEDULER_EVS_LIMIT_SKIPPED_SLOTS  0   /* Worst value: Slots skipped */
+#define SCHEDULER_EVS_LIMIT_MULTI_SLOTS    1   /* Worst value: Slots processed */
+#define SCHEDULER_EVS_LIMIT_SEND_ERR       2   /* Worst value: Activity errors in a slot */
+#define SCHEDULER_EVS_LIMIT_TRIGGER_ERR    3   /* Worst value: Triggered activity errors in a slot or trigger poll */
+#define SCHEDULER_EVS_LIMITS               4
+
+
 /*
 ** Event Message IDs
 */
@@ -134,10 +178,32 @@
 #define SCHEDULER_SEND_DIAG_TLM_ERR_EID              (SCHEDULER_BASE_EID + 14)
 
 #define SCHEDULER_DEBUG_EID                          (SCHEDULER_BASE_EID + 15)
+#define SCHEDULER_TRIGGER_PIPE_ERR_EID               (SCHEDULER_BASE_EID + 16)
+#define SCHEDULER_TRIGGER_SUB_ERR_EID                (SCHEDULER_BASE_EID + 17)
+#define SCHEDULER_TRIGGER_SEND_ERR_EID               (SCHEDULER_BASE_EID + 18)
+#define SCHEDULER_CONFIG_GROUP_ERR_EID               (SCHEDULER_BASE_EID + 19)
+#define SCHEDULER_GROUP_APPLIED_EID                  (SCHEDULER_BASE_EID + 20)
+#define SCHEDULER_SWITCH_MODE_ERR_EID                (SCHEDULER_BASE_EID + 21)
+#define SCHEDULER_MODE_SWITCHED_EID                  (SCHEDULER_BASE_EID + 22)
+#define SCHEDULER_LOAD_SHED_EID                      (SCHEDULER_BASE_EID + 23)
+#define SCHEDULER_INJECT_FAULT_EID                   (SCHEDULER_BASE_EID + 24)
+#define SCHEDULER_INJECT_FAULT_ERR_EID               (SCHEDULER_BASE_EID + 25)
+#define SCHEDULER_CFG_LATENCY_EID                    (SCHEDULER_BASE_EID + 26)
+#define SCHEDULER_CFG_LATENCY_ERR_EID                (SCHEDULER_BASE_EID + 27)
+#define SCHEDULER_ACTIVATE_PATCH_ERR_EID             (SCHEDULER_BASE_EID + 28)
 
 #define SCHEDULER_UNDEF_SCHTBL_ENTRY_VAL 255
 #define SCHEDULER_UNDEF_MSGTBL_ENTRY_VAL   0
 
+#define SCHEDULER_MSG_REFS_PER_EVENT  8   /* (slot,activity) pairs per send message references event */
+
+/*
+** Activate patch command table identifiers
+*/
+
+#define SCHEDULER_PATCH_MSG_TBL  0
+#define SCHEDULER_PATCH_SCH_TBL  1
+
 
 /**********************/
 /** Type Definitions **/
@@ -158,6 +224,58 @@ typedef struct
 } SCHEDULER_ConfigSchEntryCmdMsg_t;
 #define SCHEDULER_CFG_SCH_ENTRY_CMD_DATA_LEN  (sizeof(SCHEDULER_ConfigSchEntryCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
 
+
+typedef struct
+{
+   
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   uint32  Groups;    /* Bit mask of the groups to be configured */
+   bool    Enabled;   /* 0=FALSE(Disabled), 1=TRUE(Enabled) */
+
+} SCHEDULER_ConfigGroupCmdMsg_t;
+#define SCHEDULER_CFG_GROUP_CMD_DATA_LEN  (sizeof(SCHEDULER_ConfigGroupCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+
+typedef struct
+{
+   
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   uint16  Mode;
+
+} SCHEDULER_SwitchModeCmdMsg_t;
+#define SCHEDULER_SWITCH_MODE_CMD_DATA_LEN  (sizeof(SCHEDULER_SwitchModeCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+typedef struct
+{
+   
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   uint8   Fault;     /* SCHEDULER_FAULT_* */
+   uint8   Spare;
+   uint16  Count;     /* Number of signals affected */
+
+} SCHEDULER_InjectFaultCmdMsg_t;
+#define SCHEDULER_INJECT_FAULT_CMD_DATA_LEN  (sizeof(SCHEDULER_InjectFaultCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+typedef struct
+{
+   
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   bool    Enabled;   /* 0=FALSE(Disabled), 1=TRUE(Enabled) */
+   bool    Stamp;     /* 0=FALSE(Measure only), 1=TRUE(Send latency stamps) */
+
+} SCHEDULER_ConfigLatencyCmdMsg_t;
+#define SCHEDULER_CFG_LATENCY_CMD_DATA_LEN  (sizeof(SCHEDULER_ConfigLatencyCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+typedef struct
+{
+   
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   uint8   Tbl;        /* SCHEDULER_PATCH_MSG_TBL or SCHEDULER_PATCH_SCH_TBL */
+   bool    Activate;   /* 0=FALSE(Discard), 1=TRUE(Activate) */
+
+} SCHEDULER_ActivatePatchCmdMsg_t;
+#define SCHEDULER_ACTIVATE_PATCH_CMD_DATA_LEN  (sizeof(SCHEDULER_ActivatePatchCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
 typedef struct
 {
    
@@ -205,6 +323,16 @@ typedef struct
 #define SCHEDULER_SEND_MSG_ENTRY_CMD_DATA_LEN (sizeof(SCHEDULER_SendMsgEntryCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
 
 
+typedef struct
+{
+   
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   uint16   Index;
+
+} SCHEDULER_SendMsgRefsCmdMsg_t;
+#define SCHEDULER_SEND_MSG_REFS_CMD_DATA_LEN  (sizeof(SCHEDULER_SendMsgRefsCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+
 
 typedef struct
 {
@@ -232,7 +360,8 @@ typedef struct
    uint8  Activity;
    
    SCHTBL_Entry_t   SchTblEntry;
-   MSGTBL_Entry_t   MsgTblEntry;
+   uint16           MsgTblWordCnt;
+   uint16           MsgTblEntry[MSGTBL_MAX_MSG_WORDS];  /* Message definition words */
 
 } SCHEDULER_TblEntryPkt_t;
 #define SCHEDULER_TBL_ENTRY_TLM_LEN sizeof (SCHEDULER_TblEntryPkt_t)
@@ -256,6 +385,16 @@ typedef struct
    uint8   SyncToMET;
    uint8   MajorFrameSource;
    uint8   Spare;
+   uint32  TriggerDispatchCount;
+   uint32  TriggerCoalescedCount;
+   uint32  TriggersPending;
+   uint32  DisabledGroups;
+   uint32  PendingDisabledGroups;
+   uint32  ShedActivityCount;
+   uint8   ShedLevel;
+   uint8   ShedClearFrames;
+   uint16  ShedSpare;
+   uint32  EventsSuppressedCount;
    
    /*
    ** Send all the activities for the command-specified slot
@@ -267,6 +406,175 @@ typedef struct
 #define SCHEDULER_DIAG_TLM_LEN sizeof (SCHEDULER_DiagPkt_t)
 
 
+/*
+** Software Bus utilization sent at the end of each major frame
+**
+** - Slot counters are cumulative since the last reset so ground rates are
+**   computed from the differences between packets. Event-triggered sends
+**   are counted in the slot that dispatched them.
+** - Peaks are the most sent in a single major frame or in a single pass of
+**   a slot since the last reset.
+*/
+
+typedef struct
+{
+
+   uint32  MsgCnt;
+   uint32  Bytes;
+   uint16  FailCnt;
+   uint16  PeakMsgCnt;
+   uint32  PeakBytes;
+
+} SCHEDULER_SlotRate_t;
+
+typedef struct
+{
+
+   CFE_MSG_TelemetryHeader_t TlmHeader;
+
+   uint32  FrameCnt;              /* Major frames included in the slot counters */
+   
+   uint16  FrameMsgCnt;           /* Last major frame */
+   uint16  FrameFailCnt;
+   uint32  FrameBytes;
+
+   uint16  PeakFrameMsgCnt;
+   uint16  PeakSpare;
+   uint32  PeakFrameBytes;
+
+   SCHEDULER_SlotRate_t Slot[SCHTBL_SLOTS];
+
+} SCHEDULER_RatePkt_t;
+#define SCHEDULER_RATE_TLM_LEN sizeof (SCHEDULER_RatePkt_t)
+
+
+/*
+** Wakeup lateness sent at the end of each major frame while lateness
+** measurement is enabled. Lateness is the time from the start of the slot
+** to the message being sent. Statistics are since measurement was enabled.
+*/
+
+typedef struct
+{
+
+   uint32  SendCnt;
+   uint32  AvgUs;
+   uint32  MaxUs;
+
+} SCHEDULER_MsgLatency_t;
+
+typedef struct
+{
+
+   CFE_MSG_TelemetryHeader_t TlmHeader;
+
+   uint32  FrameCnt;
+   uint32  SendCnt;
+   uint32  AvgUs;
+   uint32  MaxUs;
+   uint16  MaxMsgTblIndex;    /* Message with the largest lateness */
+   uint16  Spare;
+
+   SCHEDULER_MsgLatency_t Msg[MSGTBL_MAX_ENTRIES];
+
+} SCHEDULER_LatencyPkt_t;
+#define SCHEDULER_LATENCY_TLM_LEN sizeof (SCHEDULER_LatencyPkt_t)
+
+/*
+** Latency stamp sent after each measured message while stamping is
+** enabled. Receivers match it to the message they received by message ID.
+*/
+
+typedef struct
+{
+
+   CFE_MSG_TelemetryHeader_t TlmHeader;
+
+   uint16  MsgTblIndex;
+   uint16  MsgId;                   /* Stamped message's ID */
+   CFE_TIME_SysTime_t  SlotStart;   /* MET lateness is measured from */
+   CFE_TIME_SysTime_t  Sent;        /* MET the message was sent */
+
+} SCHEDULER_LatencyStampPkt_t;
+#define SCHEDULER_LATENCY_STAMP_TLM_LEN sizeof (SCHEDULER_LatencyStampPkt_t)
+
+
+/******************************************************************************
+** Event Limiter
+**
+** - Counts a limited event's sends and suppressions in the current window
+*/
+
+typedef struct
+{
+
+   uint16  SentCnt;         /* Events sent */
+   uint16  FirstSlot;       /* Slot of the first suppressed event */
+   uint16  LastSlot;        /* Slot of the last suppressed event */
+   uint16  Spare;
+   uint32  SuppressedCnt;
+   uint32  WorstValue;
+
+} SCHEDULER_EvsLimit_t;
+
+
+/******************************************************************************
+** Scheduler Health
+**
+** - Rates and peaks over the last complete window of HEALTH_WINDOW_FRAMES
+**   major frames so bursts aren't hidden when HK is downsampled
+** - Rates are per second x 100 using the nominal major frame period
+*/
+
+typedef struct
+{
+
+   uint16  WindowFrames;       /* Major frames in the window */
+   uint16  CatchUpFramePct;    /* Frames with a skipped or non-routine multiple slot wakeup */
+   uint32  SlotRate;
+   uint32  ActivityRate;       /* Activities sent */
+   uint32  FailureRate;        /* Activity send failures */
+   uint16  PeakProcessCount;   /* Most slots processed in one wakeup */
+   uint16  Spare;
+   uint32  PeakSlotUs;         /* Longest slot processing time */
+
+} SCHEDULER_Health_t;
+
+
+/******************************************************************************
+** Scheduler Statistics
+**
+** - Field order matches the scheduler section of KIT_SCH_HkPkt_t so the HK
+**   packet can be populated with a single copy
+** - Published by the scheduler task. The frame callback counters are copied
+**   using the callbacks' sequence counters so the snapshot is consistent
+**   without locking. See SCHEDULER_Class_t.
+*/
+
+typedef struct
+{
+
+   uint32  SlotsProcessedCount;
+   uint32  ScheduleActivitySuccessCount;
+   uint32  ScheduleActivityFailureCount;
+   uint32  ValidMajorFrameCount;
+   uint32  MissedMajorFrameCount;
+   uint32  UnexpectedMajorFrameCount;
+   uint32  TablePassCount;
+   uint32  ConsecutiveNoisyFrameCounter;
+   uint16  SkippedSlotsCount;
+   uint16  MultipleSlotsCount;
+   uint16  SameSlotCount;
+   uint16  SyncAttemptsLeft;
+   uint16  LastSyncMETSlot;
+   bool    IgnoreMajorFrame;
+   bool    UnexpectedMajorFrame;
+   
+   SCHEDULER_Health_t  Health;
+
+} SCHEDULER_Stats_t;
+
+
 /******************************************************************************
 ** Scheduler Class
 */
@@ -280,6 +588,9 @@ typedef struct
    
    SCHEDULER_TblEntryPkt_t TblEntryPkt;
    SCHEDULER_DiagPkt_t     DiagPkt;
+   SCHEDULER_RatePkt_t     RatePkt;
+   SCHEDULER_LatencyPkt_t  LatencyPkt;
+   SCHEDULER_LatencyStampPkt_t  LatencyStampPkt;
 
    /*
    ** Scheduler State
@@ -293,9 +604,29 @@ typedef struct
    uint32  ScheduleActivitySuccessCount;  /* Number of successfully performed activities */
    uint32  ScheduleActivityFailureCount;  /* Number of unsuccessful activities attempted */
 
+   /*
+   ** Frame callback counters. Each callback increments its sequence counter
+   ** before and after it updates the counters it owns so the scheduler task
+   ** can detect a copy that overlapped an update. The task never writes
+   ** them. A reset records the counts at the reset and requests the major
+   ** frame callback to clear its noise state.
+   **
+   ** MajorFrameCallback(): ValidMajorFrameCount, UnexpectedMajorFrameCount,
+   **   ConsecutiveNoisyFrameCounter, IgnoreMajorFrame, UnexpectedMajorFrame
+   ** MinorFrameCallback(): MissedMajorFrameCount, SyncAttemptsLeft
+   ** Both: LastSyncMETSlot
+   */
+
+   volatile uint32  ToneSequence;
+   volatile uint32  TimerSequence;
+   volatile bool    ToneResetPending;
+
    uint32  ValidMajorFrameCount;          /* Number of valid Major Frame tones received */
    uint32  MissedMajorFrameCount;         /* Number of missing Major Frame tones */
    uint32  UnexpectedMajorFrameCount;     /* Number of unexpected Major Frame tones */
+   uint32  ResetValidMajorFrameCount;     /* Counts at the last reset */
+   uint32  ResetMissedMajorFrameCount;
+   uint32  ResetUnexpectedMajorFrameCount;
 
    uint32  TablePassCount;                /* Number of times Schedule Table has been processed */
    uint32  ConsecutiveNoisyFrameCounter;  /* Number of consecutive noisy Major Frames */
@@ -318,6 +649,102 @@ typedef struct
    uint32  ClockAccuracy;                 /* Accuracy of Minor Frame Timer */
    uint32  WorstCaseSlotsPerMinorFrame;   /* When syncing to MET, worst case # of slots that may need */
 
+   uint32  PerfId;                        /* First of KIT_SCH_PERF_ID_CNT performance log IDs */
+
+   SCHEDULER_Stats_t Stats;               /* Published snapshot of the counters above */
+
+   /*
+   ** Health window. The counters at the start of the window are used to
+   ** compute the rates when the window completes.
+   */
+   
+   SCHEDULER_Health_t Health;             /* Last complete window */
+   uint16  HealthWindow;                  /* Major frames per window */
+   uint16  WinFrames;
+   uint16  WinCatchUpFrames;
+   uint16  WinPeakProcessCount;
+   uint32  WinPeakSlotUs;
+   uint32  WinStartSlots;
+   uint32  WinStartSuccess;
+   uint32  WinStartFailures;
+   bool    FrameCatchUp;                  /* Current major frame had a skipped or non-routine multiple slot wakeup */
+
+   /*
+   ** Event-triggered activities
+   */
+   
+   CFE_SB_PipeId_t  TriggerPipe;
+   CFE_SB_MsgId_t   TriggerMid[SCHTBL_MAX_TRIGGERS];  /* Enabled trigger message IDs, CFE_SB_INVALID_MSG_ID if unused */
+   uint32  TriggerTblUpdateCnt;           /* SchTbl.UpdateCnt when the trigger subscriptions were made */
+   uint32  TriggersPending;               /* One bit per trigger waiting for the next slot */
+   uint32  TriggerDispatchCount;          /* Number of event-triggered activities performed */
+   uint32  TriggerCoalescedCount;         /* Number of triggers received while the same trigger was pending */
+   bool    ImmediateTriggers;             /* At least one enabled trigger is dispatched immediately */
+
+   /*
+   ** Activity groups
+   */
+   
+   uint32  DisabledGroups;                /* Activities in any of these groups are not performed */
+   uint32  PendingDisabledGroups;         /* Applied to DisabledGroups at the next major frame */
+
+   /*
+   ** Schedule modes. The active mode is maintained by SchTbl.
+   */
+   
+   uint16  PendingMode;                   /* Activated at the next major frame */
+
+   /*
+   ** Load shedding. Activities with a non-zero shed priority less than or
+   ** equal to ShedLevel are not performed.
+   */
+   
+   uint8   ShedLevel;                     /* 0 = No activities are shed */
+   uint8   ShedClearFrames;               /* Consecutive major frames below the shed thresholds */
+   uint16  ShedFrameFailures;             /* Activity send failures in the current major frame */
+   uint16  ShedFrameOverruns;             /* Skipped and non-routine multiple slot wakeups in the current major frame */
+   uint32  ShedActivityCount;             /* Number of activities not performed due to load shedding */
+
+   /*
+   ** Software Bus utilization in the current major frame. Cumulative
+   ** counters are kept in RatePkt.
+   */
+   
+   uint16  RateSlotMsgs[SCHTBL_SLOTS];
+   uint16  RateSlotFailures[SCHTBL_SLOTS];
+   uint32  RateSlotBytes[SCHTBL_SLOTS];
+
+   /*
+   ** Timing fault injection. The command sets the fault and count and the
+   ** frame callbacks consume the count.
+   */
+   
+   volatile uint8    InjectFault;         /* SCHEDULER_FAULT_* */
+   uint8             InjectSettleFrames;  /* Major frames left before the outcome is reported */
+   volatile uint16   InjectCnt;           /* Signals left to affect */
+   SCHEDULER_Stats_t InjectStats;         /* Counters when the injection was commanded */
+
+   /*
+   ** Wakeup lateness. The frame callbacks record the MET that each slot
+   ** started when measurement is enabled. Both callbacks can record slot 0
+   ** so each start time is a single 32-bit word that is written and read
+   ** atomically. It holds the low 32 bits of the MET in microseconds and 0
+   ** means it hasn't been recorded.
+   */
+   
+   volatile bool       LatencyEnabled;
+   bool                LatencyStamp;
+   volatile uint32     SlotStartUs[SCHTBL_SLOTS];
+   uint64              LatencyTotalUs[MSGTBL_MAX_ENTRIES];
+
+   /*
+   ** Event limiting. Suppressed events are summarized at the end of each
+   ** window.
+   */
+   
+   SCHEDULER_EvsLimit_t  EvsLimit[SCHEDULER_EVS_LIMITS];
+   uint16  EvsLimitFrames;                /* Major frames in the current window */
+   uint32  EventsSuppressedCount;
 
    /*
    ** Contained Objects
@@ -325,6 +752,10 @@ typedef struct
    
    MSGTBL_Class_t MsgTbl;
    SCHTBL_Class_t SchTbl;
+   SCHANALYZER_Class_t SchAnalyzer;
+   SCHBALANCER_Class_t SchBalancer;
+   SCHTRACE_Class_t    Trace;
+   SCHPROFILE_Class_t  Profile;
    
 } SCHEDULER_Class_t;
 
@@ -370,6 +801,20 @@ void SCHEDULER_ResetStatus(void);
 bool SCHEDULER_Execute(void);
 
 
+/******************************************************************************
+** Function: SCHEDULER_GetStats
+**
+** Copy the scheduler statistics published at the end of the last wakeup
+** into Stats.
+**
+** Notes:
+**   1. Must be called from the scheduler task. The snapshot is only written
+**      by the task so the copy can't overlap an update.
+**
+*/
+void SCHEDULER_GetStats(SCHEDULER_Stats_t* Stats);
+
+
 /******************************************************************************
 ** Function: SCHEDULER_StartTimers
 **
@@ -387,6 +832,87 @@ int32 SCHEDULER_StartTimers(void);
 bool SCHEDULER_ConfigSchEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
 
+/******************************************************************************
+** Function: SCHEDULER_ConfigGroupCmd
+**
+** Enable or disable all of the activities that belong to the groups in the
+** command's group mask.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. Group changes are applied together at the start of the next major
+**      frame so a schedule is never partially reconfigured. Multiple 
+**      commands received in the same major frame are combined.
+**
+*/
+bool SCHEDULER_ConfigGroupCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCHEDULER_SwitchModeCmd
+**
+** Switch to one of the resident schedule modes.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. The mode is activated at the start of the next major frame.
+**
+*/
+bool SCHEDULER_SwitchModeCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCHEDULER_InjectFaultCmd
+**
+** Inject a number of major or minor frame signal faults.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. Only accepted when SCHEDULER_TIMING_FAULTS is true. One fault type
+**      is injected at a time and a new command replaces the previous one.
+**   3. The faults are applied by the frame callbacks so the scheduler's
+**      catch-up, noisy tone and resynchronization logic responds as it would
+**      to real timing faults. The change in the frame and slot counters is
+**      reported in an event after the last fault and a settling period.
+**
+*/
+bool SCHEDULER_InjectFaultCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCHEDULER_ConfigLatencyCmd
+**
+** Enable or disable wakeup lateness measurement.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. While enabled the lateness of each message sent is accumulated for
+**      its message table entry and the lateness telemetry packet is sent
+**      at the end of each major frame. Enabling clears the statistics.
+**   3. If Stamp is true a latency stamp packet is sent after each measured
+**      message with the MET the slot started and the MET the message was
+**      sent, so receiving apps can measure the end-to-end latency. The
+**      scheduled messages aren't changed.
+**
+*/
+bool SCHEDULER_ConfigLatencyCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCHEDULER_ActivatePatchCmd
+**
+** Activate or discard a table's staged patch.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. Patch loads are staged so a patch that changes several related
+**      entries is applied between two slots by one command and it can be
+**      reviewed before it is used.
+**
+*/
+bool SCHEDULER_ActivatePatchCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Function: SCHEDULER_LoadSchEntryCmd
 **
@@ -437,6 +963,20 @@ bool SCHEDULER_LoadMsgEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
 bool SCHEDULER_SendMsgEntryCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
 
+/******************************************************************************
+** Function: SCHEDULER_SendMsgRefsCmd
+**
+** Send informational event messages listing every scheduler table entry and
+** the number of enabled triggers that reference the command-specified
+** message table entry. Disabled entries are suffixed with a 'd'.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**
+*/
+bool SCHEDULER_SendMsgRefsCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Function: SCHEDULER_SendDiagTlmCmd
 **
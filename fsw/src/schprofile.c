@@ -0,0 +1,427 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the scheduler dispatch path profiler
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "schprofile.h"
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static void   CompleteRun(void);
+static uint32 ElapsedNs(OS_time_t Start);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCHPROFILE_Class_t*  SchProfile = NULL;
+
+
+/******************************************************************************
+** Function: SCHPROFILE_Constructor
+**
+*/
+void SCHPROFILE_Constructor(SCHPROFILE_Class_t* ObjPtr, const INITBL_Class_t* IniTbl)
+{
+
+   SchProfile = ObjPtr;
+
+   CFE_PSP_MemSet((void*)SchProfile, 0, sizeof(SCHPROFILE_Class_t));
+
+   CFE_MSG_Init(CFE_MSG_PTR(SchProfile->TlmPkt.TlmHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_KIT_SCH_PROFILE_TLM_TOPICID)), SCHPROFILE_TLM_LEN);
+
+} /* End SCHPROFILE_Constructor() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_StartCmd
+**
+*/
+bool SCHPROFILE_StartCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const SCHPROFILE_StartCmdMsg_t *StartCmd = (const SCHPROFILE_StartCmdMsg_t *) MsgPtr;
+
+   if (SchProfile->Active)
+   {
+      CompleteRun();
+   }
+
+   SchProfile->PendingFrames = StartCmd->Frames;
+
+   if (StartCmd->Frames > 0)
+   {
+      CFE_EVS_SendEvent(SCHPROFILE_START_EID, CFE_EVS_EventType_INFORMATION,
+                        "Scheduler profile of %d major frames starts at the next major frame",
+                        StartCmd->Frames);
+   }
+
+   return true;
+
+} /* End SCHPROFILE_StartCmd() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_WakeupStart
+**
+*/
+void SCHPROFILE_WakeupStart(void)
+{
+
+   if (SchProfile->Active)
+   {
+      CFE_PSP_GetTime(&SchProfile->WakeupStart);
+      SchProfile->WakeupTimed = true;
+   }
+
+} /* End SCHPROFILE_WakeupStart() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_WakeupEnd
+**
+** Notes:
+**   1. A run starts during a wakeup so a wakeup or slot is only counted if
+**      its start was timed.
+**
+*/
+void SCHPROFILE_WakeupEnd(void)
+{
+
+   SCHPROFILE_TlmPkt_t* TlmPkt = &SchProfile->TlmPkt;
+   uint32 Ns;
+
+   if (SchProfile->Active && SchProfile->WakeupTimed)
+   {
+
+      Ns = ElapsedNs(SchProfile->WakeupStart);
+      SchProfile->WakeupTimed = false;
+
+      TlmPkt->WakeupCnt++;
+      SchProfile->WakeupTotalNs += Ns;
+      if (Ns > TlmPkt->WakeupMaxNs)
+      {
+         TlmPkt->WakeupMaxNs = Ns;
+      }
+
+   }
+
+} /* End SCHPROFILE_WakeupEnd() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_SlotStart
+**
+*/
+void SCHPROFILE_SlotStart(void)
+{
+
+   if (SchProfile->Active)
+   {
+      CFE_PSP_GetTime(&SchProfile->SlotStart);
+      SchProfile->SlotTimed = true;
+   }
+
+} /* End SCHPROFILE_SlotStart() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_SlotEnd
+**
+*/
+void SCHPROFILE_SlotEnd(uint16 Slot, uint16 SendCnt)
+{
+
+   SCHPROFILE_Slot_t* SlotPrf = &SchProfile->TlmPkt.Slot[Slot];
+   uint32 Ns;
+
+   if (SchProfile->Active && SchProfile->SlotTimed)
+   {
+
+      Ns = ElapsedNs(SchProfile->SlotStart);
+      SchProfile->SlotTimed = false;
+
+      SlotPrf->SlotCnt++;
+      SlotPrf->SendCnt += SendCnt;
+      SchProfile->SlotTotalNs[Slot] += Ns;
+
+      if ((SlotPrf->MinNs == 0) || (Ns < SlotPrf->MinNs))
+      {
+         SlotPrf->MinNs = Ns;
+      }
+      if (Ns > SlotPrf->MaxNs)
+      {
+         SlotPrf->MaxNs = Ns;
+      }
+
+   }
+
+} /* End SCHPROFILE_SlotEnd() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_SlotLag
+**
+*/
+void SCHPROFILE_SlotLag(uint32 SlotsDue)
+{
+
+   if (SchProfile->Active)
+   {
+      if (SlotsDue >= SCHPROFILE_LAG_BINS)
+      {
+         SlotsDue = SCHPROFILE_LAG_BINS - 1;
+      }
+      SchProfile->TlmPkt.LagBin[SlotsDue]++;
+   }
+
+} /* End SCHPROFILE_SlotLag() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_MinorTick
+**
+*/
+void SCHPROFILE_MinorTick(uint32 ExpectedUs)
+{
+
+   SCHPROFILE_TlmPkt_t* TlmPkt = &SchProfile->TlmPkt;
+   OS_time_t Now;
+   int32     ErrUs;
+   uint32    Bin;
+
+   if (!SchProfile->TickActive)
+   {
+      SchProfile->TickTimed = false;
+      return;
+   }
+
+   CFE_PSP_GetTime(&Now);
+
+   if (SchProfile->TickTimed && (ExpectedUs > 0))
+   {
+
+      ErrUs = (int32)(OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Now, SchProfile->LastTick)) - ExpectedUs);
+
+      if ((TlmPkt->TickCnt == 0) || (ErrUs < TlmPkt->TickMinErrUs))
+      {
+         TlmPkt->TickMinErrUs = ErrUs;
+      }
+      if ((TlmPkt->TickCnt == 0) || (ErrUs > TlmPkt->TickMaxErrUs))
+      {
+         TlmPkt->TickMaxErrUs = ErrUs;
+      }
+
+      Bin = ((ErrUs < 0) ? -ErrUs : ErrUs) / SCHPROFILE_TICK_BIN_US;
+      if (Bin >= SCHPROFILE_TICK_BINS)
+      {
+         Bin = SCHPROFILE_TICK_BINS - 1;
+      }
+      TlmPkt->TickErrBin[Bin]++;
+      TlmPkt->TickCnt++;
+
+   }
+
+   SchProfile->LastTick  = Now;
+   SchProfile->TickTimed = true;
+
+} /* End SCHPROFILE_MinorTick() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_FrameEnd
+**
+*/
+void SCHPROFILE_FrameEnd(void)
+{
+
+   SCHPROFILE_TlmPkt_t* TlmPkt = &SchProfile->TlmPkt;
+   uint32 ProfileCnt;
+
+   if (SchProfile->Active)
+   {
+      TlmPkt->FramesLeft--;
+      if (TlmPkt->FramesLeft == 0)
+      {
+         CompleteRun();
+      }
+   }
+
+   if (SchProfile->PendingFrames > 0)
+   {
+
+      ProfileCnt = TlmPkt->ProfileCnt;
+      CFE_PSP_MemSet(&TlmPkt->ProfileCnt, 0, SCHPROFILE_TLM_LEN - sizeof(CFE_MSG_TelemetryHeader_t));
+      CFE_PSP_MemSet(SchProfile->SlotTotalNs, 0, sizeof(SchProfile->SlotTotalNs));
+      SchProfile->WakeupTotalNs = 0;
+      SchProfile->WakeupTimed   = false;
+      SchProfile->SlotTimed     = false;
+
+      TlmPkt->ProfileCnt = ProfileCnt;
+      TlmPkt->Frames     = SchProfile->PendingFrames;
+      TlmPkt->FramesLeft = SchProfile->PendingFrames;
+      SchProfile->PendingFrames = 0;
+      SchProfile->Active = true;
+
+      KIT_SCH_MEM_BARRIER();
+      SchProfile->TickActive = true;
+
+   }
+
+} /* End SCHPROFILE_FrameEnd() */
+
+
+/******************************************************************************
+** Function: SCHPROFILE_ElapsedUs
+**
+*/
+uint32 SCHPROFILE_ElapsedUs(OS_time_t Start)
+{
+
+   OS_time_t Now;
+   int64     Us;
+
+   CFE_PSP_GetTime(&Now);
+   Us = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Now, Start));
+
+   return (Us < 0) ? 0 : (uint32)Us;
+
+} /* End SCHPROFILE_ElapsedUs() */
+
+
+/******************************************************************************
+** Function: CompleteRun
+**
+** Compute the averages, send the telemetry packet and the summary event.
+**
+*/
+static void CompleteRun(void)
+{
+
+   SCHPROFILE_TlmPkt_t* TlmPkt = &SchProfile->TlmPkt;
+   SCHPROFILE_Slot_t*   SlotPrf;
+   uint64 SlotTotalNs = 0;
+   uint32 SendCnt = 0;
+   uint16 Slot;
+   uint32 LateCnt = 0;
+
+   SchProfile->Active     = false;
+   SchProfile->TickActive = false;
+   KIT_SCH_MEM_BARRIER();
+
+   TlmPkt->ProfileCnt++;
+   TlmPkt->Frames    -= TlmPkt->FramesLeft;
+   TlmPkt->FramesLeft = 0;
+   TlmPkt->SlotCnt    = 0;
+   TlmPkt->SlotMaxNs  = 0;
+
+   if (TlmPkt->WakeupCnt > 0)
+   {
+      TlmPkt->WakeupAvgNs = (uint32)(SchProfile->WakeupTotalNs / TlmPkt->WakeupCnt);
+   }
+
+   for (Slot=0; Slot < SCHTBL_SLOTS; Slot++)
+   {
+
+      SlotPrf = &TlmPkt->Slot[Slot];
+      if (SlotPrf->SlotCnt > 0)
+      {
+         SlotPrf->AvgNs = (uint32)(SchProfile->SlotTotalNs[Slot] / SlotPrf->SlotCnt);
+      }
+
+      TlmPkt->SlotCnt += SlotPrf->SlotCnt;
+      SendCnt         += SlotPrf->SendCnt;
+      SlotTotalNs     += SchProfile->SlotTotalNs[Slot];
+      if (SlotPrf->MaxNs > TlmPkt->SlotMaxNs)
+      {
+         TlmPkt->SlotMaxNs = SlotPrf->MaxNs;
+      }
+
+   } /* End slot loop */
+
+   if (TlmPkt->SlotCnt > 0)
+   {
+      TlmPkt->SlotAvgNs = (uint32)(SlotTotalNs / TlmPkt->SlotCnt);
+   }
+   if (SendCnt > 0)
+   {
+      TlmPkt->SendAvgNs = (uint32)(SlotTotalNs / SendCnt);
+   }
+
+   for (Slot=2; Slot < SCHPROFILE_LAG_BINS; Slot++)
+   {
+      LateCnt += TlmPkt->LagBin[Slot];
+   }
+
+   CFE_EVS_SendEvent(SCHPROFILE_RESULT_EID, CFE_EVS_EventType_INFORMATION,
+                     "Scheduler profile of %d frames: Wakeup avg/max %d/%d ns, slot avg/max %d/%d ns, %d ns per activity",
+                     TlmPkt->Frames, TlmPkt->WakeupAvgNs, TlmPkt->WakeupMaxNs,
+                     TlmPkt->SlotAvgNs, TlmPkt->SlotMaxNs, TlmPkt->SendAvgNs);
+
+   CFE_EVS_SendEvent(SCHPROFILE_TICK_RESULT_EID, CFE_EVS_EventType_INFORMATION,
+                     "Scheduler profile timer: %d ticks with error %d to %d us, %d of %d wakeups had multiple slots due",
+                     TlmPkt->TickCnt, TlmPkt->TickMinErrUs, TlmPkt->TickMaxErrUs,
+                     LateCnt, TlmPkt->WakeupCnt);
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(TlmPkt->TlmHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(TlmPkt->TlmHeader), true);
+
+} /* End CompleteRun() */
+
+
+/******************************************************************************
+** Function: ElapsedNs
+**
+** Return the nanoseconds since Start, limited to the range of a uint32.
+**
+*/
+static uint32 ElapsedNs(OS_time_t Start)
+{
+
+   OS_time_t Now;
+   int64     Ns;
+
+   CFE_PSP_GetTime(&Now);
+   Ns = OS_TimeGetTotalNanoseconds(OS_TimeSubtract(Now, Start));
+
+   if (Ns < 0)
+   {
+      Ns = 0;
+   }
+   else if (Ns > 0xFFFFFFFF)
+   {
+      Ns = 0xFFFFFFFF;
+   }
+
+   return (uint32)Ns;
+
+} /* End ElapsedNs() */
@@ -0,0 +1,271 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the scheduler dispatch path profiler
+**
+**  Notes:
+**    1. On command the profiler times the scheduler task for a number of
+**       major frames. Each wakeup is timed from the semaphore being taken
+**       to the statistics being published and each slot is timed from the
+**       start to the end of ProcessNextSlot(). The results are sent in the
+**       profile telemetry packet and summarized in an event when the run
+**       completes so the same measurement can be repeated after each
+**       change to the dispatch path.
+**    2. Slot times include the Software Bus sends so the time per activity
+**       is the total slot time divided by the activities sent. Comparing
+**       slots with different activity counts and periods shows how the
+**       cost scales with table density.
+**    3. Times are read from the PSP's local clock in nanoseconds. The
+**       resolution is the platform's. The clock is only read while a run
+**       is active.
+**    4. SCHPROFILE_ElapsedUs() is also used to time table loads and dumps.
+**    5. During a run the minor frame callback times each nominal minor
+**       frame interval and the scheduler task counts how many slots were
+**       due at each wakeup. The histograms show the timer's jitter and the
+**       resulting slot error on the target's OS and configuration. The
+**       tick data has a single writer, the callback, and may be one tick
+**       out of date in the telemetry.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _schprofile_
+#define _schprofile_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define SCHPROFILE_START_EID        (SCHPROFILE_BASE_EID + 0)
+#define SCHPROFILE_RESULT_EID       (SCHPROFILE_BASE_EID + 1)
+#define SCHPROFILE_TICK_RESULT_EID  (SCHPROFILE_BASE_EID + 2)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Command Packets
+*/
+
+typedef struct
+{
+
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   uint16  Frames;     /* Major frames to profile, 0 ends an active run */
+
+} SCHPROFILE_StartCmdMsg_t;
+#define SCHPROFILE_START_CMD_DATA_LEN  (sizeof(SCHPROFILE_StartCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+
+/******************************************************************************
+** Telemetry Packets
+**
+** Times are in nanoseconds. Minimum times are 0 if nothing was measured.
+*/
+
+typedef struct
+{
+
+   uint32  SlotCnt;      /* Times the slot was processed */
+   uint32  SendCnt;      /* Activities sent by the slot */
+   uint32  AvgNs;
+   uint32  MinNs;
+   uint32  MaxNs;
+
+} SCHPROFILE_Slot_t;
+
+
+typedef struct
+{
+
+   CFE_MSG_TelemetryHeader_t TlmHeader;
+
+   uint32  ProfileCnt;    /* Completed runs */
+   uint16  Frames;        /* Major frames measured */
+   uint16  FramesLeft;    /* Non-zero while a run is active */
+
+   uint32  WakeupCnt;
+   uint32  WakeupAvgNs;
+   uint32  WakeupMaxNs;
+
+   uint32  SlotCnt;
+   uint32  SlotAvgNs;
+   uint32  SlotMaxNs;
+   uint32  SendAvgNs;     /* Slot time per activity sent */
+
+   uint32  TickCnt;                           /* Nominal minor frame intervals measured */
+   int32   TickMinErrUs;                      /* Earliest tick relative to the slot period */
+   int32   TickMaxErrUs;                      /* Latest tick relative to the slot period */
+   uint32  TickErrBin[SCHPROFILE_TICK_BINS];  /* Absolute tick error */
+   uint32  LagBin[SCHPROFILE_LAG_BINS];       /* Wakeups by slots due, 0 is the same slot and 1 is on time */
+
+   SCHPROFILE_Slot_t Slot[SCHTBL_SLOTS];
+
+} SCHPROFILE_TlmPkt_t;
+#define SCHPROFILE_TLM_LEN sizeof (SCHPROFILE_TlmPkt_t)
+
+
+/******************************************************************************
+** Scheduler Profiler Class
+*/
+
+typedef struct
+{
+
+   SCHPROFILE_TlmPkt_t  TlmPkt;
+
+   bool       Active;
+   uint16     PendingFrames;   /* Run started at the next major frame */
+   bool       WakeupTimed;     /* WakeupStart was read during the run */
+   bool       SlotTimed;       /* SlotStart was read during the run */
+   OS_time_t  WakeupStart;
+   OS_time_t  SlotStart;
+
+   volatile bool  TickActive;  /* Tick data may be written by the minor frame callback */
+   bool           TickTimed;   /* LastTick was read during the run */
+   OS_time_t      LastTick;
+   uint64     WakeupTotalNs;
+   uint64     SlotTotalNs[SCHTBL_SLOTS];
+
+} SCHPROFILE_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCHPROFILE_Constructor
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void SCHPROFILE_Constructor(SCHPROFILE_Class_t* ObjPtr, const INITBL_Class_t* IniTbl);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_StartCmd
+**
+** Start a profile run for the command's number of major frames.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. A run in progress is restarted. A zero frame count ends an active
+**      run and reports the frames measured so far.
+**   3. The run starts at the next major frame boundary so each frame is
+**      a complete table pass.
+**
+*/
+bool SCHPROFILE_StartCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_WakeupStart
+**
+** Notes:
+**   1. The SCHPROFILE_Wakeup*, SCHPROFILE_Slot* and SCHPROFILE_FrameEnd
+**      functions must only be called from the scheduler task.
+**
+*/
+void SCHPROFILE_WakeupStart(void);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_WakeupEnd
+**
+*/
+void SCHPROFILE_WakeupEnd(void);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_SlotStart
+**
+*/
+void SCHPROFILE_SlotStart(void);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_SlotEnd
+**
+*/
+void SCHPROFILE_SlotEnd(uint16 Slot, uint16 SendCnt);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_SlotLag
+**
+** Count a wakeup with the number of slots that were due.
+**
+*/
+void SCHPROFILE_SlotLag(uint32 SlotsDue);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_MinorTick
+**
+** Time a minor frame timer tick.
+**
+** Notes:
+**   1. Must only be called from the minor frame callback.
+**   2. ExpectedUs is the nominal time since the previous tick. Zero means
+**      the timer was reset or given a non-nominal period since the previous
+**      tick so the interval isn't measured.
+**
+*/
+void SCHPROFILE_MinorTick(uint32 ExpectedUs);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_FrameEnd
+**
+** Called at each major frame boundary. Starts a pending run and completes
+** the active run after its last frame.
+**
+*/
+void SCHPROFILE_FrameEnd(void);
+
+
+/******************************************************************************
+** Function: SCHPROFILE_ElapsedUs
+**
+** Return the microseconds since Start, limited to the range of a uint32.
+**
+** Notes:
+**   1. Start must be read with CFE_PSP_GetTime(). This doesn't depend on a
+**      profile run.
+**
+*/
+uint32 SCHPROFILE_ElapsedUs(OS_time_t Start);
+
+
+#endif /* _schprofile_ */
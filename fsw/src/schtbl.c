@@ -30,6 +30,13 @@
 
 #include <string.h>
 #include "schtbl.h"
+#include "jsonwalk.h"
+#include "tblimage.h"
+#include "msgtbl.h"
+#include "dumpwriter.h"
+#include "loadarena.h"
+#include "schanalyzer.h"
+#include "schprofile.h"
 
 /***********************/
 /** Macro Definitions **/
@@ -40,41 +47,27 @@
 /** Type Definitions **/
 /**********************/
 
-/* See LoadJsonData()prologue for details */
-typedef CJSON_IntObj_t JsonIndex_t;
-typedef CJSON_StrObj_t JsonEnabled_t;
-typedef CJSON_IntObj_t JsonPeriod_t;
-typedef CJSON_IntObj_t JsonOffset_t;
-typedef CJSON_IntObj_t JsonMsgIdx_t;
-
-typedef struct
-{
-
-   JsonIndex_t    Index;
-   JsonEnabled_t  Enabled;
-   JsonPeriod_t   Period;
-   JsonOffset_t   Offset;
-   JsonMsgIdx_t   MsgIdx;
-
-} JsonActivity_t;
-
-
-
-typedef struct
-{
-
-   JsonIndex_t    Index;
-
-} JsonSlot_t;
+#define JSON_ENABLED_STR_MAX   10
+#define JSON_DISPATCH_STR_MAX  12
 
 /*******************************/
 /** Local Function Prototypes **/
 /*******************************/
 
 
-static void ConstructJsonActivity(JsonActivity_t* JsonActivity, uint16 ActivityArrayIdx, uint16 SlotArrayIdx);
-static void ConstructJsonSlot(JsonSlot_t* JsonSlot, uint16 SlotArrayIdx);
+static bool EmptyTrigger(const SCHTBL_Trigger_t* Trigger);
+static bool LoadFile(const char* Filename);
+static bool ValidImage(const SCHTBL_Data_t* Data);
 static bool LoadJsonData(size_t JsonFileLen);
+static bool LoadJsonActivity(const JSONWALK_Cursor_t* JsonActivity, uint16 SlotIdx, uint16 ActivityIdx,
+                             uint16 SlotArrayIdx, uint16 ActivityArrayIdx);
+static bool LoadJsonTriggers(const JSONWALK_Cursor_t* JsonRoot, uint16* TriggerUpdateCnt);
+static void StagePatchEntry(uint16 EntryIdx);
+static void StagePatch(void);
+static void ApplyPatch(void);
+static void LogChange(uint8 Type, uint16 Index);
+static void IndexEntry(uint16 EntryIdx);
+static void RebuildMsgRefs(void);
 
 
 /**********************/
@@ -82,7 +75,22 @@ static bool LoadJsonData(size_t JsonFileLen);
 /**********************/
 
 static SCHTBL_Class_t* SchTbl = NULL;
-static SCHTBL_Data_t   TblData;        /* Working buffer for loads */
+static SCHTBL_Data_t*  LoadDataPtr = NULL;  /* Table data updated by LoadJsonData() */
+
+/*
+** Load working data allocated from the load arena
+*/
+static SCHTBL_Data_t*  TblData = NULL;  /* Working buffer for loads */
+static char*           JsonBuf = NULL;
+
+/*
+** Patch load state. Only the TblData entries and triggers listed in the
+** patch are valid during a patch load.
+*/
+static bool    LoadPatch = false;
+static uint16  PatchEntryCnt;
+static uint16* PatchEntry = NULL;      /* SCHTBL_MAX_ENTRIES */
+static uint32  PatchTriggers;  /* One bit per trigger */
 
 
 /******************************************************************************
@@ -92,7 +100,7 @@ static SCHTBL_Data_t   TblData;        /* Working buffer for loads */
 **    1. This must be called prior to any other functions
 **
 */
-void SCHTBL_Constructor(SCHTBL_Class_t* ObjPtr, const char* AppName)
+void SCHTBL_Constructor(SCHTBL_Class_t* ObjPtr, const char* AppName, uint32 LoadPerfId)
 {
    
    SchTbl = ObjPtr;
@@ -101,7 +109,13 @@ void SCHTBL_Constructor(SCHTBL_Class_t* ObjPtr, const char* AppName)
 
    SchTbl->AppName        = AppName;
    SchTbl->LastLoadStatus = TBLMGR_STATUS_UNDEF;
+   SchTbl->ActiveMode     = 0;
+   SchTbl->LoadPerfId     = LoadPerfId;
+   
+   LoadDataPtr = &SchTbl->Data;
 
+   RebuildMsgRefs();
+   
 } /* End SCHTBL_Constructor() */
 
 
@@ -125,28 +139,222 @@ void SCHTBL_ResetStatus(void)
 **  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
 **  2. Can assume valid table file name because this is a callback from 
 **     the app framework table manager that has verified the file.
+**  3. The time to read a successful load, excluding the table analysis, is
+**     reported in an event.
 */
 bool SCHTBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
 {
 
-   bool  RetStatus = false;
+   bool       RetStatus = false;
+   OS_time_t  StartTime;
 
-   if (CJSON_ProcessFile(Filename, SchTbl->JsonBuf, SCHTBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+   CFE_PSP_GetTime(&StartTime);
+   LoadDataPtr = &SchTbl->Data;
+   LoadPatch   = (LoadType == KIT_SCH_LOAD_TBL_PATCH);
+   
+   if (LoadFile(Filename))
    {
+      SchTbl->LastLoadUs = SCHPROFILE_ElapsedUs(StartTime);
+      CFE_EVS_SendEvent(SCHTBL_TIMING_EID, CFE_EVS_EventType_INFORMATION,
+                        "Scheduler table load of %d entries took %d us, %d us per entry",
+                        SchTbl->LastLoadCnt, SchTbl->LastLoadUs,
+                        ((SchTbl->LastLoadCnt > 0) ? (SchTbl->LastLoadUs / SchTbl->LastLoadCnt) : 0));
       SchTbl->Loaded = true;
+      SchTbl->ModeLoaded[SchTbl->ActiveMode] = true;
       SchTbl->LastLoadStatus = TBLMGR_STATUS_VALID;
       RetStatus = true;
+      SCHANALYZER_Run();
    }
    else
    {
       SchTbl->LastLoadStatus = TBLMGR_STATUS_INVALID;
    }
+   
+   LoadPatch = false;
 
    return RetStatus;
 
 } /* End of SchTBL_LoadCmd() */
 
 
+/******************************************************************************
+** Function: SCHTBL_ActivatePatch
+**
+*/
+bool SCHTBL_ActivatePatch(void)
+{
+
+   bool    RetStatus = SchTbl->PatchStaged;
+   uint16  i;
+   const SCHTBL_Entry_t*   Entry;
+   const SCHTBL_Trigger_t* Trigger;
+   
+   if (!SchTbl->PatchStaged)
+   {
+      CFE_EVS_SendEvent(SCHTBL_PATCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Scheduler table activate patch rejected. No patch is staged");
+   }
+
+   for (i=0; (i < SchTbl->StagedEntryCnt) && RetStatus; i++)
+   {
+      Entry = &SchTbl->Staged.Entry[SchTbl->StagedEntry[i]];
+      if (Entry->Enabled && !MSGTBL_EntryDefined(Entry->MsgTblIndex))
+      {
+         RetStatus = false;
+         CFE_EVS_SendEvent(SCHTBL_PATCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Scheduler table activate patch rejected. Entry %d sends undefined message table entry %d",
+                           SchTbl->StagedEntry[i], Entry->MsgTblIndex);
+      }
+   }
+   
+   for (i=0; (i < SCHTBL_MAX_TRIGGERS) && RetStatus; i++)
+   {
+      Trigger = &SchTbl->Staged.Trigger[i];
+      if ((SchTbl->StagedTriggers & (1u << i)) && Trigger->Enabled &&
+          !MSGTBL_EntryDefined(Trigger->MsgTblIndex))
+      {
+         RetStatus = false;
+         CFE_EVS_SendEvent(SCHTBL_PATCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Scheduler table activate patch rejected. Trigger %d sends undefined message table entry %d",
+                           i, Trigger->MsgTblIndex);
+      }
+   }
+   
+   if (RetStatus)
+   {
+      ApplyPatch();
+      SchTbl->PatchStaged = false;
+      SchTbl->UpdateCnt++;
+      SCHANALYZER_Run();
+   }
+   
+   return RetStatus;
+
+} /* End SCHTBL_ActivatePatch() */
+
+
+/******************************************************************************
+** Function: SCHTBL_DiscardPatch
+**
+*/
+bool SCHTBL_DiscardPatch(void)
+{
+
+   bool RetStatus = SchTbl->PatchStaged;
+   
+   if (SchTbl->PatchStaged)
+   {
+      SchTbl->PatchStaged = false;
+      CFE_EVS_SendEvent(SCHTBL_PATCH_EID, CFE_EVS_EventType_INFORMATION,
+                        "Scheduler table staged patch of %d entries and triggers 0x%08X discarded",
+                        SchTbl->StagedEntryCnt, SchTbl->StagedTriggers);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(SCHTBL_PATCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Scheduler table discard patch rejected. No patch is staged");
+   }
+   
+   return RetStatus;
+
+} /* End SCHTBL_DiscardPatch() */
+
+
+/******************************************************************************
+** Function: SCHTBL_LoadModeFiles
+**
+*/
+void SCHTBL_LoadModeFiles(const char* FileList)
+{
+
+   char        Filename[OS_MAX_PATH_LEN];
+   const char* FilePtr = FileList;
+   const char* DelimPtr;
+   size_t      FilenameLen;
+   uint16      Mode = 1;
+   
+   while ((*FilePtr != '\0') && (Mode < SCHTBL_MODES))
+   {
+   
+      DelimPtr    = strchr(FilePtr, ',');
+      FilenameLen = (DelimPtr == NULL) ? strlen(FilePtr) : (size_t)(DelimPtr - FilePtr);
+      
+      if (FilenameLen >= OS_MAX_PATH_LEN)
+      {
+         CFE_EVS_SendEvent(SCHTBL_MODE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Schedule mode %d not loaded. Filename length %d exceeds max %d",
+                           Mode, (int)FilenameLen, (OS_MAX_PATH_LEN-1));
+      }
+      else if (FilenameLen > 0)
+      {
+         
+         memcpy(Filename, FilePtr, FilenameLen);
+         Filename[FilenameLen] = '\0';
+         
+         memset(&SchTbl->Mode[Mode], 0, sizeof(SCHTBL_Data_t));
+         LoadDataPtr = &SchTbl->Mode[Mode];
+      
+         SchTbl->ModeLoaded[Mode] = LoadFile(Filename);
+         
+         CFE_EVS_SendEvent(SchTbl->ModeLoaded[Mode] ? SCHTBL_MODE_EID : SCHTBL_MODE_ERR_EID, 
+                           SchTbl->ModeLoaded[Mode] ? CFE_EVS_EventType_INFORMATION : CFE_EVS_EventType_ERROR,
+                           "Schedule mode %d %s from %s", Mode, 
+                           SchTbl->ModeLoaded[Mode] ? "loaded" : "failed to load", Filename);
+      }
+      
+      FilePtr = (DelimPtr == NULL) ? (FilePtr + FilenameLen) : (DelimPtr + 1);
+      Mode++;
+      
+   } /* End while files */
+   
+   LoadDataPtr = &SchTbl->Data;
+   
+} /* End SCHTBL_LoadModeFiles() */
+
+
+/******************************************************************************
+** Function: SCHTBL_ModeLoaded
+**
+*/
+bool SCHTBL_ModeLoaded(uint16 Mode)
+{
+
+   return (Mode < SCHTBL_MODES) ? SchTbl->ModeLoaded[Mode] : false;
+
+} /* End SCHTBL_ModeLoaded() */
+
+
+/******************************************************************************
+** Function: SCHTBL_ActivateMode
+**
+*/
+void SCHTBL_ActivateMode(uint16 Mode)
+{
+
+   if (Mode != SchTbl->ActiveMode)
+   {
+      
+      if (SchTbl->PatchStaged)
+      {
+         SchTbl->PatchStaged = false;
+         CFE_EVS_SendEvent(SCHTBL_PATCH_EID, CFE_EVS_EventType_INFORMATION,
+                           "Scheduler table staged patch of %d entries and triggers 0x%08X discarded by switch from mode %d to %d",
+                           SchTbl->StagedEntryCnt, SchTbl->StagedTriggers, SchTbl->ActiveMode, Mode);
+      }
+      
+      memcpy(&SchTbl->Mode[SchTbl->ActiveMode], &SchTbl->Data, sizeof(SCHTBL_Data_t));
+      memcpy(&SchTbl->Data, &SchTbl->Mode[Mode], sizeof(SCHTBL_Data_t));
+      
+      SchTbl->ActiveMode = Mode;
+      SchTbl->UpdateCnt++;
+      
+      RebuildMsgRefs();
+   
+   }
+
+} /* End SCHTBL_ActivateMode() */
+
+
 /******************************************************************************
 ** Function: SCHTBL_DumpCmd
 **
@@ -158,32 +366,74 @@ bool SCHTBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
 **  3. File is formatted so it can be used as a load file. However all of the
 **     entries are dumped so you will get errors on the load for unused entries
 **     because unused entries have invalid  message indices.
-**  4. DumpType is unused.
+**  4. A KIT_SCH_DUMP_TBL_COMPACT dump omits activities and triggers that
+**     have never been defined. Loading it into an empty table creates the
+**     same table.
+**  5. A binary table image is written if the filename has the
+**     TBLIMAGE_FILE_EXT extension.
+**  6. The time to write a successful dump is reported in an event.
+**  7. A JSON dump includes the patch change log. The loader ignores it.
 */
 
 bool SCHTBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
+{
+
+   bool       RetStatus;
+   uint16     RecordCnt;
+   OS_time_t  StartTime;
+   
+   CFE_PSP_GetTime(&StartTime);
+   
+   RetStatus = SCHTBL_DumpData(&SchTbl->Data, DumpType, Filename, &RecordCnt);
+   
+   if (RetStatus)
+   {
+      SchTbl->LastDumpUs = SCHPROFILE_ElapsedUs(StartTime);
+      CFE_EVS_SendEvent(SCHTBL_TIMING_EID, CFE_EVS_EventType_INFORMATION,
+                        "Scheduler table dump of %d entries and triggers took %d us, %d us per entry",
+                        RecordCnt, SchTbl->LastDumpUs, ((RecordCnt > 0) ? (SchTbl->LastDumpUs / RecordCnt) : 0));
+   }
+   
+   return RetStatus;
+   
+} /* End of SCHTBL_DumpCmd() */
+
+
+/******************************************************************************
+** Function: SCHTBL_DumpData
+**
+*/
+bool SCHTBL_DumpData(const SCHTBL_Data_t* Data, uint8 DumpType, const char* Filename, uint16* RecordCnt)
 {
 
    bool      RetStatus = false;
-   osal_id_t FileHandle;
    int32     OsStatus;
-   uint16    EntryIdx, Slot, Activity;
-   char      DumpRecord[256];
+   uint16    EntryIdx, Slot, Activity, Trigger, Change;
+   bool      Compact = (DumpType == KIT_SCH_DUMP_TBL_COMPACT);
+   const SCHTBL_Change_t* ChangeLog;
+   bool      FirstRecord;
    char      SysTimeStr[64];
    os_err_name_t OsErrStr;
    
-   OsStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+   *RecordCnt = 0;
+   
+   if (TBLIMAGE_IsImageFile(Filename))
+   {
+      *RecordCnt = SCHTBL_MAX_ENTRIES + SCHTBL_MAX_TRIGGERS;
+      return TBLIMAGE_Write(Filename, TBLIMAGE_SCHTBL_ID, SCHTBL_MAX_ENTRIES,
+                            Data, sizeof(SCHTBL_Data_t));
+   }
+   
+   OsStatus = DUMPWRITER_Open(Filename);
    
    if (OsStatus == OS_SUCCESS)
    {
 
-      sprintf(DumpRecord,"\n{\n\"name\": \"Kit Scheduler (KIT_SCH) Scheduler Activity Table\",\n");
-      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+      DUMPWRITER_Printf("\n{\n\"name\": \"Kit Scheduler (KIT_SCH) Scheduler Activity Table\",\n");
 
       CFE_TIME_Print(SysTimeStr, CFE_TIME_GetTime());
       
-      sprintf(DumpRecord,"\"description\": \"KIT_SCH table dumped at %s\",\n",SysTimeStr);
-      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+      DUMPWRITER_Printf("\"description\": \"KIT_SCH table dumped at %s\",\n",SysTimeStr);
 
 
       /* 
@@ -206,63 +456,162 @@ bool SCHTBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
       **            "enabled": "true",
       **            "period":  4,
       **            "offset":  0,
-      **            "msg-idx": 0
+      **            "msg-idx": 0,
+      **            "groups":  0,
+      **            "shed-priority": 0,
+      **            "movable": "false"
       **         }},
       **         ...
       **      ...
       */
       
-      sprintf(DumpRecord,"\"slot-array\": [\n");
-      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+      DUMPWRITER_Printf("\"slot-array\": [\n");
 
       for (Slot=0; Slot < SCHTBL_SLOTS; Slot++)
       {
          
          if (Slot > 0)
          {
-            sprintf(DumpRecord,",\n");            
-            OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+            DUMPWRITER_Printf(",\n");            
          }
             
-         sprintf(DumpRecord,"   {\"slot\": {\n      \"index\": %d,\n      \"activity-array\" : [\n",Slot);         
-         OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+         DUMPWRITER_Printf("   {\"slot\": {\n      \"index\": %d,\n      \"activity-array\" : [\n",Slot);         
          
+         FirstRecord = true;
          for (Activity=0; Activity < SCHTBL_ACTIVITIES_PER_SLOT; Activity++)
          {
             
             EntryIdx = SCHTBL_INDEX(Slot,Activity);
 
-            if (Activity > 0)
+            if (Compact && SCHTBL_EmptyEntry(&Data->Entry[EntryIdx]))
             {
-               sprintf(DumpRecord,",\n");
-               OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+               continue;
             }
             
-            sprintf(DumpRecord,"         {\"activity\": {\n");
-            OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+            if (!FirstRecord)
+            {
+               DUMPWRITER_Printf(",\n");
+            }
+            FirstRecord = false;
+            (*RecordCnt)++;
             
-            sprintf(DumpRecord,"         \"index\": %d,\n         \"enabled\": \"%s\",\n         \"period\": %d,\n         \"offset\": %d,\n         \"msg-idx\": %d\n      }}",
+            DUMPWRITER_Printf("         {\"activity\": {\n");
+            
+            DUMPWRITER_Printf("         \"index\": %d,\n         \"enabled\": \"%s\",\n         \"period\": %d,\n         \"offset\": %d,\n         \"msg-idx\": %d,\n         \"groups\": %u,\n         \"shed-priority\": %d,\n         \"movable\": \"%s\"\n      }}",
                  Activity,
-                 CMDMGR_BoolStr(SchTbl->Data.Entry[EntryIdx].Enabled),
-                 SchTbl->Data.Entry[EntryIdx].Period,
-                 SchTbl->Data.Entry[EntryIdx].Offset,
-                 SchTbl->Data.Entry[EntryIdx].MsgTblIndex); 
-            OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+                 CMDMGR_BoolStr(Data->Entry[EntryIdx].Enabled),
+                 Data->Entry[EntryIdx].Period,
+                 Data->Entry[EntryIdx].Offset,
+                 Data->Entry[EntryIdx].MsgTblIndex,
+                 Data->Entry[EntryIdx].Groups,
+                 Data->Entry[EntryIdx].ShedPriority,
+                 CMDMGR_BoolStr(Data->Entry[EntryIdx].Movable)); 
          
          } /* End activity loop */             
       
-         sprintf(DumpRecord,"\n      ]\n   }}");
-         OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+         DUMPWRITER_Printf("\n      ]\n   }}");
       
       } /* End slot loop */
  
-      /* Close slot-array and top-level object */
-      sprintf(DumpRecord,"\n   ]\n}\n");
-      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+      /* Close slot-array */
+      DUMPWRITER_Printf("\n   ],\n");
 
-      RetStatus = true;
+      /* 
+      **   "trigger-array": [
+      **
+      **      {"trigger": {
+      **         "name":     "Data ready",   # Not saved
+      **         "descr":    "",             # Not saved
+      **         "index":    0,
+      **         "enabled":  "true",
+      **         "topic-id": 6272,
+      **         "dispatch": "next-slot",
+      **         "msg-idx":  40
+      **      }},
+      **      ...
+      */
+
+      DUMPWRITER_Printf("\"trigger-array\": [\n");
+
+      FirstRecord = true;
+      for (Trigger=0; Trigger < SCHTBL_MAX_TRIGGERS; Trigger++)
+      {
+         
+         if (Compact && EmptyTrigger(&Data->Trigger[Trigger]))
+         {
+            continue;
+         }
+         
+         if (!FirstRecord)
+         {
+            DUMPWRITER_Printf(",\n");            
+         }
+         FirstRecord = false;
+         (*RecordCnt)++;
+         
+         DUMPWRITER_Printf("   {\"trigger\": {\n      \"index\": %d,\n      \"enabled\": \"%s\",\n      \"topic-id\": %d,\n      \"dispatch\": \"%s\",\n      \"msg-idx\": %d\n   }}",
+                 Trigger,
+                 CMDMGR_BoolStr(Data->Trigger[Trigger].Enabled),
+                 Data->Trigger[Trigger].TopicId,
+                 SCHTBL_TriggerDispatchStr(Data->Trigger[Trigger].Dispatch),
+                 Data->Trigger[Trigger].MsgTblIndex); 
+      
+      } /* End trigger loop */
+
+      /* Close trigger-array */
+      DUMPWRITER_Printf("\n   ]");
+
+      /* 
+      ** The active table's patch change log, oldest change first. It isn't
+      ** loaded.
+      **
+      **   "patch-log": {
+      **      "patch-cnt": 3,
+      **      "staged": "false",
+      **      "change-array": [
+      **         {"patch": 2, "type": "entry", "index": 17},
+      **         ...
+      */
+      
+      if (Data == &SchTbl->Data)
+      {
+      
+         DUMPWRITER_Printf(",\n\"patch-log\": {\n   \"patch-cnt\": %d,\n   \"staged\": \"%s\",\n   \"change-array\": [",
+                           SchTbl->PatchCnt, CMDMGR_BoolStr(SchTbl->PatchStaged));
+         
+         FirstRecord = true;
+         for (Change=0; Change < SCHTBL_CHANGE_LOG_LEN; Change++)
+         {
+            
+            ChangeLog = &SchTbl->ChangeLog[(SchTbl->ChangeLogIdx + Change) % SCHTBL_CHANGE_LOG_LEN];
+            
+            if (ChangeLog->PatchCnt == 0)
+            {
+               continue;
+            }
+            
+            DUMPWRITER_Printf("%s\n      {\"patch\": %d, \"type\": \"%s\", \"index\": %d}",
+                              (FirstRecord ? "" : ","), ChangeLog->PatchCnt,
+                              ((ChangeLog->Type == SCHTBL_CHANGE_TRIGGER) ? "trigger" : "entry"),
+                              ChangeLog->Index);
+            FirstRecord = false;
+         
+         } /* End change log loop */
+         
+         DUMPWRITER_Printf("\n   ]\n}");
+      
+      } /* End if active table */
+      
+      /* Close top-level object */
+      DUMPWRITER_Printf("\n}\n");
 
-      OS_close(FileHandle);
+      RetStatus = DUMPWRITER_Close();
+      
+      if (!RetStatus)
+      {
+         CFE_EVS_SendEvent(SCHTBL_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Error writing dump file %s", Filename);
+      }
 
    } /* End if file create */
    else
@@ -283,7 +632,21 @@ bool SCHTBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
    
    return RetStatus;
    
-} /* End of SCHTBL_DumpCmd() */
+} /* End of SCHTBL_DumpData() */
+
+
+/******************************************************************************
+** Function: SCHTBL_EmptyEntry
+**
+*/
+bool SCHTBL_EmptyEntry(const SCHTBL_Entry_t* Entry)
+{
+
+   return ((Entry->Enabled == false) && (Entry->Period == 0) && (Entry->Offset == 0) &&
+           (Entry->MsgTblIndex == 0) && (Entry->Groups == 0) && (Entry->ShedPriority == 0) &&
+           (Entry->Movable == false));
+
+} /* End SCHTBL_EmptyEntry() */
 
 
 /******************************************************************************
@@ -371,12 +734,30 @@ bool SCHTBL_ValidEntry(const char* EventStr, uint16 Enabled, uint16 Period,
    {
       
       /* 
-      ** In theory Period and Offset can have any 16-bit value so an absolute
-      ** limit isn't checked. However if an Offset is greater than the Period 
-      ** then it will never execute. The Enabled flag should be used if a user
-      ** wants to explicitly disable a slot.
+      ** Period and Offset are 16-bit parameters but they are stored in 8-bit
+      ** table fields so larger values are rejected rather than truncated.
+      ** An entry is only executed when the table pass count modulo Period
+      ** equals Offset so an enabled entry's Period must be non-zero and its
+      ** Offset must be less than its Period. The Enabled flag should be used
+      ** if a user wants to explicitly disable a slot.
       */
-      if (Offset <= Period)
+      if ((Period > SCHTBL_MAX_PERIOD) || (Offset > SCHTBL_MAX_PERIOD))
+      {
+         
+         CFE_EVS_SendEvent(SCHTBL_OFFSET_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "%s. Period %d or Offset %d is greater than max %d",
+                           EventStr, Period, Offset, SCHTBL_MAX_PERIOD);    
+      
+      } /* End if period or offset too large */
+      else if ((Enabled == true) && (Period == 0))
+      {
+         
+         CFE_EVS_SendEvent(SCHTBL_OFFSET_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "%s. Enabled entry must have a non-zero Period",
+                           EventStr);    
+      
+      } /* End if enabled with zero period */
+      else if ((Offset < Period) || ((Enabled == false) && (Offset <= Period)))
       {
          
          if ( MsgTblIndex >= 0 && MsgTblIndex < MSGTBL_MAX_ENTRIES)
@@ -399,7 +780,7 @@ bool SCHTBL_ValidEntry(const char* EventStr, uint16 Enabled, uint16 Period,
       {
          
          CFE_EVS_SendEvent(SCHTBL_OFFSET_ERR_EID, CFE_EVS_EventType_ERROR,
-                           "%s. Offset %d is greater than Period %d",
+                           "%s. Offset %d must be less than Period %d",
                            EventStr, Offset, Period);    
       
       } /* End if invalid offset */            
@@ -419,191 +800,837 @@ bool SCHTBL_ValidEntry(const char* EventStr, uint16 Enabled, uint16 Period,
 
 
 /******************************************************************************
-** Function: ConstructJsonActivity
+** Function: SCHTBL_TriggerDispatchStr
 **
 */
-static void ConstructJsonActivity(JsonActivity_t* JsonActivity, uint16 ActivityArrayIdx, uint16 SlotArrayIdx)
+const char* SCHTBL_TriggerDispatchStr(uint8 Dispatch)
 {
 
-   char KeyStr[64];
+   return (Dispatch == SCHTBL_TRIGGER_IMMEDIATE) ? "immediate" : "next-slot";
 
-   sprintf(KeyStr,"slot-array[%d].slot.activity-array[%d].activity.index", SlotArrayIdx, ActivityArrayIdx);
-   CJSON_ObjConstructor(&JsonActivity->Index.Obj, KeyStr, JSONNumber, &JsonActivity->Index.Value, 4);
+} /* End SCHTBL_TriggerDispatchStr() */
 
-   sprintf(KeyStr,"slot-array[%d].slot.activity-array[%d].activity.enabled", SlotArrayIdx, ActivityArrayIdx);
-   CJSON_ObjConstructor(&JsonActivity->Enabled.Obj, KeyStr, JSONString, &JsonActivity->Enabled.Value, 10);
 
-   sprintf(KeyStr,"slot-array[%d].slot.activity-array[%d].activity.period", SlotArrayIdx, ActivityArrayIdx);
-   CJSON_ObjConstructor(&JsonActivity->Period.Obj, KeyStr, JSONNumber, &JsonActivity->Period.Value, 4);
+/******************************************************************************
+** Function: SCHTBL_EntryChanged
+**
+*/
+void SCHTBL_EntryChanged(uint16 EntryIdx)
+{
 
-   sprintf(KeyStr,"slot-array[%d].slot.activity-array[%d].activity.offset", SlotArrayIdx, ActivityArrayIdx);
-   CJSON_ObjConstructor(&JsonActivity->Offset.Obj, KeyStr, JSONNumber, &JsonActivity->Offset.Value, 4);
+   if (EntryIdx < SCHTBL_MAX_ENTRIES)
+   {
+      IndexEntry(EntryIdx);
+   }
 
-   sprintf(KeyStr,"slot-array[%d].slot.activity-array[%d].activity.msg-idx", SlotArrayIdx, ActivityArrayIdx);
-   CJSON_ObjConstructor(&JsonActivity->MsgIdx.Obj, KeyStr, JSONNumber, &JsonActivity->MsgIdx.Value, 4);
-   
-} /* ConstructJsonActivity() */
+} /* End SCHTBL_EntryChanged() */
 
 
 /******************************************************************************
-** Function: ConstructJsonSlot
+** Function: SCHTBL_GetFirstMsgRef
 **
 */
-static void ConstructJsonSlot(JsonSlot_t* JsonSlot, uint16 SlotArrayIdx)
+uint16 SCHTBL_GetFirstMsgRef(uint16 MsgTblIndex)
 {
 
-   char KeyStr[64];
+   return (MsgTblIndex < MSGTBL_MAX_ENTRIES) ? SchTbl->MsgRefHead[MsgTblIndex] : SCHTBL_MSG_REF_NONE;
 
-   sprintf(KeyStr,"slot-array[%d].slot.index", SlotArrayIdx);
-   CJSON_ObjConstructor(&JsonSlot->Index.Obj, KeyStr, JSONNumber, &JsonSlot->Index.Value, 4);
-   
-} /* ConstructJsonSlot() */
+} /* End SCHTBL_GetFirstMsgRef() */
 
 
 /******************************************************************************
-** Function: LoadJsonData
-**
-** Notes:
-**  1. The JSON file can contain 1 to SCHTBL_MAX_ENTRIES entries. The table can
-**     be sparsely populated.  
-**  2. JSON activity object
-**
-**        "name":  Not saved,
-**        "descr": Not saved,
-**        "index": 12,
-**        "enabled": true,
-**        "period": 4,
-**        "offset": 0,
-**        "msg-idx": 12
+** Function: SCHTBL_GetNextMsgRef
 **
 */
-static bool LoadJsonData(size_t JsonFileLen)
+uint16 SCHTBL_GetNextMsgRef(uint16 EntryIdx)
 {
 
-   bool    RetStatus = true;
-   bool    ReadSlot = true;
-   bool    ReadActivity = false;
-   uint16  EntryUdateCnt = 0;
-   uint16  AttributeCnt;
-   uint16  SlotIdx;
-   uint16  SlotArrayIdx;
-   uint16  ActivityIdx;
-   uint16  ActivityArrayIdx;
-   uint16  EntryIdx;
+   return (EntryIdx < SCHTBL_MAX_ENTRIES) ? SchTbl->MsgRefNext[EntryIdx] : SCHTBL_MSG_REF_NONE;
 
-   JsonSlot_t      JsonSlot;
-   JsonActivity_t  JsonActivity;
-   SCHTBL_Entry_t  SchEntry;
+} /* End SCHTBL_GetNextMsgRef() */
 
 
-   SchTbl->JsonFileLen = JsonFileLen;
+/******************************************************************************
+** Function: SCHTBL_MsgReferenced
+**
+** Notes:
+**   1. Triggers aren't indexed because there are only SCHTBL_MAX_TRIGGERS.
+**   2. The reverse index only covers the active table so the resident
+**      modes' entries are searched. This is only done for table loads.
+**
+*/
+bool SCHTBL_MsgReferenced(uint16 MsgTblIndex)
+{
 
-   /* 
-   ** 1. Copy table owner data into local table buffer
-   ** 2. Process JSON file which updates local table buffer with JSON supplied values
-   ** 3. If valid, copy local buffer over owner's data 
-   */
+   uint16 i, Mode;
+   const SCHTBL_Data_t* ModeData;
    
-   memcpy(&TblData, &SchTbl->Data, sizeof(SCHTBL_Data_t));
-
-   SlotArrayIdx = 0;
-   while (ReadSlot)
+   for (i=SCHTBL_GetFirstMsgRef(MsgTblIndex); i != SCHTBL_MSG_REF_NONE; i=SchTbl->MsgRefNext[i])
+   {
+      if (SchTbl->Data.Entry[i].Enabled) return true;
+   }
+   
+   for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+   {
+      if (SchTbl->Data.Trigger[i].Enabled && (SchTbl->Data.Trigger[i].MsgTblIndex == MsgTblIndex)) return true;
+   }
+   
+   for (Mode=0; Mode < SCHTBL_MODES; Mode++)
    {
-
-      ConstructJsonSlot(&JsonSlot, SlotArrayIdx);
-
-      /*
-      ** Use 'slot' and 'activity' fields to control looping over
-      ** the 'slot-array' and 'activity-array'. If either of these
-      ** are missing or malformed then the array traversal will be
-      ** terminated and a potential error will not be caught. Both
-      ** fields are required but CJSON_LoadObjOptional() is used 
-      ** so the 'object not found' event will be suppressed 
-      */      
       
-      if (CJSON_LoadObjOptional(&JsonSlot.Index.Obj, SchTbl->JsonBuf, SchTbl->JsonFileLen))
+      if ((Mode != SchTbl->ActiveMode) && SchTbl->ModeLoaded[Mode])
       {
-
-         /* 
-         ** Read JSON slot and activity values and let SCHTBL_GetEntryIndex()
-         ** perform validation and send error event messages.
-         */
-
-         SlotIdx = JsonSlot.Index.Value;
          
-         ReadActivity = true;
-         ActivityArrayIdx = 0;
-            
-         while (ReadActivity)
+         ModeData = &SchTbl->Mode[Mode];
+         for (i=0; i < SCHTBL_MAX_ENTRIES; i++)
          {
-
-            memset((void*)&SchEntry,0,sizeof(SCHTBL_Entry_t));
-            ConstructJsonActivity(&JsonActivity, ActivityArrayIdx, SlotArrayIdx);
-            
-            if (CJSON_LoadObjOptional(&JsonActivity.Index.Obj, SchTbl->JsonBuf, SchTbl->JsonFileLen))
-            {
-               
-               ActivityIdx = JsonActivity.Index.Value;
-               AttributeCnt = 0;
-               if (CJSON_LoadObj(&JsonActivity.Enabled.Obj, SchTbl->JsonBuf, SchTbl->JsonFileLen)) AttributeCnt++;
-               if (CJSON_LoadObj(&JsonActivity.Period.Obj,  SchTbl->JsonBuf, SchTbl->JsonFileLen)) AttributeCnt++;
-               if (CJSON_LoadObj(&JsonActivity.Offset.Obj,  SchTbl->JsonBuf, SchTbl->JsonFileLen)) AttributeCnt++;
-               if (CJSON_LoadObj(&JsonActivity.MsgIdx.Obj,  SchTbl->JsonBuf, SchTbl->JsonFileLen)) AttributeCnt++;
-               
-               if (AttributeCnt == 4)
-               {
-                  SchEntry.Enabled     = (strcmp(JsonActivity.Enabled.Value,"true")==0);
-                  SchEntry.Period      = JsonActivity.Period.Value;
-                  SchEntry.Offset      = JsonActivity.Offset.Value;
-                  SchEntry.MsgTblIndex = JsonActivity.MsgIdx.Value;
-
-                  if ((RetStatus = SCHTBL_GetEntryIndex("Scheduler table load rejected", SlotIdx, ActivityIdx, &EntryIdx)))
-                  {
-                     TblData.Entry[EntryIdx] = SchEntry;
-                     EntryUdateCnt++;
-                  }
-               }
-               else
+            if (ModeData->Entry[i].Enabled && (ModeData->Entry[i].MsgTblIndex == MsgTblIndex)) return true;
+         }
+         for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+         {
+            if (ModeData->Trigger[i].Enabled && (ModeData->Trigger[i].MsgTblIndex == MsgTblIndex)) return true;
+         }
+         
+      }
+   
+   } /* End mode loop */
+   
+   return false;
+
+} /* End SCHTBL_MsgReferenced() */
+
+
+/******************************************************************************
+** Function: EmptyTrigger
+**
+** Return true if a trigger has never been defined.
+*/
+static bool EmptyTrigger(const SCHTBL_Trigger_t* Trigger)
+{
+
+   return ((Trigger->Enabled == false) && (Trigger->Dispatch == 0) &&
+           (Trigger->MsgTblIndex == 0) && (Trigger->TopicId == 0));
+
+} /* End EmptyTrigger() */
+
+
+/******************************************************************************
+** Function: LoadFile
+**
+** Load a JSON table file or a binary table image into the table data
+** referenced by LoadDataPtr.
+**
+** Notes:
+**  1. A binary image contains every entry so it replaces the table data
+**     rather than updating the entries defined in a JSON file.
+**  2. The working data and JSON text are allocated from the load arena
+**     which is reset for each file.
+**  3. A table image only passes a CRC check when it is read so every entry
+**     and trigger is validated before the image is copied to the table.
+**
+*/
+static bool LoadFile(const char* Filename)
+{
+
+   bool    RetStatus = false;
+   size_t  JsonBufLen;
+   
+   LOADARENA_Reset();
+   TblData    = LOADARENA_Alloc(sizeof(SCHTBL_Data_t));
+   PatchEntry = LOADARENA_Alloc(SCHTBL_MAX_ENTRIES*sizeof(uint16));
+   
+   if ((TblData == NULL) || (PatchEntry == NULL))
+   {
+      
+      CFE_EVS_SendEvent(SCHTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Scheduler table load rejected. Load arena size %d is too small for the working data",
+                        LOADARENA_SIZE);
+   
+   }
+   else if (TBLIMAGE_IsImageFile(Filename) && LoadPatch)
+   {
+      
+      CFE_EVS_SendEvent(SCHTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Scheduler table patch rejected. Table image %s can't be used as a patch", Filename);
+   
+   }
+   else if (TBLIMAGE_IsImageFile(Filename))
+   {
+   
+      if (TBLIMAGE_Read(Filename, TBLIMAGE_SCHTBL_ID, SCHTBL_MAX_ENTRIES,
+                        TblData, sizeof(SCHTBL_Data_t)) &&
+          ValidImage(TblData))
+      {
+         memcpy(LoadDataPtr, TblData, sizeof(SCHTBL_Data_t));
+         SchTbl->LastLoadCnt = SCHTBL_MAX_ENTRIES;
+         if (LoadDataPtr == &SchTbl->Data)
+         {
+            SchTbl->UpdateCnt++;
+            RebuildMsgRefs();
+         }
+         CFE_EVS_SendEvent(SCHTBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Scheduler Table image load updated %d entries and %d triggers", 
+                           SCHTBL_MAX_ENTRIES, SCHTBL_MAX_TRIGGERS);
+         RetStatus = true;
+      }
+   }
+   else
+   {
+   
+      JsonBuf = LOADARENA_AllocTail(SCHTBL_JSON_FILE_MAX_CHAR, &JsonBufLen);
+      if (JsonBuf == NULL)
+      {
+         CFE_EVS_SendEvent(SCHTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Scheduler table load rejected. No load arena space for JSON file %s", Filename);
+      }
+      else
+      {
+         CFE_ES_PerfLogEntry(SchTbl->LoadPerfId);
+         RetStatus = CJSON_ProcessFile(Filename, JsonBuf, JsonBufLen, LoadJsonData);
+         CFE_ES_PerfLogExit(SchTbl->LoadPerfId);
+      }
+   
+   }
+   
+   return RetStatus;
+   
+} /* End LoadFile() */
+
+
+/******************************************************************************
+** Function: ValidImage
+**
+** Validate every entry and trigger in a table image using the same rules as
+** a JSON load.
+**
+** Notes:
+**  1. The boolean fields are read as bytes because an image can contain
+**     values other than 0 and 1.
+*/
+static bool ValidImage(const SCHTBL_Data_t* Data)
+{
+
+   bool   RetStatus = true;
+   uint16 i;
+   char   EventStr[64];
+   const SCHTBL_Entry_t*   Entry;
+   const SCHTBL_Trigger_t* Trigger;
+
+   for (i=0; (i < SCHTBL_MAX_ENTRIES) && RetStatus; i++)
+   {
+      
+      Entry = &Data->Entry[i];
+      snprintf(EventStr, sizeof(EventStr), "Scheduler table image load rejected. Entry %d", i);
+      
+      if (!SCHTBL_ValidEntry(EventStr, *((const uint8*)&Entry->Enabled), Entry->Period,
+                             Entry->Offset, Entry->MsgTblIndex))
+      {
+         RetStatus = false;
+      }
+      else if ((Entry->ShedPriority > SCHTBL_SHED_PRIORITIES) ||
+               !CMDMGR_ValidBoolArg(*((const uint8*)&Entry->Movable)))
+      {
+         RetStatus = false;
+         CFE_EVS_SendEvent(SCHTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "%s. Invalid shed priority %d (max %d) or movable flag %d",
+                           EventStr, Entry->ShedPriority, SCHTBL_SHED_PRIORITIES,
+                           *((const uint8*)&Entry->Movable));
+      }
+   
+   } /* End entry loop */
+
+   for (i=0; (i < SCHTBL_MAX_TRIGGERS) && RetStatus; i++)
+   {
+      
+      Trigger = &Data->Trigger[i];
+      
+      if (!CMDMGR_ValidBoolArg(*((const uint8*)&Trigger->Enabled)) ||
+          ((Trigger->Dispatch != SCHTBL_TRIGGER_NEXT_SLOT) &&
+           (Trigger->Dispatch != SCHTBL_TRIGGER_IMMEDIATE)))
+      {
+         RetStatus = false;
+         CFE_EVS_SendEvent(SCHTBL_TRIGGER_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Scheduler table image load rejected. Trigger %d has invalid enabled %d or dispatch %d",
+                           i, *((const uint8*)&Trigger->Enabled), Trigger->Dispatch);
+      }
+      else if (Trigger->MsgTblIndex >= MSGTBL_MAX_ENTRIES)
+      {
+         RetStatus = false;
+         CFE_EVS_SendEvent(SCHTBL_MSG_TBL_INDEX_ERR_EID, CFE_EVS_EventType_ERROR, 
+                           "Scheduler table image load rejected. Trigger %d has invalid msg index %d. Valid index: 0 <= Index < %d.",
+                           i, Trigger->MsgTblIndex, MSGTBL_MAX_ENTRIES);
+      }
+   
+   } /* End trigger loop */
+
+   return RetStatus;
+
+} /* End ValidImage() */
+
+
+/******************************************************************************
+** Function: LoadJsonData
+**
+** Notes:
+**  1. The JSON file can contain 1 to SCHTBL_MAX_ENTRIES entries. The table can
+**     be sparsely populated.  
+**  2. JSON activity object
+**
+**        "name":  Not saved,
+**        "descr": Not saved,
+**        "index": 12,
+**        "enabled": true,
+**        "period": 4,
+**        "offset": 0,
+**        "msg-idx": 12,
+**        "groups": 3     # Optional group bit mask, defaults to 0
+**        "shed-priority": 1  # Optional load shedding priority, defaults to 0 (never shed)
+**        "movable": "true"   # Optional, defaults to "false". See SCHBALANCER
+**
+**  3. The optional "trigger-array" defines event-triggered activities. See
+**     LoadJsonTriggers().
+**  4. The slot-array and activity-arrays are walked once in file order using
+**     jsonwalk so the load time is linear in the file length. Each entry is
+**     validated when it is read.
+**
+*/
+static bool LoadJsonData(size_t JsonFileLen)
+{
+
+   bool    RetStatus = true;
+   uint16  EntryUdateCnt = 0;
+   uint16  TriggerUpdateCnt = 0;
+   uint16  SlotArrayIdx;
+   uint16  ActivityArrayIdx;
+   int     SlotIdx;
+   int     ActivityIdx;
+
+   JSONWALK_Cursor_t  JsonRoot;
+   JSONWALK_Cursor_t  JsonSlotArray;
+   JSONWALK_Cursor_t  JsonSlotIterator;
+   JSONWALK_Cursor_t  JsonSlotElement;
+   JSONWALK_Cursor_t  JsonSlot;
+   JSONWALK_Cursor_t  JsonActivityArray;
+   JSONWALK_Cursor_t  JsonActivityIterator;
+   JSONWALK_Cursor_t  JsonActivityElement;
+   JSONWALK_Cursor_t  JsonActivity;
+
+
+   SchTbl->JsonFileLen = JsonFileLen;
+   LOADARENA_TrimTail(JsonFileLen + 1);
+
+   /* 
+   ** 1. Copy table owner data into local table buffer
+   ** 2. Process JSON file which updates local table buffer with JSON supplied values
+   ** 3. If valid, copy local buffer over owner's data 
+   */
+   
+   if (LoadPatch)
+   {
+      PatchEntryCnt = 0;
+      PatchTriggers = 0;
+   }
+   else
+   {
+      memcpy(TblData, LoadDataPtr, sizeof(SCHTBL_Data_t));
+   }
+
+   JSONWALK_Init(&JsonRoot, JsonBuf, SchTbl->JsonFileLen);
+   
+   SlotArrayIdx = 0;
+   if (JSONWALK_GetMember(&JsonRoot, "slot-array", &JsonSlotArray) &&
+       JSONWALK_EnterArray(&JsonSlotArray, &JsonSlotIterator))
+   {
+
+      /*
+      ** Use 'slot' and 'activity' index fields to control looping over
+      ** the 'slot-array' and 'activity-array'. If either of these
+      ** are missing or malformed then the array traversal will be
+      ** terminated and a potential error will not be caught.
+      */      
+
+      while (RetStatus && JSONWALK_NextElement(&JsonSlotIterator, &JsonSlotElement))
+      {
+      
+         if (!JSONWALK_GetMember(&JsonSlotElement, "slot", &JsonSlot) ||
+             !JSONWALK_GetInt(&JsonSlot, "index", &SlotIdx))
+         {
+            break;
+         }
+         
+         ActivityArrayIdx = 0;
+         if (JSONWALK_GetMember(&JsonSlot, "activity-array", &JsonActivityArray) &&
+             JSONWALK_EnterArray(&JsonActivityArray, &JsonActivityIterator))
+         {
+            
+            while (RetStatus && JSONWALK_NextElement(&JsonActivityIterator, &JsonActivityElement))
+            {
+               
+               if (!JSONWALK_GetMember(&JsonActivityElement, "activity", &JsonActivity) ||
+                   !JSONWALK_GetInt(&JsonActivity, "index", &ActivityIdx))
                {
-                  RetStatus = false;
-                  CFE_EVS_SendEvent(SCHTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
-                                    "Slot[%d] Activity[%d] has missing attributes, only %d of 4 defined",
-                                    SlotArrayIdx, ActivityArrayIdx, AttributeCnt);
+                  break;
                }
                
+               RetStatus = LoadJsonActivity(&JsonActivity, (uint16)SlotIdx, (uint16)ActivityIdx,
+                                            SlotArrayIdx, ActivityArrayIdx);
+               if (RetStatus)
+               {
+                  EntryUdateCnt++;
+               }
                ActivityArrayIdx++;
-               
-            } /* End if Activity found */
-            else
-            {
-               ReadActivity = false;
-            }
-            if (RetStatus == false)
-            {
-               ReadSlot     = false;
-               ReadActivity = false;
-            }
             
-         } /* End while read activity */
-      
+            } /* End while read activity */
+         }
+         
          SlotArrayIdx++;
       
-      } /* End if Slot found */
-      else
-      {
-         ReadSlot = false;
-      }         
-      
-   } /* End while read slot */
-
+      } /* End while read slot */
+   } /* End if slot-array */
+   
    if (RetStatus == true)
    {
-      memcpy(&SchTbl->Data,&TblData, sizeof(SCHTBL_Data_t));
+      RetStatus = LoadJsonTriggers(&JsonRoot, &TriggerUpdateCnt);
+   }
+   
+   if (RetStatus == true)
+   {
+      if (LoadPatch)
+      {
+         StagePatch();
+      }
+      else
+      {
+         memcpy(LoadDataPtr,TblData, sizeof(SCHTBL_Data_t));
+         if (LoadDataPtr == &SchTbl->Data)
+         {
+            SchTbl->UpdateCnt++;
+            RebuildMsgRefs();
+         }
+      }
       SchTbl->LastLoadCnt = EntryUdateCnt;
       CFE_EVS_SendEvent(SCHTBL_LOAD_EID, CFE_EVS_EventType_INFORMATION,
-                        "Scheduler Table load updated %d entries", EntryUdateCnt);
+                        "Scheduler Table %s %d entries and %d triggers", 
+                        LoadPatch ? "patch staged" : "load updated", EntryUdateCnt, TriggerUpdateCnt);
    }
    
    return RetStatus;
    
 } /* End LoadJsonData() */
+
+
+/******************************************************************************
+** Function: LoadJsonActivity
+**
+** Validate a JSON activity object and copy it to the local table buffer.
+**
+** Notes:
+**  1. Returns false after sending an error event if the activity is invalid.
+**
+*/
+static bool LoadJsonActivity(const JSONWALK_Cursor_t* JsonActivity, uint16 SlotIdx, uint16 ActivityIdx,
+                             uint16 SlotArrayIdx, uint16 ActivityArrayIdx)
+{
+
+   bool    RetStatus = false;
+   uint16  AttributeCnt = 0;
+   uint16  EntryIdx;
+   int     Period, Offset, MsgIdx, Groups, ShedPriority;
+   char    Enabled[JSON_ENABLED_STR_MAX];
+   char    Movable[JSON_ENABLED_STR_MAX];
+   
+   SCHTBL_Entry_t  SchEntry;
+
+   if (JSONWALK_GetStr(JsonActivity, "enabled", Enabled, JSON_ENABLED_STR_MAX)) AttributeCnt++;
+   if (JSONWALK_GetInt(JsonActivity, "period",  &Period)) AttributeCnt++;
+   if (JSONWALK_GetInt(JsonActivity, "offset",  &Offset)) AttributeCnt++;
+   if (JSONWALK_GetInt(JsonActivity, "msg-idx", &MsgIdx)) AttributeCnt++;
+   
+   if (AttributeCnt == 4)
+   {
+      
+      memset((void*)&SchEntry,0,sizeof(SCHTBL_Entry_t));
+      SchEntry.Enabled     = (strcmp(Enabled,"true")==0);
+      SchEntry.Period      = Period;
+      SchEntry.Offset      = Offset;
+      SchEntry.MsgTblIndex = MsgIdx;
+      
+      if (JSONWALK_GetInt(JsonActivity, "groups", &Groups))
+      {
+         SchEntry.Groups = (uint32)Groups;
+      }
+      
+      if (JSONWALK_GetStr(JsonActivity, "movable", Movable, JSON_ENABLED_STR_MAX))
+      {
+         SchEntry.Movable = (strcmp(Movable,"true")==0);
+      }
+
+      ShedPriority = 0;
+      JSONWALK_GetInt(JsonActivity, "shed-priority", &ShedPriority);
+      
+      if ((ShedPriority < 0) || (ShedPriority > SCHTBL_SHED_PRIORITIES))
+      {
+         CFE_EVS_SendEvent(SCHTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Slot[%d] Activity[%d] invalid shed priority %d, must be 0 to %d",
+                           SlotArrayIdx, ActivityArrayIdx, ShedPriority,
+                           SCHTBL_SHED_PRIORITIES);
+      }
+      else if (SCHTBL_GetEntryIndex("Scheduler table load rejected", SlotIdx, ActivityIdx, &EntryIdx) &&
+               SCHTBL_ValidEntry("Scheduler table load rejected", SchEntry.Enabled,
+                                 (uint16)Period, (uint16)Offset, (uint16)MsgIdx))
+      {
+         if (LoadPatch && SchEntry.Enabled && !MSGTBL_EntryDefined(MsgIdx))
+         {
+            CFE_EVS_SendEvent(SCHTBL_MSG_TBL_INDEX_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "Scheduler table patch rejected. Slot[%d] Activity[%d] references undefined message %d",
+                              SlotArrayIdx, ActivityArrayIdx, MsgIdx);
+         }
+         else
+         {
+            SchEntry.ShedPriority  = (uint8)ShedPriority;
+            TblData->Entry[EntryIdx] = SchEntry;
+            if (LoadPatch)
+            {
+               StagePatchEntry(EntryIdx);
+            }
+            RetStatus = true;
+         }
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(SCHTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Slot[%d] Activity[%d] has missing attributes, only %d of 4 defined",
+                        SlotArrayIdx, ActivityArrayIdx, AttributeCnt);
+   }
+   
+   return RetStatus;
+   
+} /* End LoadJsonActivity() */
+
+
+/******************************************************************************
+** Function: LoadJsonTriggers
+**
+** Load the optional "trigger-array" into the local table buffer.
+**
+** Notes:
+**  1. JSON trigger object
+**
+**        "name":     Not saved,
+**        "descr":    Not saved,
+**        "index":    0,
+**        "enabled":  "true",
+**        "topic-id": 6272,
+**        "dispatch": "next-slot",  # "next-slot" or "immediate"
+**        "msg-idx":  40
+**
+**  2. The 'index' field controls looping over the array the same way the
+**     slot and activity 'index' fields do in LoadJsonData().
+*/
+static bool LoadJsonTriggers(const JSONWALK_Cursor_t* JsonRoot, uint16* TriggerUpdateCnt)
+{
+
+   bool    RetStatus = true;
+   uint16  AttributeCnt;
+   uint16  TriggerArrayIdx = 0;
+   int     Index, TopicId, MsgIdx;
+   char    Enabled[JSON_ENABLED_STR_MAX];
+   char    Dispatch[JSON_DISPATCH_STR_MAX];
+   
+   JSONWALK_Cursor_t  JsonTriggerArray;
+   JSONWALK_Cursor_t  JsonTriggerIterator;
+   JSONWALK_Cursor_t  JsonTriggerElement;
+   JSONWALK_Cursor_t  JsonTrigger;
+   SCHTBL_Trigger_t   Trigger;
+   
+   if (!JSONWALK_GetMember(JsonRoot, "trigger-array", &JsonTriggerArray) ||
+       !JSONWALK_EnterArray(&JsonTriggerArray, &JsonTriggerIterator))
+   {
+      return true;
+   }
+   
+   while (RetStatus && JSONWALK_NextElement(&JsonTriggerIterator, &JsonTriggerElement))
+   {
+   
+      if (!JSONWALK_GetMember(&JsonTriggerElement, "trigger", &JsonTrigger) ||
+          !JSONWALK_GetInt(&JsonTrigger, "index", &Index))
+      {
+         break;
+      }
+      
+      AttributeCnt = 0;
+      if (JSONWALK_GetStr(&JsonTrigger, "enabled",  Enabled, JSON_ENABLED_STR_MAX))   AttributeCnt++;
+      if (JSONWALK_GetInt(&JsonTrigger, "topic-id", &TopicId))                        AttributeCnt++;
+      if (JSONWALK_GetStr(&JsonTrigger, "dispatch", Dispatch, JSON_DISPATCH_STR_MAX)) AttributeCnt++;
+      if (JSONWALK_GetInt(&JsonTrigger, "msg-idx",  &MsgIdx))                         AttributeCnt++;
+      
+      if (AttributeCnt == 4)
+      {
+         
+         memset((void*)&Trigger,0,sizeof(SCHTBL_Trigger_t));
+         Trigger.Enabled     = (strcmp(Enabled,"true")==0);
+         Trigger.Dispatch    = (strcmp(Dispatch,"immediate")==0) ? 
+                               SCHTBL_TRIGGER_IMMEDIATE : SCHTBL_TRIGGER_NEXT_SLOT;
+         Trigger.MsgTblIndex = MsgIdx;
+         Trigger.TopicId     = TopicId;
+         
+         if ((Index < 0) || (Index >= SCHTBL_MAX_TRIGGERS))
+         {
+            RetStatus = false;
+            CFE_EVS_SendEvent(SCHTBL_TRIGGER_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Scheduler table load rejected. Invalid trigger index %d greater than max %d",
+                              Index, (SCHTBL_MAX_TRIGGERS-1));
+         }
+         else if (strcmp(Dispatch,"immediate") != 0 &&
+                  strcmp(Dispatch,"next-slot") != 0)
+         {
+            RetStatus = false;
+            CFE_EVS_SendEvent(SCHTBL_TRIGGER_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Scheduler table load rejected. Trigger[%d] has invalid dispatch '%s'. Must be 'next-slot' or 'immediate'",
+                              TriggerArrayIdx, Dispatch);
+         }
+         else if (MsgIdx < 0 || MsgIdx >= MSGTBL_MAX_ENTRIES)
+         {
+            RetStatus = false;
+            CFE_EVS_SendEvent(SCHTBL_MSG_TBL_INDEX_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "Scheduler table load rejected. Trigger[%d] has invalid msg index %d. Valid index: 0 <= Index < %d.",
+                              TriggerArrayIdx, MsgIdx, MSGTBL_MAX_ENTRIES);
+         }
+         else if (LoadPatch && Trigger.Enabled && !MSGTBL_EntryDefined(MsgIdx))
+         {
+            RetStatus = false;
+            CFE_EVS_SendEvent(SCHTBL_MSG_TBL_INDEX_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "Scheduler table patch rejected. Trigger[%d] references undefined message %d",
+                              TriggerArrayIdx, MsgIdx);
+         }
+         else
+         {
+            TblData->Trigger[Index] = Trigger;
+            PatchTriggers |= (1u << Index);
+            (*TriggerUpdateCnt)++;
+         }
+      }
+      else
+      {
+         RetStatus = false;
+         CFE_EVS_SendEvent(SCHTBL_LOAD_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Trigger[%d] has missing attributes, only %d of 4 defined",
+                           TriggerArrayIdx, AttributeCnt);
+      }
+      
+      TriggerArrayIdx++;
+      
+   } /* End while read trigger */
+   
+   return RetStatus;
+   
+} /* End LoadJsonTriggers() */
+
+
+/******************************************************************************
+** Function: StagePatchEntry
+**
+** Add an entry to the patch list. An entry listed more than once in a patch
+** file is only applied and logged once.
+*/
+static void StagePatchEntry(uint16 EntryIdx)
+{
+
+   uint16 i;
+   
+   for (i=0; i < PatchEntryCnt; i++)
+   {
+      if (PatchEntry[i] == EntryIdx) return;
+   }
+   
+   PatchEntry[PatchEntryCnt++] = EntryIdx;
+
+} /* End StagePatchEntry() */
+
+
+/******************************************************************************
+** Function: StagePatch
+**
+** Copy the patched entries and triggers from the load buffer to the staged
+** patch. A staged patch replaces a previously staged patch.
+**
+*/
+static void StagePatch(void)
+{
+
+   uint16 i;
+   
+   for (i=0; i < PatchEntryCnt; i++)
+   {
+      SchTbl->Staged.Entry[PatchEntry[i]] = TblData->Entry[PatchEntry[i]];
+      SchTbl->StagedEntry[i] = PatchEntry[i];
+   }
+   
+   for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+   {
+      if (PatchTriggers & (1u << i))
+      {
+         SchTbl->Staged.Trigger[i] = TblData->Trigger[i];
+      }
+   }
+   
+   SchTbl->StagedEntryCnt = PatchEntryCnt;
+   SchTbl->StagedTriggers = PatchTriggers;
+   SchTbl->PatchStaged    = true;
+   
+   CFE_EVS_SendEvent(SCHTBL_PATCH_EID, CFE_EVS_EventType_INFORMATION,
+                     "Scheduler table patch of %d entries and triggers 0x%08X staged. It is applied when it is activated",
+                     PatchEntryCnt, PatchTriggers);
+
+} /* End StagePatch() */
+
+
+/******************************************************************************
+** Function: ApplyPatch
+**
+** Copy the staged entries and triggers to the active table and record them
+** in the change log.
+**
+** Notes:
+**   1. Only the patched entries are moved in the message reference index.
+**
+*/
+static void ApplyPatch(void)
+{
+
+   uint16 i;
+   
+   SchTbl->PatchCnt++;
+
+   for (i=0; i < SchTbl->StagedEntryCnt; i++)
+   {
+      SchTbl->Data.Entry[SchTbl->StagedEntry[i]] = SchTbl->Staged.Entry[SchTbl->StagedEntry[i]];
+      LogChange(SCHTBL_CHANGE_ENTRY, SchTbl->StagedEntry[i]);
+      IndexEntry(SchTbl->StagedEntry[i]);
+   }
+   
+   for (i=0; i < SCHTBL_MAX_TRIGGERS; i++)
+   {
+      if (SchTbl->StagedTriggers & (1u << i))
+      {
+         SchTbl->Data.Trigger[i] = SchTbl->Staged.Trigger[i];
+         LogChange(SCHTBL_CHANGE_TRIGGER, i);
+      }
+   }
+   
+   CFE_EVS_SendEvent(SCHTBL_PATCH_EID, CFE_EVS_EventType_INFORMATION,
+                     "Scheduler table patch %d changed %d entries and triggers 0x%08X",
+                     SchTbl->PatchCnt, SchTbl->StagedEntryCnt, SchTbl->StagedTriggers);
+
+} /* End ApplyPatch() */
+
+
+/******************************************************************************
+** Function: LogChange
+**
+*/
+static void LogChange(uint8 Type, uint16 Index)
+{
+
+   SCHTBL_Change_t* Change = &SchTbl->ChangeLog[SchTbl->ChangeLogIdx];
+   
+   Change->PatchCnt = SchTbl->PatchCnt;
+   Change->Type     = Type;
+   Change->Index    = Index;
+   Change->Spare    = 0;
+   
+   SchTbl->ChangeLogIdx = (SchTbl->ChangeLogIdx + 1) % SCHTBL_CHANGE_LOG_LEN;
+
+} /* End LogChange() */
+
+
+/******************************************************************************
+** Function: IndexEntry
+**
+** Move an active table entry to the reference list of the message it
+** currently references.
+**
+** Notes:
+**   1. Lists are short so an entry is inserted in order by walking its new
+**      list.
+**
+*/
+static void IndexEntry(uint16 EntryIdx)
+{
+
+   const SCHTBL_Entry_t* Entry = &SchTbl->Data.Entry[EntryIdx];
+   uint16* Link;
+   
+   if (SchTbl->MsgRefIdx[EntryIdx] != SCHTBL_MSG_REF_NONE)
+   {
+      
+      Link = &SchTbl->MsgRefHead[SchTbl->MsgRefIdx[EntryIdx]];
+      while (*Link != EntryIdx)
+      {
+         Link = &SchTbl->MsgRefNext[*Link];
+      }
+      *Link = SchTbl->MsgRefNext[EntryIdx];
+      
+      SchTbl->MsgRefNext[EntryIdx] = SCHTBL_MSG_REF_NONE;
+      SchTbl->MsgRefIdx[EntryIdx]  = SCHTBL_MSG_REF_NONE;
+   
+   }
+   
+   if (!SCHTBL_EmptyEntry(Entry) && (Entry->MsgTblIndex < MSGTBL_MAX_ENTRIES))
+   {
+      
+      /* SCHTBL_MSG_REF_NONE is greater than every entry index */
+      Link = &SchTbl->MsgRefHead[Entry->MsgTblIndex];
+      while (*Link < EntryIdx)
+      {
+         Link = &SchTbl->MsgRefNext[*Link];
+      }
+      SchTbl->MsgRefNext[EntryIdx] = *Link;
+      *Link = EntryIdx;
+      
+      SchTbl->MsgRefIdx[EntryIdx] = Entry->MsgTblIndex;
+   
+   }
+
+} /* End IndexEntry() */
+
+
+/******************************************************************************
+** Function: RebuildMsgRefs
+**
+** Rebuild the message reference index from the active table.
+**
+** Notes:
+**   1. Entries are pushed in descending order so each list is in ascending
+**      order without walking it.
+**
+*/
+static void RebuildMsgRefs(void)
+{
+
+   const SCHTBL_Entry_t* Entry;
+   uint16 i;
+   
+   for (i=0; i < MSGTBL_MAX_ENTRIES; i++)
+   {
+      SchTbl->MsgRefHead[i] = SCHTBL_MSG_REF_NONE;
+   }
+   
+   for (i=SCHTBL_MAX_ENTRIES; i-- > 0; )
+   {
+      
+      Entry = &SchTbl->Data.Entry[i];
+      SchTbl->MsgRefNext[i] = SCHTBL_MSG_REF_NONE;
+      SchTbl->MsgRefIdx[i]  = SCHTBL_MSG_REF_NONE;
+      
+      if (!SCHTBL_EmptyEntry(Entry) && (Entry->MsgTblIndex < MSGTBL_MAX_ENTRIES))
+      {
+         SchTbl->MsgRefNext[i] = SchTbl->MsgRefHead[Entry->MsgTblIndex];
+         SchTbl->MsgRefHead[Entry->MsgTblIndex] = i;
+         SchTbl->MsgRefIdx[i] = Entry->MsgTblIndex;
+      }
+   
+   }
+
+} /* End RebuildMsgRefs() */
@@ -45,8 +45,35 @@
 
 #define SCHTBL_UNDEF_SLOT 9999
 
+#define SCHTBL_MAX_PERIOD 255   /* Period and Offset are stored in uint8 fields */
+
 #define SCHTBL_INDEX(slot_index,entry_index)  ((slot_index*SCHTBL_ACTIVITIES_PER_SLOT) + entry_index)
 
+#if (SCHTBL_MAX_TRIGGERS > 32)
+   #error SCHTBL_MAX_TRIGGERS must be less than or equal to 32
+#endif
+
+/*
+** Event-triggered activity dispatch options
+*/
+
+#define SCHTBL_TRIGGER_NEXT_SLOT  0   /* Send message at the start of the next slot processed */
+#define SCHTBL_TRIGGER_IMMEDIATE  1   /* Send message as soon as the trigger is read */
+
+/*
+** Patch load change log 
+*/
+
+#define SCHTBL_CHANGE_LOG_LEN     16
+#define SCHTBL_CHANGE_ENTRY       0
+#define SCHTBL_CHANGE_TRIGGER     1
+
+/*
+** Message table reference list terminator
+*/
+
+#define SCHTBL_MSG_REF_NONE       0xFFFF
+
 
 /*
 ** Event Message IDs
@@ -62,6 +89,12 @@
 #define SCHTBL_CMD_SLOT_ERR_EID      (SCHTBL_BASE_EID + 7)
 #define SCHTBL_MSG_TBL_INDEX_ERR_EID (SCHTBL_BASE_EID + 8)
 #define SCHTBL_OFFSET_ERR_EID        (SCHTBL_BASE_EID + 9)
+#define SCHTBL_TRIGGER_ERR_EID       (SCHTBL_BASE_EID + 10)
+#define SCHTBL_MODE_EID              (SCHTBL_BASE_EID + 11)
+#define SCHTBL_MODE_ERR_EID          (SCHTBL_BASE_EID + 12)
+#define SCHTBL_PATCH_EID             (SCHTBL_BASE_EID + 13)
+#define SCHTBL_TIMING_EID            (SCHTBL_BASE_EID + 14)
+#define SCHTBL_PATCH_ERR_EID         (SCHTBL_BASE_EID + 15)
 
   
 /**********************/
@@ -73,6 +106,14 @@
 ** Scheduler Table
 **
 ** - Minimized SCHTBL_Entry and made word-aligned for telemetry 
+** - Groups has one bit per group the activity belongs to. An activity is
+**   only performed if none of its groups are disabled. Zero means the
+**   activity doesn't belong to any group.
+** - ShedPriority is 0 for activities that are never shed by the scheduler's
+**   load shedding controller. Sheddable activities use 1 to
+**   SCHTBL_SHED_PRIORITIES and the lowest value is shed first.
+** - Movable activities may have their Offset and slot reassigned by the
+**   offset balancer. It has no effect on how the activity is scheduled.
 */
 
 typedef struct
@@ -82,18 +123,56 @@ typedef struct
    uint8  Period;
    uint8  Offset;
    uint8  MsgTblIndex;
+   uint32 Groups;
+   uint8  ShedPriority;
+   bool   Movable;
+   uint8  Spare[2];
 
 } SCHTBL_Entry_t;
 
+
+/*
+** Event-triggered activity. The message table entry is sent when a message
+** with TopicId is received instead of at a fixed slot/period.
+*/
+
+typedef struct
+{
+
+   bool    Enabled;
+   uint8   Dispatch;      /* SCHTBL_TRIGGER_NEXT_SLOT or SCHTBL_TRIGGER_IMMEDIATE */
+   uint8   MsgTblIndex;
+   uint8   Spare;
+   uint32  TopicId;       /* Trigger message ID */
+
+} SCHTBL_Trigger_t;
+
+
 typedef struct
 {
 
-   SCHTBL_Entry_t Entry[SCHTBL_MAX_ENTRIES];
+   SCHTBL_Entry_t   Entry[SCHTBL_MAX_ENTRIES];
+   SCHTBL_Trigger_t Trigger[SCHTBL_MAX_TRIGGERS];
 
 } SCHTBL_Data_t;
 
 
 
+/*
+** Patch load change log entry
+*/
+
+typedef struct
+{
+
+   uint16  PatchCnt;      /* Patch load that made the change */
+   uint16  Index;         /* Entry or trigger index */
+   uint8   Type;          /* SCHTBL_CHANGE_ENTRY or SCHTBL_CHANGE_TRIGGER */
+   uint8   Spare;
+
+} SCHTBL_Change_t;
+
+
 /*
 ** Local table copy used for table load command
 */
@@ -107,6 +186,16 @@ typedef struct
    
    SCHTBL_Data_t Data; 
    
+   /*
+   ** Resident schedule modes. Data holds the active mode's table and it is
+   ** saved to its Mode entry when another mode is activated so commanded
+   ** changes are retained. 
+   */
+   
+   uint16        ActiveMode;
+   bool          ModeLoaded[SCHTBL_MODES];
+   SCHTBL_Data_t Mode[SCHTBL_MODES];
+   
    /*
    ** Standard CJSON table data
    */
@@ -115,9 +204,39 @@ typedef struct
    bool         Loaded;   /* Has entire table been loaded? */
    uint8        LastLoadStatus;
    uint16       LastLoadCnt;
+   uint32       UpdateCnt;  /* Incremented each time a table load updates Data */
+   uint32       LoadPerfId;
+   uint32       LastLoadUs; /* Time to read the last successful load */
+   uint32       LastDumpUs; /* Time to write the last successful dump */
+   
+   /*
+   ** Patch loads. A patch is validated into the staged patch and it is only
+   ** copied to Data when it is activated. The change log is a circular
+   ** buffer of the most recent entries changed by activated patches.
+   */
+   
+   bool            PatchStaged;
+   uint16          StagedEntryCnt;
+   uint32          StagedTriggers;   /* One bit per trigger */
+   uint16          StagedEntry[SCHTBL_MAX_ENTRIES];
+   SCHTBL_Data_t   Staged;           /* Only the listed entries and triggers are used */
+   
+   uint16          PatchCnt;
+   uint16          ChangeLogIdx;   /* Next change log entry to be written */
+   SCHTBL_Change_t ChangeLog[SCHTBL_CHANGE_LOG_LEN];
+   
+   /*
+   ** Reverse index from message table entries to the active table's entries
+   ** that reference them. Each message has a linked list of entry indices
+   ** in ascending order. MsgRefIdx is the list an entry is linked in so it
+   ** can be moved when the entry is edited. Only defined entries are linked.
+   */
+   
+   uint16  MsgRefHead[MSGTBL_MAX_ENTRIES];
+   uint16  MsgRefNext[SCHTBL_MAX_ENTRIES];
+   uint16  MsgRefIdx[SCHTBL_MAX_ENTRIES];
    
    size_t       JsonObjCnt;
-   char         JsonBuf[MSGTBL_JSON_FILE_MAX_CHAR];   
    size_t       JsonFileLen;
    
 } SCHTBL_Class_t;
@@ -137,9 +256,10 @@ typedef struct
 **   1. This method must be called prior to all other methods. The SchTbl
 **      instance variable only needs to be passed to the constructor
 **      because a reference is stored by schtbl.c.
+**   2. LoadPerfId is the performance log ID that marks JSON file loads.
 **
 */
-void SCHTBL_Constructor(SCHTBL_Class_t* ObjPtr, const char* AppName);
+void SCHTBL_Constructor(SCHTBL_Class_t* ObjPtr, const char* AppName, uint32 LoadPerfId);
 
 
 /******************************************************************************
@@ -187,11 +307,78 @@ int32 SCHTBL_StartTimers(void);
 **  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
 **  2. Can assume valid table file name because this is a callback from 
 **     the app framework table manager.
+**  3. A KIT_SCH_LOAD_TBL_PATCH load only stages the entries listed in the
+**     file and the table isn't changed until SCHTBL_ActivatePatch() is
+**     called. Enabled entries and triggers must also reference a defined
+**     message table entry.
 **
 */
 bool SCHTBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
 
 
+/******************************************************************************
+** Function: SCHTBL_ActivatePatch
+**
+** Copy the staged patch entries and triggers to the active table and record
+** them in the change log.
+**
+** Notes:
+**  1. The message table references are validated again because the message
+**     table may have changed since the patch was staged. The patch remains
+**     staged if it is rejected.
+**  2. Caller must ensure the scheduler isn't processing the table.
+**
+*/
+bool SCHTBL_ActivatePatch(void);
+
+
+/******************************************************************************
+** Function: SCHTBL_DiscardPatch
+**
+** Discard the staged patch without changing the table.
+*/
+bool SCHTBL_DiscardPatch(void);
+
+
+/******************************************************************************
+** Function: SCHTBL_LoadModeFiles
+**
+** Load the resident schedule modes 1 to SCHTBL_MODES-1 from a comma 
+** separated list of JSON scheduler table files.
+**
+** Notes:
+**  1. Intended to be called once during initialization. Each mode starts
+**     from an empty table so the mode's file must define every activity.
+**  2. Mode 0 is loaded by SCHTBL_LoadCmd().
+**
+*/
+void SCHTBL_LoadModeFiles(const char* FileList);
+
+
+/******************************************************************************
+** Function: SCHTBL_ModeLoaded
+**
+** Return true if a mode has been loaded.
+*/
+bool SCHTBL_ModeLoaded(uint16 Mode);
+
+
+/******************************************************************************
+** Function: SCHTBL_ActivateMode
+**
+** Save the active table data to its mode and copy the new mode's table to
+** the active table data.
+**
+** Notes:
+**  1. Caller must ensure the mode is loaded and that the scheduler isn't
+**     processing the table. 
+**  2. A staged patch was validated against the previous mode so it is
+**     discarded.
+**
+*/
+void SCHTBL_ActivateMode(uint16 Mode);
+
+
 /******************************************************************************
 ** Function: SCHTBL_DumpCmd
 **
@@ -206,6 +393,33 @@ bool SCHTBL_LoadCmd(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
 bool SCHTBL_DumpCmd(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename);
 
 
+/******************************************************************************
+** Function: SCHTBL_DumpData
+**
+** Dump a scheduler table image to a JSON file and return the number of
+** entries and triggers written in RecordCnt.
+**
+** Notes:
+**  1. Used by SCHTBL_DumpCmd() and by objects that build table images
+**     outside of the active table so they can be reviewed and loaded.
+**  2. DumpType is a TBLMGR dump type. A compact dump omits unused entries
+**     and triggers.
+**  3. A JSON dump of the active table includes the patch change log. The
+**     loader ignores it.
+**
+*/
+bool SCHTBL_DumpData(const SCHTBL_Data_t* Data, uint8 DumpType, const char* Filename, uint16* RecordCnt);
+
+
+/******************************************************************************
+** Function: SCHTBL_EmptyEntry
+**
+** Return true if an entry has never been defined.
+**
+*/
+bool SCHTBL_EmptyEntry(const SCHTBL_Entry_t* Entry);
+
+
 /******************************************************************************
 ** SCHTBL_GetEntryIndex
 **
@@ -228,5 +442,60 @@ bool SCHTBL_GetEntryIndex(const char* EventStr, uint16 SlotIndex,
 */
 bool SCHTBL_ValidEntry(const char* EventStr, uint16 Enabled, uint16 Period, 
                        uint16 Offset, uint16 MsgTblIndex);
+
+
+/******************************************************************************
+** Function: SCHTBL_EntryChanged
+**
+** Update the message reference index after an active table entry has been
+** changed by a command.
+*/
+void SCHTBL_EntryChanged(uint16 EntryIdx);
+
+
+/******************************************************************************
+** Function: SCHTBL_GetFirstMsgRef
+**
+** Return the index of the first active table entry that references a
+** message table entry or SCHTBL_MSG_REF_NONE if it isn't referenced.
+**
+** Notes:
+**   1. Use SCHTBL_GetNextMsgRef() to get the remaining entries. Entries are
+**      returned in ascending order.
+**
+*/
+uint16 SCHTBL_GetFirstMsgRef(uint16 MsgTblIndex);
+
+
+/******************************************************************************
+** Function: SCHTBL_GetNextMsgRef
+**
+** Return the index of the next active table entry that references the same
+** message table entry as EntryIdx or SCHTBL_MSG_REF_NONE.
+*/
+uint16 SCHTBL_GetNextMsgRef(uint16 EntryIdx);
+
+
+/******************************************************************************
+** Function: SCHTBL_MsgReferenced
+**
+** Return true if an enabled entry or trigger in the active table or in a
+** resident mode sends a message table entry.
+**
+** Notes:
+**   1. Used to prevent a message table load from removing a message that
+**      would be sent now or after a mode switch.
+**
+*/
+bool SCHTBL_MsgReferenced(uint16 MsgTblIndex);
+
+
+/******************************************************************************
+** Function: SCHTBL_TriggerDispatchStr
+**
+** Return the JSON string for a trigger dispatch option.
+*/
+const char* SCHTBL_TriggerDispatchStr(uint8 Dispatch);
+
                           
 #endif /* _schtbl_ */
@@ -0,0 +1,216 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the scheduler timeline trace
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "schtrace.h"
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static uint32 CopyRing(uint8 Source, uint32* TotalCnt);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCHTRACE_Class_t*  SchTrace = NULL;
+
+
+/******************************************************************************
+** Function: SCHTRACE_Constructor
+**
+*/
+void SCHTRACE_Constructor(SCHTRACE_Class_t* ObjPtr)
+{
+
+   SchTrace = ObjPtr;
+
+   CFE_PSP_MemSet((void*)SchTrace, 0, sizeof(SCHTRACE_Class_t));
+
+} /* End SCHTRACE_Constructor() */
+
+
+/******************************************************************************
+** Function: SCHTRACE_Record
+**
+*/
+void SCHTRACE_Record(uint8 Source, uint8 Type, uint16 Slot, uint32 Arg, int32 Status)
+{
+
+   SCHTRACE_Ring_t*   Ring = &SchTrace->Ring[Source];
+   SCHTRACE_Rec_t*    Rec  = &Ring->Rec[Ring->Count & (SCHTRACE_RING_LEN-1)];
+   CFE_TIME_SysTime_t Met  = CFE_TIME_GetMET();
+
+   Rec->Seconds    = Met.Seconds;
+   Rec->Subseconds = Met.Subseconds;
+   Rec->Type       = Type;
+   Rec->Source     = Source;
+   Rec->Slot       = Slot;
+   Rec->Arg        = Arg;
+   Rec->Status     = Status;
+
+   KIT_SCH_MEM_BARRIER();
+   Ring->Count++;
+
+} /* End SCHTRACE_Record() */
+
+
+/******************************************************************************
+** Function: SCHTRACE_DumpCmd
+**
+*/
+bool SCHTRACE_DumpCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const SCHTRACE_DumpCmdMsg_t *DumpCmd = (const SCHTRACE_DumpCmdMsg_t *) MsgPtr;
+   bool       RetStatus = false;
+   int32      OsStatus;
+   osal_id_t  FileHandle;
+   uint8      Source;
+   uint32     RecCnt = 0;
+   int32      DataLen;
+   char       Filename[OS_MAX_PATH_LEN];
+   SCHTRACE_FileHdr_t    FileHdr;
+   SCHTRACE_SourceHdr_t  SourceHdr;
+   os_err_name_t         OsErrStr;
+
+   strncpy(Filename, DumpCmd->Filename, OS_MAX_PATH_LEN);
+   Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+   OsStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+
+   if (OsStatus == OS_SUCCESS)
+   {
+
+      memset(&FileHdr, 0, sizeof(SCHTRACE_FileHdr_t));
+      FileHdr.Magic     = SCHTRACE_FILE_MAGIC;
+      FileHdr.Version   = SCHTRACE_FILE_VERSION;
+      FileHdr.RecLen    = sizeof(SCHTRACE_Rec_t);
+      FileHdr.SourceCnt = SCHTRACE_SOURCES;
+      FileHdr.SlotCnt   = SCHTBL_SLOTS;
+
+      RetStatus = (OS_write(FileHandle, &FileHdr, sizeof(SCHTRACE_FileHdr_t)) == sizeof(SCHTRACE_FileHdr_t));
+
+      for (Source=0; (Source < SCHTRACE_SOURCES) && RetStatus; Source++)
+      {
+
+         memset(&SourceHdr, 0, sizeof(SCHTRACE_SourceHdr_t));
+         SourceHdr.Source = Source;
+         SourceHdr.RecCnt = CopyRing(Source, &SourceHdr.TotalCnt);
+         DataLen = SourceHdr.RecCnt * sizeof(SCHTRACE_Rec_t);
+
+         RetStatus = ((OS_write(FileHandle, &SourceHdr, sizeof(SCHTRACE_SourceHdr_t)) == sizeof(SCHTRACE_SourceHdr_t)) &&
+                      (OS_write(FileHandle, SchTrace->DumpBuf, DataLen) == DataLen));
+         RecCnt += SourceHdr.RecCnt;
+
+      } /* End source loop */
+
+      OS_close(FileHandle);
+
+      if (RetStatus)
+      {
+         SchTrace->DumpCnt++;
+         CFE_EVS_SendEvent(SCHTRACE_DUMP_EID, CFE_EVS_EventType_INFORMATION,
+                           "Dumped %d scheduler trace records to %s", RecCnt, Filename);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(SCHTRACE_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Error writing scheduler trace file %s", Filename);
+      }
+
+   } /* End if file create */
+   else
+   {
+      OS_GetErrorName(OsStatus, &OsErrStr);
+      CFE_EVS_SendEvent(SCHTRACE_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating scheduler trace file %s. Status = %s",
+                        Filename, OsErrStr);
+   }
+
+   return RetStatus;
+
+} /* End SCHTRACE_DumpCmd() */
+
+
+/******************************************************************************
+** Function: CopyRing
+**
+** Copy a ring's records to the dump buffer, oldest first, and return the
+** number of records copied. TotalCnt is set to the number of records that
+** had been written when the copy started.
+**
+** Notes:
+**   1. The callbacks continue to record while their ring is copied. The
+**      writer may be overwriting the oldest record after the final count so
+**      records older than a full ring before that count are discarded.
+**
+*/
+static uint32 CopyRing(uint8 Source, uint32* TotalCnt)
+{
+
+   SCHTRACE_Ring_t* Ring = &SchTrace->Ring[Source];
+   uint32 Start, End, Final, Valid;
+   uint32 i;
+
+   End = Ring->Count;
+   *TotalCnt = End;
+   KIT_SCH_MEM_BARRIER();
+
+   Start = (End > SCHTRACE_RING_LEN) ? (End - SCHTRACE_RING_LEN) : 0;
+   for (i=Start; i < End; i++)
+   {
+      SchTrace->DumpBuf[i-Start] = Ring->Rec[i & (SCHTRACE_RING_LEN-1)];
+   }
+
+   KIT_SCH_MEM_BARRIER();
+   Final = Ring->Count;
+
+   /* First record that can't have been overwritten during the copy */
+   Valid = (Final >= SCHTRACE_RING_LEN) ? (Final - SCHTRACE_RING_LEN + 1) : 0;
+   if (Valid > Start)
+   {
+      if (Valid >= End)
+      {
+         Start = End;
+      }
+      else
+      {
+         memmove(SchTrace->DumpBuf, &SchTrace->DumpBuf[Valid-Start], (End-Valid)*sizeof(SCHTRACE_Rec_t));
+         Start = Valid;
+      }
+   }
+
+   return (End - Start);
+
+} /* End CopyRing() */
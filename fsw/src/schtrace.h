@@ -0,0 +1,223 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the scheduler timeline trace
+**
+**  Notes:
+**    1. Trace records are kept in fixed-size binary rings so the scheduler
+**       timeline leading up to a timing anomaly can be dumped to a file and
+**       reconstructed offline. The oldest records are overwritten.
+**    2. Each record source has its own ring with a single writer: the major
+**       frame callback, the minor frame callback and the scheduler task.
+**       A record is written and then published by incrementing the ring's
+**       count after a memory barrier so appends never block or lock.
+**    3. Records are timestamped with the MET so the rings can be merged into
+**       one timeline. The resolution is the platform's MET subseconds.
+**    4. The dump copies each ring and then discards any records that a
+**       callback may have overwritten while they were being copied.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _schtrace_
+#define _schtrace_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#if ((SCHTRACE_RING_LEN & (SCHTRACE_RING_LEN - 1)) != 0)
+   #error SCHTRACE_RING_LEN must be a power of 2
+#endif
+
+#define SCHTRACE_FILE_MAGIC      0x4B535452   /* 'KSTR' */
+#define SCHTRACE_FILE_VERSION    1
+
+/*
+** Record sources. Each source must only be recorded from one context.
+*/
+
+#define SCHTRACE_SRC_TONE   0   /* Major frame callback */
+#define SCHTRACE_SRC_TIMER  1   /* Minor frame callback */
+#define SCHTRACE_SRC_TASK   2   /* Scheduler task */
+#define SCHTRACE_SOURCES    3
+
+/*
+** Record types. The Slot, Arg and Status fields are defined for each type.
+*/
+
+#define SCHTRACE_TONE        1   /* Slot: Minor frames since tone, Arg: SCHTRACE_TONE_* flags */
+#define SCHTRACE_MINOR_TICK  2   /* Slot: Minor frames since tone, Arg: MET sync state */
+#define SCHTRACE_SEM_TAKE    3   /* Slot: Next slot, Status: OS_BinSemTake() status */
+#define SCHTRACE_CATCH_UP    4   /* Slot: Current slot, Arg: Slots behind, Status: Slots to process */
+#define SCHTRACE_SLOT_START  5   /* Slot: Slot, Arg: Table pass count */
+#define SCHTRACE_SEND        6   /* Slot: Slot, Arg: Message table index, Status: Send status */
+#define SCHTRACE_SLOT_END    7   /* Slot: Slot, Arg: Activities sent */
+
+#define SCHTRACE_TONE_FLYWHEEL    0x01   /* cFE time was flywheeling, tone ignored */
+#define SCHTRACE_TONE_UNEXPECTED  0x02   /* Tone arrived outside the expected slots */
+#define SCHTRACE_TONE_IGNORED     0x04   /* Tone is too noisy to be used */
+
+/*
+** Event Message IDs
+*/
+
+#define SCHTRACE_DUMP_EID      (SCHTRACE_BASE_EID + 0)
+#define SCHTRACE_DUMP_ERR_EID  (SCHTRACE_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Trace Records
+*/
+
+typedef struct
+{
+
+   uint32  Seconds;      /* MET */
+   uint32  Subseconds;   /* MET, 2^-32 seconds */
+   uint8   Type;
+   uint8   Source;
+   uint16  Slot;
+   uint32  Arg;
+   int32   Status;
+
+} SCHTRACE_Rec_t;
+
+
+typedef struct
+{
+
+   volatile uint32  Count;   /* Records written since the ring was created */
+   SCHTRACE_Rec_t   Rec[SCHTRACE_RING_LEN];
+
+} SCHTRACE_Ring_t;
+
+
+/******************************************************************************
+** Dump File
+**
+** A file header followed by each source's header and its records, oldest
+** first.
+*/
+
+typedef struct
+{
+
+   uint32  Magic;
+   uint16  Version;
+   uint16  RecLen;
+   uint16  SourceCnt;
+   uint16  SlotCnt;
+
+} SCHTRACE_FileHdr_t;
+
+
+typedef struct
+{
+
+   uint16  Source;
+   uint16  Spare;
+   uint32  RecCnt;      /* Records that follow */
+   uint32  TotalCnt;    /* Records written, TotalCnt-RecCnt were overwritten */
+
+} SCHTRACE_SourceHdr_t;
+
+
+/******************************************************************************
+** Command Packets
+*/
+
+typedef struct
+{
+
+   CFE_MSG_CommandHeader_t  CmdHeader;
+   char    Filename[OS_MAX_PATH_LEN];
+
+} SCHTRACE_DumpCmdMsg_t;
+#define SCHTRACE_DUMP_CMD_DATA_LEN  (sizeof(SCHTRACE_DumpCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+
+/******************************************************************************
+** Scheduler Trace Class
+*/
+
+typedef struct
+{
+
+   SCHTRACE_Ring_t  Ring[SCHTRACE_SOURCES];
+
+   uint32          DumpCnt;
+   SCHTRACE_Rec_t  DumpBuf[SCHTRACE_RING_LEN];   /* Ring copy being written to a dump file */
+
+} SCHTRACE_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCHTRACE_Constructor
+**
+** Notes:
+**   1. This must be called prior to any other function and before the
+**      frame callbacks are started.
+**
+*/
+void SCHTRACE_Constructor(SCHTRACE_Class_t* ObjPtr);
+
+
+/******************************************************************************
+** Function: SCHTRACE_Record
+**
+** Append a record to a source's ring.
+**
+** Notes:
+**   1. Safe to call from the frame callbacks. A source must only be
+**      recorded from one context.
+**
+*/
+void SCHTRACE_Record(uint8 Source, uint8 Type, uint16 Slot, uint32 Arg, int32 Status);
+
+
+/******************************************************************************
+** Function: SCHTRACE_DumpCmd
+**
+** Write the trace rings to the command's file.
+**
+** Notes:
+**   1. Function signature must match the CMDMGR_CmdFuncPtr_t definition
+**   2. An existing file is overwritten.
+**
+*/
+bool SCHTRACE_DumpCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _schtrace_ */
@@ -0,0 +1,239 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement KIT_SCH's binary table image file functions
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+#include "tblimage.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CRC32_POLYNOMIAL  0xEDB88320   /* Reflected IEEE 802.3 */
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static uint32 CrcTable[256];
+static bool   CrcTableInit = false;
+
+
+/******************************************************************************
+** Function: TBLIMAGE_IsImageFile
+**
+*/
+bool TBLIMAGE_IsImageFile(const char* Filename)
+{
+
+   size_t FilenameLen = strlen(Filename);
+   size_t ExtLen      = strlen(TBLIMAGE_FILE_EXT);
+
+   return ((FilenameLen > ExtLen) &&
+           (strcmp(&Filename[FilenameLen-ExtLen], TBLIMAGE_FILE_EXT) == 0));
+
+} /* End TBLIMAGE_IsImageFile() */
+
+
+/******************************************************************************
+** Function: TBLIMAGE_Read
+**
+*/
+bool TBLIMAGE_Read(const char* Filename, uint16 TblId, uint32 EntryCnt,
+                   void* Data, uint32 DataLen)
+{
+
+   bool       RetStatus = false;
+   int32      OsStatus;
+   int32      ReadLen;
+   osal_id_t  FileHandle;
+   uint32     Crc;
+   TBLIMAGE_Hdr_t Hdr;
+   os_err_name_t  OsErrStr;
+
+   OsStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+
+   if (OsStatus != OS_SUCCESS)
+   {
+      OS_GetErrorName(OsStatus, &OsErrStr);
+      CFE_EVS_SendEvent(TBLIMAGE_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Error opening table image %s. Status = %s",
+                        Filename, OsErrStr);
+      return false;
+   }
+
+   ReadLen = OS_read(FileHandle, &Hdr, sizeof(TBLIMAGE_Hdr_t));
+
+   if (ReadLen != (int32)sizeof(TBLIMAGE_Hdr_t))
+   {
+      CFE_EVS_SendEvent(TBLIMAGE_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Table image %s header read error. Read %d of %d bytes",
+                        Filename, ReadLen, (int)sizeof(TBLIMAGE_Hdr_t));
+   }
+   else if ((Hdr.Magic != TBLIMAGE_MAGIC) || (Hdr.SchemaVersion != TBLIMAGE_SCHEMA_VERSION))
+   {
+      CFE_EVS_SendEvent(TBLIMAGE_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Table image %s has invalid magic 0x%08X or schema version %d. Expected 0x%08X and %d",
+                        Filename, Hdr.Magic, Hdr.SchemaVersion, TBLIMAGE_MAGIC, TBLIMAGE_SCHEMA_VERSION);
+   }
+   else if ((Hdr.TblId != TblId) || (Hdr.EntryCnt != EntryCnt) || (Hdr.DataLen != DataLen))
+   {
+      CFE_EVS_SendEvent(TBLIMAGE_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Table image %s (table,entries,length)=>(%d,%d,%d) doesn't match expected (%d,%d,%d)",
+                        Filename, Hdr.TblId, Hdr.EntryCnt, Hdr.DataLen, TblId, EntryCnt, DataLen);
+   }
+   else
+   {
+
+      ReadLen = OS_read(FileHandle, Data, DataLen);
+
+      if (ReadLen != (int32)DataLen)
+      {
+         CFE_EVS_SendEvent(TBLIMAGE_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Table image %s data read error. Read %d of %d bytes",
+                           Filename, ReadLen, DataLen);
+      }
+      else
+      {
+
+         Crc = TBLIMAGE_Crc32(Data, DataLen);
+         if (Crc == Hdr.Crc)
+         {
+            RetStatus = true;
+         }
+         else
+         {
+            CFE_EVS_SendEvent(TBLIMAGE_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Table image %s CRC 0x%08X doesn't match header CRC 0x%08X",
+                              Filename, Crc, Hdr.Crc);
+         }
+      }
+   } /* End if valid header */
+
+   OS_close(FileHandle);
+
+   return RetStatus;
+
+} /* End TBLIMAGE_Read() */
+
+
+/******************************************************************************
+** Function: TBLIMAGE_Write
+**
+*/
+bool TBLIMAGE_Write(const char* Filename, uint16 TblId, uint32 EntryCnt,
+                    const void* Data, uint32 DataLen)
+{
+
+   bool       RetStatus = false;
+   int32      OsStatus;
+   osal_id_t  FileHandle;
+   TBLIMAGE_Hdr_t Hdr;
+   os_err_name_t  OsErrStr;
+
+   OsStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+
+   if (OsStatus == OS_SUCCESS)
+   {
+
+      memset(&Hdr, 0, sizeof(TBLIMAGE_Hdr_t));
+      Hdr.Magic         = TBLIMAGE_MAGIC;
+      Hdr.SchemaVersion = TBLIMAGE_SCHEMA_VERSION;
+      Hdr.TblId         = TblId;
+      Hdr.EntryCnt      = EntryCnt;
+      Hdr.DataLen       = DataLen;
+      Hdr.Crc           = TBLIMAGE_Crc32(Data, DataLen);
+
+      if ((OS_write(FileHandle, &Hdr, sizeof(TBLIMAGE_Hdr_t)) == (int32)sizeof(TBLIMAGE_Hdr_t)) &&
+          (OS_write(FileHandle, Data, DataLen) == (int32)DataLen))
+      {
+         RetStatus = true;
+         CFE_EVS_SendEvent(TBLIMAGE_WRITE_EID, CFE_EVS_EventType_INFORMATION,
+                           "Wrote table image %s with %d entries, CRC 0x%08X",
+                           Filename, EntryCnt, Hdr.Crc);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(TBLIMAGE_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Error writing table image %s", Filename);
+      }
+
+      OS_close(FileHandle);
+
+   } /* End if file create */
+   else
+   {
+      OS_GetErrorName(OsStatus, &OsErrStr);
+      CFE_EVS_SendEvent(TBLIMAGE_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating table image %s. Status = %s",
+                        Filename, OsErrStr);
+   }
+
+   return RetStatus;
+
+} /* End TBLIMAGE_Write() */
+
+
+/******************************************************************************
+** Function: TBLIMAGE_Crc32
+**
+** Notes:
+**   1. The lookup table is built on the first call.
+*/
+uint32 TBLIMAGE_Crc32(const void* Data, uint32 DataLen)
+{
+
+   const uint8* Byte = (const uint8*)Data;
+   uint32 Crc = 0xFFFFFFFF;
+   uint32 i, b;
+
+   if (!CrcTableInit)
+   {
+      for (i=0; i < 256; i++)
+      {
+         Crc = i;
+         for (b=0; b < 8; b++)
+         {
+            Crc = (Crc & 1) ? ((Crc >> 1) ^ CRC32_POLYNOMIAL) : (Crc >> 1);
+         }
+         CrcTable[i] = Crc;
+      }
+      CrcTableInit = true;
+      Crc = 0xFFFFFFFF;
+   }
+
+   for (i=0; i < DataLen; i++)
+   {
+      Crc = CrcTable[(Crc ^ Byte[i]) & 0xFF] ^ (Crc >> 8);
+   }
+
+   return (Crc ^ 0xFFFFFFFF);
+
+} /* End TBLIMAGE_Crc32() */
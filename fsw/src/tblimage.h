@@ -0,0 +1,140 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define KIT_SCH's binary table image file format
+**
+**  Notes:
+**    1. A table image is a header followed by a table's data structure
+**       exactly as it is stored in memory so a load is a validation and a
+**       copy. Images are created by dumping a table to a filename with the
+**       TBLIMAGE_FILE_EXT extension.
+**    2. Images are specific to a platform's configuration and byte order.
+**       The header's data length and entry count reject images created
+**       with different table sizes.
+**    3. The table load and dump functions select the binary format based
+**       on the filename extension so the JSON ini file's load filenames
+**       determine the boot-time format.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _tblimage_
+#define _tblimage_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TBLIMAGE_FILE_EXT        ".bin"
+
+#define TBLIMAGE_MAGIC           0x4B534954   /* 'KSIT' */
+#define TBLIMAGE_SCHEMA_VERSION  1
+
+#define TBLIMAGE_MSGTBL_ID       1
+#define TBLIMAGE_SCHTBL_ID       2
+
+/*
+** Event Message IDs
+*/
+
+#define TBLIMAGE_READ_ERR_EID    (TBLIMAGE_BASE_EID + 0)
+#define TBLIMAGE_WRITE_EID       (TBLIMAGE_BASE_EID + 1)
+#define TBLIMAGE_WRITE_ERR_EID   (TBLIMAGE_BASE_EID + 2)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Image file header
+*/
+
+typedef struct
+{
+
+   uint32  Magic;
+   uint16  SchemaVersion;
+   uint16  TblId;
+   uint32  EntryCnt;
+   uint32  DataLen;      /* Bytes following the header */
+   uint32  Crc;          /* CRC-32 of the data bytes */
+
+} TBLIMAGE_Hdr_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TBLIMAGE_IsImageFile
+**
+** Return true if a filename has the binary table image extension.
+**
+*/
+bool TBLIMAGE_IsImageFile(const char* Filename);
+
+
+/******************************************************************************
+** Function: TBLIMAGE_Read
+**
+** Read and validate a table image into a caller's working buffer.
+**
+** Notes:
+**   1. The header must match the expected table ID, entry count and data
+**      length and the data's CRC must match the header. An event is sent
+**      for each error.
+**   2. Data is only valid if true is returned.
+**
+*/
+bool TBLIMAGE_Read(const char* Filename, uint16 TblId, uint32 EntryCnt,
+                   void* Data, uint32 DataLen);
+
+
+/******************************************************************************
+** Function: TBLIMAGE_Write
+**
+** Write a table image file.
+**
+*/
+bool TBLIMAGE_Write(const char* Filename, uint16 TblId, uint32 EntryCnt,
+                    const void* Data, uint32 DataLen);
+
+
+/******************************************************************************
+** Function: TBLIMAGE_Crc32
+**
+** Compute the standard CRC-32 (IEEE 802.3) of a buffer.
+**
+** Notes:
+**   1. cFE's CFE_ES_CalculateCRC() only supports a 16-bit CRC.
+**
+*/
+uint32 TBLIMAGE_Crc32(const void* Data, uint32 DataLen);
+
+
+#endif /* _tblimage_ */
@@ -0,0 +1,303 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the host time per slot of the scheduler's dispatch path
+**
+**  Notes:
+**    1. Usage: bench_dispatch [slots] [ini file]
+**    2. For each period mix and table density synthetic tables are loaded
+**       and two paths are timed with CLOCK_MONOTONIC:
+**         - ProcessNextSlot() called back to back
+**         - SCHEDULER_Execute() woken by the virtual platform's minor frame
+**           timer and tone, which includes the frame callbacks, catch-up
+**           logic and statistics publication around each slot.
+**       Each is run three times and the fastest is reported. Results are
+**       CSV on stdout.
+**    3. scheduler.c is included so ProcessNextSlot() can be called. The
+**       target is linked without scheduler.c's object.
+**    4. Message sends are counted by the host SB and cost nothing, so the
+**       results are the scheduler's own overhead.
+**    5. error_events counts the error events since the tables were loaded.
+**       At the highest density the table analyzer reports slots that exceed
+**       the message budget, which is expected.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <time.h>
+#include "scheduler.c"
+#include "hostcfe.h"
+#include "virtplat.h"
+#include "tblgen.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_DEF_SLOTS   20000
+#define BENCH_RUNS        3
+#define BENCH_MSG_CNT     SCHTBL_MAX_ENTRIES
+
+#define BENCH_MSG_TBL_FILE  "bench_dispatch_msgtbl.json"
+#define BENCH_SCH_TBL_FILE  "bench_dispatch_schtbl.json"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   const char*  Name;
+   uint8        Period[4];
+   uint16       PeriodCnt;
+
+} PeriodMix_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static bool   LoadTables(const INITBL_Class_t* IniTbl, const PeriodMix_t* Mix, uint16 EntriesPerSlot);
+static uint64 NowNs(void);
+static uint64 TimeProcessNextSlot(uint32 Slots, uint32* Sends);
+static uint64 TimeExecute(uint32 Slots, uint32* SlotsRun);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static SCHEDULER_Class_t  SchedulerObj;
+
+static const PeriodMix_t PeriodMix[] =
+{
+   { "every-pass", {1},             1 },
+   { "harmonic",   {1, 2, 4, 8},    4 },
+   { "coprime",    {3, 5, 7, 11},   4 },
+   { "sparse",     {16, 32, 64, 128}, 4 }
+};
+
+static const uint16 Density[] = { 1, 4, 8, SCHTBL_ACTIVITIES_PER_SLOT };
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char* argv[])
+{
+
+   INITBL_Class_t  IniTbl;
+   uint32  Slots = BENCH_DEF_SLOTS;
+   uint32  Sends, SlotsRun;
+   uint64  ProcessNs, ExecuteNs;
+   uint16  Mix, Dens;
+   const char* IniFile = KIT_SCH_HOST_INI_FILE;
+
+   if (argc > 1)
+   {
+      Slots = (uint32)strtoul(argv[1], NULL, 0);
+   }
+   if (argc > 2)
+   {
+      IniFile = argv[2];
+   }
+
+   if ((Slots == 0) || !INITBL_Constructor(&IniTbl, IniFile))
+   {
+      printf("Usage: bench_dispatch [slots] [ini file]\n");
+      return 1;
+   }
+
+   printf("# KIT_SCH dispatch benchmark: %u slots per run, best of %d runs, %d slots x %d activities\n",
+          Slots, BENCH_RUNS, SCHTBL_SLOTS, SCHTBL_ACTIVITIES_PER_SLOT);
+   printf("period_mix,entries_per_slot,sends_per_slot,process_next_slot_ns,execute_ns_per_slot,error_events\n");
+
+   for (Mix=0; Mix < sizeof(PeriodMix)/sizeof(PeriodMix_t); Mix++)
+   {
+      for (Dens=0; Dens < sizeof(Density)/sizeof(uint16); Dens++)
+      {
+
+         if (LoadTables(&IniTbl, &PeriodMix[Mix], Density[Dens]))
+         {
+
+            ProcessNs = TimeProcessNextSlot(Slots, &Sends);
+            ExecuteNs = TimeExecute(Slots, &SlotsRun);
+
+            printf("%s,%u,%.2f,%.1f,%.1f,%u\n", PeriodMix[Mix].Name, Density[Dens],
+                   (double)Sends / Slots, (double)ProcessNs / Slots,
+                   (SlotsRun > 0) ? ((double)ExecuteNs / SlotsRun) : 0.0,
+                   HOSTCFE_GetStats()->EventCnt[CFE_EVS_EventType_ERROR]);
+         }
+         else
+         {
+            printf("%s,%u,load failed,,,%u\n", PeriodMix[Mix].Name, Density[Dens],
+                   HOSTCFE_GetStats()->EventCnt[CFE_EVS_EventType_ERROR]);
+         }
+
+      } /* End density loop */
+   } /* End period mix loop */
+
+   remove(BENCH_MSG_TBL_FILE);
+   remove(BENCH_SCH_TBL_FILE);
+
+   return 0;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: LoadTables
+**
+** Construct a new scheduler on a new virtual platform and load synthetic
+** tables.
+*/
+static bool LoadTables(const INITBL_Class_t* IniTbl, const PeriodMix_t* Mix, uint16 EntriesPerSlot)
+{
+
+   VIRTPLAT_Config_t  PlatConfig;
+   TBLGEN_SchTbl_t    SchTblDef;
+
+   HOSTCFE_Reset();
+   HOSTCFE_SetEventLevel(HOSTCFE_EVENT_TYPES);
+   VIRTPLAT_DefaultConfig(&PlatConfig);
+   VIRTPLAT_Reset(&PlatConfig);
+
+   SCHEDULER_Constructor(&SchedulerObj, IniTbl);
+
+   SchTblDef.EntryCnt  = EntriesPerSlot * SCHTBL_SLOTS;
+   SchTblDef.Period    = Mix->Period;
+   SchTblDef.PeriodCnt = Mix->PeriodCnt;
+   SchTblDef.MsgCnt    = BENCH_MSG_CNT;
+
+   return ((TBLGEN_WriteMsgTbl(BENCH_MSG_TBL_FILE, BENCH_MSG_CNT, 0) > 0) &&
+           (TBLGEN_WriteSchTbl(BENCH_SCH_TBL_FILE, &SchTblDef) > 0) &&
+           MSGTBL_LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, BENCH_MSG_TBL_FILE) &&
+           SCHTBL_LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, BENCH_SCH_TBL_FILE));
+
+} /* End LoadTables() */
+
+
+/******************************************************************************
+** Function: NowNs
+**
+*/
+static uint64 NowNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000000 + Now.tv_nsec;
+
+} /* End NowNs() */
+
+
+/******************************************************************************
+** Function: TimeProcessNextSlot
+**
+** Return the fastest run's time and the number of messages it sent.
+*/
+static uint64 TimeProcessNextSlot(uint32 Slots, uint32* Sends)
+{
+
+   uint64 BestNs = UINT64_MAX;
+   uint64 StartNs, RunNs;
+   uint32 StartSends;
+   uint32 Run, Slot;
+
+   *Sends = 0;
+   for (Run=0; Run < BENCH_RUNS; Run++)
+   {
+
+      StartSends = HOSTCFE_GetStats()->CmdMsgCnt;
+      StartNs    = NowNs();
+
+      for (Slot=0; Slot < Slots; Slot++)
+      {
+         ProcessNextSlot();
+      }
+
+      RunNs = NowNs() - StartNs;
+      if (RunNs < BestNs)
+      {
+         BestNs = RunNs;
+         *Sends = HOSTCFE_GetStats()->CmdMsgCnt - StartSends;
+      }
+   }
+
+   return BestNs;
+
+} /* End TimeProcessNextSlot() */
+
+
+/******************************************************************************
+** Function: TimeExecute
+**
+** Return the fastest run's time and the number of slots it processed.
+**
+** Notes:
+**   1. The timers are started and the scheduler is run for a few major
+**      frames before timing so it's synchronized to the tone.
+*/
+static uint64 TimeExecute(uint32 Slots, uint32* SlotsRun)
+{
+
+   uint64 BestNs = UINT64_MAX;
+   uint64 StartNs, RunNs;
+   uint32 StartSlots;
+   uint32 Run, Wakeup;
+
+   *SlotsRun = 0;
+   SCHEDULER_StartTimers();
+   for (Wakeup=0; Wakeup < 4*SCHTBL_SLOTS; Wakeup++)
+   {
+      SCHEDULER_Execute();
+   }
+
+   for (Run=0; Run < BENCH_RUNS; Run++)
+   {
+
+      StartSlots = SchedulerObj.SlotsProcessedCount;
+      StartNs    = NowNs();
+
+      for (Wakeup=0; Wakeup < Slots; Wakeup++)
+      {
+         SCHEDULER_Execute();
+      }
+
+      RunNs = NowNs() - StartNs;
+      if (RunNs < BestNs)
+      {
+         BestNs    = RunNs;
+         *SlotsRun = SchedulerObj.SlotsProcessedCount - StartSlots;
+      }
+   }
+
+   return BestNs;
+
+} /* End TimeExecute() */
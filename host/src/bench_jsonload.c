@@ -0,0 +1,505 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Compare the message table's former per-object CJSON queries with the
+**    single jsonwalk pass
+**
+**  Notes:
+**    1. Usage: bench_jsonload [reps] [ini file]
+**    2. For each table size a synthetic message table is parsed two ways
+**       from the same buffer and the parsed fields are compared:
+**         - cjson: the former LoadJsonData() loop. Each message's query
+**           strings are built with ConstructJsonMessage()'s formats and
+**           each field query resolves its whole path from the top of the
+**           buffer, which is the cost of a CJSON_LoadObj() search.
+**         - jsonwalk: the current LoadJsonData() walk.
+**       Only the parsing is timed. msgtbl_load_us is the current
+**       MSGTBL_LoadCmd() end to end, including the file read.
+**    3. Each measurement is the fastest of BENCH_RUNS runs of reps parses.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <time.h>
+#include "scheduler.h"
+#include "jsonwalk.h"
+#include "hostcfe.h"
+#include "virtplat.h"
+#include "tblgen.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_DEF_REPS  20
+#define BENCH_RUNS      3
+#define BENCH_DATA_STR_MAX  (MSGTBL_MAX_MSG_WORDS*7)   /* msgtbl.c's JSON_DATA_WORD_STR_MAX */
+
+#define BENCH_MSG_TBL_FILE  "bench_jsonload_msgtbl.json"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   int   Id;
+   int   TopicId;
+   int   SeqSeg;
+   int   Length;
+   char  DataWords[BENCH_DATA_STR_MAX];
+
+} BenchMsg_t;
+
+typedef uint16 (*ParseFunc_t)(const char* Buf, size_t BufLen, BenchMsg_t* Msg);
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static uint16 ParseCjson(const char* Buf, size_t BufLen, BenchMsg_t* Msg);
+static uint16 ParseJsonWalk(const char* Buf, size_t BufLen, BenchMsg_t* Msg);
+static bool   QueryObj(const char* Buf, size_t BufLen, const char* Query, JSONWALK_Cursor_t* Value);
+static bool   QueryInt(const char* Buf, size_t BufLen, const char* Query, int* Value);
+static bool   QueryStr(const char* Buf, size_t BufLen, const char* Query, char* Str, size_t MaxLen);
+static uint64 TimeParse(ParseFunc_t Parse, uint32 Reps, const char* Buf, size_t BufLen, BenchMsg_t* Msg);
+static uint64 TimeMsgTblLoad(uint32 Reps);
+static size_t ReadFile(const char* Filename, char* Buf, size_t MaxLen);
+static uint64 NowNs(void);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static SCHEDULER_Class_t  SchedulerObj;
+
+static char        JsonBuf[MSGTBL_JSON_FILE_MAX_CHAR];
+static BenchMsg_t  CjsonMsg[MSGTBL_MAX_ENTRIES];
+static BenchMsg_t  JsonWalkMsg[MSGTBL_MAX_ENTRIES];
+
+static const uint16 TblSize[] = { 10, 25, 50, 100, 150, MSGTBL_MAX_ENTRIES };
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char* argv[])
+{
+
+   INITBL_Class_t     IniTbl;
+   VIRTPLAT_Config_t  PlatConfig;
+   uint32  Reps = BENCH_DEF_REPS;
+   uint16  Size, CjsonCnt, JsonWalkCnt;
+   size_t  FileLen;
+   uint64  CjsonNs, JsonWalkNs, LoadNs;
+   const char* IniFile = KIT_SCH_HOST_INI_FILE;
+
+   if (argc > 1)
+   {
+      Reps = (uint32)strtoul(argv[1], NULL, 0);
+   }
+   if (argc > 2)
+   {
+      IniFile = argv[2];
+   }
+
+   if ((Reps == 0) || !INITBL_Constructor(&IniTbl, IniFile))
+   {
+      printf("Usage: bench_jsonload [reps] [ini file]\n");
+      return 1;
+   }
+
+   HOSTCFE_SetEventLevel(HOSTCFE_EVENT_TYPES);
+   VIRTPLAT_DefaultConfig(&PlatConfig);
+   VIRTPLAT_Reset(&PlatConfig);
+   SCHEDULER_Constructor(&SchedulerObj, &IniTbl);
+
+   printf("# KIT_SCH message table JSON parse benchmark: %u parses per run, best of %d runs\n", Reps, BENCH_RUNS);
+   printf("entries,file_bytes,cjson_us,jsonwalk_us,speedup,results_match,msgtbl_load_us,error_events\n");
+
+   for (Size=0; Size < sizeof(TblSize)/sizeof(uint16); Size++)
+   {
+
+      FileLen = 0;
+      if (TBLGEN_WriteMsgTbl(BENCH_MSG_TBL_FILE, TblSize[Size], 0) > 0)
+      {
+         FileLen = ReadFile(BENCH_MSG_TBL_FILE, JsonBuf, sizeof(JsonBuf));
+      }
+
+      if (FileLen > 0)
+      {
+
+         memset(CjsonMsg, 0, sizeof(CjsonMsg));
+         memset(JsonWalkMsg, 0, sizeof(JsonWalkMsg));
+
+         CjsonNs    = TimeParse(ParseCjson, Reps, JsonBuf, FileLen, CjsonMsg);
+         JsonWalkNs = TimeParse(ParseJsonWalk, Reps, JsonBuf, FileLen, JsonWalkMsg);
+         CjsonCnt    = ParseCjson(JsonBuf, FileLen, CjsonMsg);
+         JsonWalkCnt = ParseJsonWalk(JsonBuf, FileLen, JsonWalkMsg);
+         LoadNs      = TimeMsgTblLoad(Reps);
+
+         printf("%u,%lu,%.2f,%.2f,%.1f,%s,%.2f,%u\n", TblSize[Size], (unsigned long)FileLen,
+                (double)CjsonNs / (1000.0*Reps), (double)JsonWalkNs / (1000.0*Reps),
+                (JsonWalkNs > 0) ? ((double)CjsonNs / JsonWalkNs) : 0.0,
+                CMDMGR_BoolStr((CjsonCnt == TblSize[Size]) && (JsonWalkCnt == CjsonCnt) &&
+                               (memcmp(CjsonMsg, JsonWalkMsg, sizeof(CjsonMsg)) == 0)),
+                (double)LoadNs / (1000.0*Reps),
+                HOSTCFE_GetStats()->EventCnt[CFE_EVS_EventType_ERROR]);
+      }
+      else
+      {
+         printf("%u,table file failed\n", TblSize[Size]);
+      }
+
+   } /* End table size loop */
+
+   remove(BENCH_MSG_TBL_FILE);
+
+   return 0;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: ParseCjson
+**
+** Parse the message-array like the former LoadJsonData() and return the
+** number of messages.
+**
+** Notes:
+**   1. An 'id' that isn't found ends the array. The other fields are
+**      queried whether or not they're needed so every message has the
+**      former loader's five queries.
+*/
+static uint16 ParseCjson(const char* Buf, size_t BufLen, BenchMsg_t* Msg)
+{
+
+   char    Query[5][64];
+   uint16  MsgArrayIdx = 0;
+   bool    ReadMsg = true;
+   BenchMsg_t* MsgPtr;
+
+   while (ReadMsg && (MsgArrayIdx < MSGTBL_MAX_ENTRIES))
+   {
+
+      sprintf(Query[0], "message-array[%d].message.id", MsgArrayIdx);
+      sprintf(Query[1], "message-array[%d].message.topic-id", MsgArrayIdx);
+      sprintf(Query[2], "message-array[%d].message.seq-seg", MsgArrayIdx);
+      sprintf(Query[3], "message-array[%d].message.length", MsgArrayIdx);
+      sprintf(Query[4], "message-array[%d].message.data-words", MsgArrayIdx);
+
+      MsgPtr = &Msg[MsgArrayIdx];
+      if (QueryInt(Buf, BufLen, Query[0], &MsgPtr->Id))
+      {
+         QueryInt(Buf, BufLen, Query[1], &MsgPtr->TopicId);
+         QueryInt(Buf, BufLen, Query[2], &MsgPtr->SeqSeg);
+         QueryInt(Buf, BufLen, Query[3], &MsgPtr->Length);
+         QueryStr(Buf, BufLen, Query[4], MsgPtr->DataWords, BENCH_DATA_STR_MAX);
+         MsgArrayIdx++;
+      }
+      else
+      {
+         ReadMsg = false;
+      }
+
+   } /* End ReadMsg */
+
+   return MsgArrayIdx;
+
+} /* End ParseCjson() */
+
+
+/******************************************************************************
+** Function: ParseJsonWalk
+**
+** Parse the message-array like the current LoadJsonData() and return the
+** number of messages.
+*/
+static uint16 ParseJsonWalk(const char* Buf, size_t BufLen, BenchMsg_t* Msg)
+{
+
+   uint16  MsgArrayIdx = 0;
+   bool    ReadMsg = true;
+   BenchMsg_t* MsgPtr;
+
+   JSONWALK_Cursor_t  JsonRoot;
+   JSONWALK_Cursor_t  JsonMsgArray;
+   JSONWALK_Cursor_t  JsonMsgIterator;
+   JSONWALK_Cursor_t  JsonMsgElement;
+   JSONWALK_Cursor_t  JsonMessage;
+
+   JSONWALK_Init(&JsonRoot, Buf, BufLen);
+   if (!JSONWALK_GetMember(&JsonRoot, "message-array", &JsonMsgArray) ||
+       !JSONWALK_EnterArray(&JsonMsgArray, &JsonMsgIterator))
+   {
+      ReadMsg = false;
+   }
+
+   while (ReadMsg && (MsgArrayIdx < MSGTBL_MAX_ENTRIES) &&
+          JSONWALK_NextElement(&JsonMsgIterator, &JsonMsgElement))
+   {
+
+      MsgPtr = &Msg[MsgArrayIdx];
+      if (JSONWALK_GetMember(&JsonMsgElement, "message", &JsonMessage) &&
+          JSONWALK_GetInt(&JsonMessage, "id", &MsgPtr->Id))
+      {
+         JSONWALK_GetInt(&JsonMessage, "topic-id", &MsgPtr->TopicId);
+         JSONWALK_GetInt(&JsonMessage, "seq-seg",  &MsgPtr->SeqSeg);
+         JSONWALK_GetInt(&JsonMessage, "length",   &MsgPtr->Length);
+         JSONWALK_GetStr(&JsonMessage, "data-words", MsgPtr->DataWords, BENCH_DATA_STR_MAX);
+         MsgArrayIdx++;
+      }
+      else
+      {
+         ReadMsg = false;
+      }
+
+   } /* End ReadMsg */
+
+   return MsgArrayIdx;
+
+} /* End ParseJsonWalk() */
+
+
+/******************************************************************************
+** Function: QueryObj
+**
+** Resolve a CJSON query path such as "message-array[3].message" from the
+** top-level value.
+**
+** Notes:
+**   1. Array elements are found by skipping the elements before them so,
+**      like a CJSON_LoadObj() search, the cost grows with the object's
+**      position in the buffer.
+*/
+static bool QueryObj(const char* Buf, size_t BufLen, const char* Query, JSONWALK_Cursor_t* Value)
+{
+
+   bool    Found = true;
+   char    Name[64];
+   size_t  NameLen;
+   uint32  ArrayIdx, i;
+   char*   IdxEnd;
+   JSONWALK_Cursor_t  Object;
+   JSONWALK_Cursor_t  Iterator;
+
+   JSONWALK_Init(Value, Buf, BufLen);
+
+   while (Found && (*Query != '\0'))
+   {
+
+      NameLen = strcspn(Query, ".[");
+      if (NameLen < sizeof(Name))
+      {
+         memcpy(Name, Query, NameLen);
+         Name[NameLen] = '\0';
+         Query += NameLen;
+         Object = *Value;
+         Found  = JSONWALK_GetMember(&Object, Name, Value);
+      }
+      else
+      {
+         Found = false;
+      }
+
+      if (Found && (*Query == '['))
+      {
+         ArrayIdx = (uint32)strtoul(Query + 1, &IdxEnd, 10);
+         Query    = (*IdxEnd == ']') ? (IdxEnd + 1) : IdxEnd;
+         Found    = JSONWALK_EnterArray(Value, &Iterator);
+         for (i=0; Found && (i <= ArrayIdx); i++)
+         {
+            Found = JSONWALK_NextElement(&Iterator, Value);
+         }
+      }
+
+      if (*Query == '.')
+      {
+         Query++;
+      }
+
+   } /* End while path tokens */
+
+   return Found;
+
+} /* End QueryObj() */
+
+
+/******************************************************************************
+** Function: QueryInt
+**
+*/
+static bool QueryInt(const char* Buf, size_t BufLen, const char* Query, int* Value)
+{
+
+   bool   Found = false;
+   char   Str[16];
+
+   if (QueryStr(Buf, BufLen, Query, Str, sizeof(Str)))
+   {
+      *Value = atoi(Str);
+      Found  = true;
+   }
+
+   return Found;
+
+} /* End QueryInt() */
+
+
+/******************************************************************************
+** Function: QueryStr
+**
+** Resolve the query's parent object and copy the last member's value.
+*/
+static bool QueryStr(const char* Buf, size_t BufLen, const char* Query, char* Str, size_t MaxLen)
+{
+
+   bool   Found = false;
+   char   ParentQuery[64];
+   const char* Key = strrchr(Query, '.');
+   JSONWALK_Cursor_t  Parent;
+
+   if ((Key != NULL) && ((size_t)(Key - Query) < sizeof(ParentQuery)))
+   {
+      memcpy(ParentQuery, Query, Key - Query);
+      ParentQuery[Key - Query] = '\0';
+      Found = QueryObj(Buf, BufLen, ParentQuery, &Parent) &&
+              JSONWALK_GetStr(&Parent, Key + 1, Str, MaxLen);
+   }
+
+   return Found;
+
+} /* End QueryStr() */
+
+
+/******************************************************************************
+** Function: TimeParse
+**
+** Return the fastest run's time for Reps parses.
+*/
+static uint64 TimeParse(ParseFunc_t Parse, uint32 Reps, const char* Buf, size_t BufLen, BenchMsg_t* Msg)
+{
+
+   uint64 BestNs = UINT64_MAX;
+   uint64 StartNs, RunNs;
+   uint32 Run, Rep;
+
+   for (Run=0; Run < BENCH_RUNS; Run++)
+   {
+
+      StartNs = NowNs();
+      for (Rep=0; Rep < Reps; Rep++)
+      {
+         Parse(Buf, BufLen, Msg);
+      }
+
+      RunNs = NowNs() - StartNs;
+      if (RunNs < BestNs)
+      {
+         BestNs = RunNs;
+      }
+   }
+
+   return BestNs;
+
+} /* End TimeParse() */
+
+
+/******************************************************************************
+** Function: TimeMsgTblLoad
+**
+** Return the fastest run's time for Reps message table loads.
+*/
+static uint64 TimeMsgTblLoad(uint32 Reps)
+{
+
+   uint64 BestNs = UINT64_MAX;
+   uint64 StartNs, RunNs;
+   uint32 Run, Rep;
+
+   for (Run=0; Run < BENCH_RUNS; Run++)
+   {
+
+      StartNs = NowNs();
+      for (Rep=0; Rep < Reps; Rep++)
+      {
+         MSGTBL_LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, BENCH_MSG_TBL_FILE);
+      }
+
+      RunNs = NowNs() - StartNs;
+      if (RunNs < BestNs)
+      {
+         BestNs = RunNs;
+      }
+   }
+
+   return BestNs;
+
+} /* End TimeMsgTblLoad() */
+
+
+/******************************************************************************
+** Function: ReadFile
+**
+** Return the file length or 0 if it can't be read or doesn't fit in Buf.
+*/
+static size_t ReadFile(const char* Filename, char* Buf, size_t MaxLen)
+{
+
+   size_t FileLen = 0;
+   FILE*  JsonFile = fopen(Filename, "r");
+
+   if (JsonFile != NULL)
+   {
+      FileLen = fread(Buf, 1, MaxLen, JsonFile);
+      if (FileLen >= MaxLen)
+      {
+         FileLen = 0;
+      }
+      fclose(JsonFile);
+   }
+
+   return FileLen;
+
+} /* End ReadFile() */
+
+
+/******************************************************************************
+** Function: NowNs
+**
+*/
+static uint64 NowNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000000 + Now.tv_nsec;
+
+} /* End NowNs() */
@@ -0,0 +1,313 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure how the message and scheduler table load and dump commands
+**    scale with the number of table entries
+**
+**  Notes:
+**    1. Usage: bench_tblload [reps] [ini file]
+**    2. Synthetic tables are generated from 10 entries, doubling, up to
+**       MSGTBL_MAX_ENTRIES and SCHTBL_MAX_ENTRIES. Raise those limits and
+**       the JSON file sizes in kit_sch_platform_cfg.h to extend the curves.
+**    3. MSGTBL_LoadCmd(), SCHTBL_LoadCmd() and the two DumpCmd() functions
+**       are timed end to end with CLOCK_MONOTONIC, including the host file
+**       I/O. Dumps are compact so their size follows the loaded entries.
+**    4. The message table is measured with an empty scheduler table. The
+**       scheduler tables reference a full message table.
+**    5. Each measurement is the fastest of BENCH_RUNS runs of reps commands.
+**       Results are CSV on stdout.
+**    6. error_events counts the error events during a size's measurement.
+**       A full scheduler table has slots over the analyzer's message budget
+**       so each of its loads reports one, which is expected.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <time.h>
+#include "scheduler.h"
+#include "hostcfe.h"
+#include "virtplat.h"
+#include "tblgen.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_DEF_REPS    20
+#define BENCH_RUNS        3
+#define BENCH_MIN_ENTRIES 10
+
+#define BENCH_LOAD_FILE  "bench_tblload.json"
+#define BENCH_DUMP_FILE  "bench_tblload~.json"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   const char*  Name;
+   uint16       MaxEntries;
+   size_t     (*WriteTbl)(uint16 Entries);
+   TBLMGR_LoadTblFuncPtr_t  LoadCmd;
+   TBLMGR_DumpTblFuncPtr_t  DumpCmd;
+
+} BenchTbl_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static void   BenchTable(const BenchTbl_t* Tbl, uint32 Reps);
+static size_t WriteMsgTbl(uint16 Entries);
+static size_t WriteSchTbl(uint16 Entries);
+static bool   TimeCmd(const BenchTbl_t* Tbl, bool Load, uint32 Reps, uint64* BestNs);
+static size_t FileBytes(const char* Filename);
+static uint64 NowNs(void);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static SCHEDULER_Class_t  SchedulerObj;
+
+static const uint8 SchTblPeriod[] = { 1, 2, 4, 8 };
+
+static const BenchTbl_t BenchTbl[] =
+{
+   { "msgtbl", MSGTBL_MAX_ENTRIES, WriteMsgTbl, MSGTBL_LoadCmd, MSGTBL_DumpCmd },
+   { "schtbl", SCHTBL_MAX_ENTRIES, WriteSchTbl, SCHTBL_LoadCmd, SCHTBL_DumpCmd }
+};
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char* argv[])
+{
+
+   INITBL_Class_t     IniTbl;
+   VIRTPLAT_Config_t  PlatConfig;
+   uint32  Reps = BENCH_DEF_REPS;
+   uint16  Tbl;
+   const char* IniFile = KIT_SCH_HOST_INI_FILE;
+
+   if (argc > 1)
+   {
+      Reps = (uint32)strtoul(argv[1], NULL, 0);
+   }
+   if (argc > 2)
+   {
+      IniFile = argv[2];
+   }
+
+   if ((Reps == 0) || !INITBL_Constructor(&IniTbl, IniFile))
+   {
+      printf("Usage: bench_tblload [reps] [ini file]\n");
+      return 1;
+   }
+
+   HOSTCFE_SetEventLevel(HOSTCFE_EVENT_TYPES);
+   VIRTPLAT_DefaultConfig(&PlatConfig);
+   VIRTPLAT_Reset(&PlatConfig);
+   SCHEDULER_Constructor(&SchedulerObj, &IniTbl);
+
+   printf("# KIT_SCH table load and dump benchmark: %u commands per run, best of %d runs\n", Reps, BENCH_RUNS);
+   printf("table,entries,load_bytes,load_ms,load_ms_per_entry,dump_bytes,dump_ms,dump_ms_per_entry,error_events\n");
+
+   for (Tbl=0; Tbl < sizeof(BenchTbl)/sizeof(BenchTbl_t); Tbl++)
+   {
+      BenchTable(&BenchTbl[Tbl], Reps);
+   }
+
+   remove(BENCH_LOAD_FILE);
+   remove(BENCH_DUMP_FILE);
+
+   return 0;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: BenchTable
+**
+** Print one CSV line for each table size.
+*/
+static void BenchTable(const BenchTbl_t* Tbl, uint32 Reps)
+{
+
+   uint16  Entries = BENCH_MIN_ENTRIES;
+   bool    LastSize = false;
+   size_t  LoadBytes;
+   uint64  LoadNs, DumpNs;
+   uint32  ErrorCnt;
+
+   while (!LastSize)
+   {
+
+      if (Entries >= Tbl->MaxEntries)
+      {
+         Entries  = Tbl->MaxEntries;
+         LastSize = true;
+      }
+
+      ErrorCnt  = HOSTCFE_GetStats()->EventCnt[CFE_EVS_EventType_ERROR];
+      LoadBytes = Tbl->WriteTbl(Entries);
+
+      if ((LoadBytes > 0) && TimeCmd(Tbl, true, Reps, &LoadNs) && TimeCmd(Tbl, false, Reps, &DumpNs))
+      {
+         printf("%s,%u,%lu,%.4f,%.6f,%lu,%.4f,%.6f,%u\n", Tbl->Name, Entries, (unsigned long)LoadBytes,
+                (double)LoadNs / (1.0e6*Reps), (double)LoadNs / (1.0e6*Reps*Entries),
+                (unsigned long)FileBytes(BENCH_DUMP_FILE),
+                (double)DumpNs / (1.0e6*Reps), (double)DumpNs / (1.0e6*Reps*Entries),
+                HOSTCFE_GetStats()->EventCnt[CFE_EVS_EventType_ERROR] - ErrorCnt);
+      }
+      else
+      {
+         printf("%s,%u,%lu,failed,,,,,%u\n", Tbl->Name, Entries, (unsigned long)LoadBytes,
+                HOSTCFE_GetStats()->EventCnt[CFE_EVS_EventType_ERROR] - ErrorCnt);
+      }
+
+      Entries *= 2;
+
+   } /* End table size loop */
+
+} /* End BenchTable() */
+
+
+/******************************************************************************
+** Function: WriteMsgTbl
+**
+*/
+static size_t WriteMsgTbl(uint16 Entries)
+{
+
+   return TBLGEN_WriteMsgTbl(BENCH_LOAD_FILE, Entries, 0);
+
+} /* End WriteMsgTbl() */
+
+
+/******************************************************************************
+** Function: WriteSchTbl
+**
+** Load a full message table for the scheduler table's msg-idx references
+** and write the scheduler table.
+*/
+static size_t WriteSchTbl(uint16 Entries)
+{
+
+   size_t           FileLen = 0;
+   TBLGEN_SchTbl_t  SchTblDef;
+
+   SchTblDef.EntryCnt  = Entries;
+   SchTblDef.Period    = SchTblPeriod;
+   SchTblDef.PeriodCnt = sizeof(SchTblPeriod);
+   SchTblDef.MsgCnt    = MSGTBL_MAX_ENTRIES;
+
+   if ((TBLGEN_WriteMsgTbl(BENCH_LOAD_FILE, MSGTBL_MAX_ENTRIES, 0) > 0) &&
+       MSGTBL_LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, BENCH_LOAD_FILE))
+   {
+      FileLen = TBLGEN_WriteSchTbl(BENCH_LOAD_FILE, &SchTblDef);
+   }
+
+   return FileLen;
+
+} /* End WriteSchTbl() */
+
+
+/******************************************************************************
+** Function: TimeCmd
+**
+** Time Reps load or dump commands and return false if any of them fail.
+*/
+static bool TimeCmd(const BenchTbl_t* Tbl, bool Load, uint32 Reps, uint64* BestNs)
+{
+
+   bool   RetStatus = true;
+   uint64 StartNs, RunNs;
+   uint32 Run, Rep;
+
+   *BestNs = UINT64_MAX;
+   for (Run=0; RetStatus && (Run < BENCH_RUNS); Run++)
+   {
+
+      StartNs = NowNs();
+      for (Rep=0; RetStatus && (Rep < Reps); Rep++)
+      {
+         RetStatus = Load ? Tbl->LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, BENCH_LOAD_FILE) :
+                            Tbl->DumpCmd(NULL, KIT_SCH_DUMP_TBL_COMPACT, BENCH_DUMP_FILE);
+      }
+
+      RunNs = NowNs() - StartNs;
+      if (RunNs < *BestNs)
+      {
+         *BestNs = RunNs;
+      }
+   }
+
+   return RetStatus;
+
+} /* End TimeCmd() */
+
+
+/******************************************************************************
+** Function: FileBytes
+**
+*/
+static size_t FileBytes(const char* Filename)
+{
+
+   long   FileLen = 0;
+   FILE*  File = fopen(Filename, "r");
+
+   if (File != NULL)
+   {
+      fseek(File, 0, SEEK_END);
+      FileLen = ftell(File);
+      fclose(File);
+   }
+
+   return (FileLen > 0) ? (size_t)FileLen : 0;
+
+} /* End FileBytes() */
+
+
+/******************************************************************************
+** Function: NowNs
+**
+*/
+static uint64 NowNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000000 + Now.tv_nsec;
+
+} /* End NowNs() */
@@ -0,0 +1,435 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Run the scheduler loop in real time on Linux and report the minor
+**    frame timer's tick latency and the slot start errors
+**
+**  Notes:
+**    1. Usage: rt_loop [-d seconds] [-p priority] [-c cpu] [-l threads]
+**                      [-u duty] [-n] [ini file]
+**         -d  Run time in seconds, default RT_DEF_SEC
+**         -p  SCHED_FIFO priority of the timer and tone threads. The
+**             scheduler task runs one priority lower. Default 0 is the
+**             default policy.
+**         -c  Pin all threads to a CPU
+**         -l  Number of synthetic CPU load threads, default 0
+**         -u  Load thread duty cycle in percent, default 100
+**         -n  No tone, the scheduler synchronizes to the MET and counts
+**             each major frame as missed
+**       SCHED_FIFO usually needs root or CAP_SYS_NICE. If it can't be
+**       applied a warning is printed and the run continues.
+**    2. The loop is SCHEDULER_Execute() on the POSIX platform (see
+**       posixplat.h) with one activity per slot that sends a message whose
+**       ID identifies the slot, like sim_timing. A slot's error is its send
+**       time minus the nearest nominal start of the slot, which is the MET
+**       second plus the slot's offset.
+**    3. The first RT_SETTLE_SEC seconds aren't measured so the startup
+**       synchronization isn't included. Without the tone the scheduler
+**       waits SCHEDULER_STARTUP_PERIOD before it synchronizes to the MET
+**       so that is added to the settle time. Tick latency is measured by
+**       the platform for every expiry.
+**    4. Output is a summary, the histograms and the change in the
+**       scheduler's counters, each as a CSV block.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "scheduler.h"
+#include "hostcfe.h"
+#include "posixplat.h"
+#include "tblgen.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RT_DEF_SEC       30
+#define RT_SETTLE_SEC    2
+#define RT_MAX_LOAD_THREADS  64
+#define RT_LOAD_PERIOD_US    10000
+
+#define RT_MSG_TBL_FILE  "rt_loop_msgtbl.json"
+#define RT_SCH_TBL_FILE  "rt_loop_schtbl.json"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint32  Seconds;
+   uint32  SettleSec;
+   int32   Priority;
+   uint16  LoadThreads;
+   uint32  LoadDutyPct;
+   POSIXPLAT_Config_t  Plat;
+
+} RtConfig_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static bool   ParseArgs(int argc, char* argv[], RtConfig_t* Config, const char** IniFile);
+static bool   LoadTables(void);
+static void   RunLoop(const RtConfig_t* Config);
+static void   PrintResults(const RtConfig_t* Config, const SCHEDULER_Stats_t* Start, const SCHEDULER_Stats_t* End);
+static void   RecordSlot(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size);
+static void*  LoadThread(void* Arg);
+static uint64 NowUs(void);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static SCHEDULER_Class_t  SchedulerObj;
+
+static volatile bool      Measuring = false;
+static volatile bool      StopLoad  = false;
+static POSIXPLAT_Hist_t   SlotError;
+static uint32             LoadDutyPct;
+
+static const uint8 SlotPeriod[] = { 1 };
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char* argv[])
+{
+
+   INITBL_Class_t  IniTbl;
+   RtConfig_t      Config;
+   const char*     IniFile = KIT_SCH_HOST_INI_FILE;
+
+   if (!ParseArgs(argc, argv, &Config, &IniFile) || !INITBL_Constructor(&IniTbl, IniFile))
+   {
+      printf("Usage: rt_loop [-d seconds > settle] [-p priority] [-c cpu] [-l threads] [-u duty] [-n] [ini file]\n");
+      return 1;
+   }
+
+   HOSTCFE_SetEventLevel(HOSTCFE_EVENT_TYPES);
+
+   if (!POSIXPLAT_Start(&Config.Plat))
+   {
+      printf("Error starting the POSIX platform\n");
+      return 1;
+   }
+
+   SCHEDULER_Constructor(&SchedulerObj, &IniTbl);
+
+   if (LoadTables())
+   {
+      RunLoop(&Config);
+   }
+   else
+   {
+      POSIXPLAT_Stop();
+      printf("Error loading the tables\n");
+   }
+
+   remove(RT_MSG_TBL_FILE);
+   remove(RT_SCH_TBL_FILE);
+
+   return 0;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: ParseArgs
+**
+*/
+static bool ParseArgs(int argc, char* argv[], RtConfig_t* Config, const char** IniFile)
+{
+
+   bool ValidArgs = true;
+   int  Opt;
+
+   memset(Config, 0, sizeof(RtConfig_t));
+   Config->Seconds          = RT_DEF_SEC;
+   Config->LoadDutyPct      = 100;
+   Config->Plat.Cpu         = -1;
+   Config->Plat.ToneEnabled = true;
+
+   while (ValidArgs && ((Opt = getopt(argc, argv, "d:p:c:l:u:n")) != -1))
+   {
+      switch (Opt)
+      {
+         case 'd': Config->Seconds     = (uint32)strtoul(optarg, NULL, 0); break;
+         case 'p': Config->Priority    = (int32)strtol(optarg, NULL, 0);   break;
+         case 'c': Config->Plat.Cpu    = (int32)strtol(optarg, NULL, 0);   break;
+         case 'l': Config->LoadThreads = (uint16)strtoul(optarg, NULL, 0); break;
+         case 'u': Config->LoadDutyPct = (uint32)strtoul(optarg, NULL, 0); break;
+         case 'n': Config->Plat.ToneEnabled = false; break;
+         default:  ValidArgs = false; break;
+      }
+   }
+
+   if (optind < argc)
+   {
+      *IniFile = argv[optind];
+   }
+
+   Config->Plat.Priority = Config->Priority;
+   Config->SettleSec = RT_SETTLE_SEC;
+   if (!Config->Plat.ToneEnabled)
+   {
+      Config->SettleSec += SCHEDULER_STARTUP_PERIOD / POSIXPLAT_MICROS_PER_SEC;
+   }
+
+   return (ValidArgs && (Config->Seconds > Config->SettleSec) && (Config->Priority >= 0) &&
+           (Config->LoadThreads <= RT_MAX_LOAD_THREADS) &&
+           (Config->LoadDutyPct > 0) && (Config->LoadDutyPct <= 100));
+
+} /* End ParseArgs() */
+
+
+/******************************************************************************
+** Function: LoadTables
+**
+** Load one activity per slot.
+*/
+static bool LoadTables(void)
+{
+
+   TBLGEN_SchTbl_t  SchTblDef;
+
+   SchTblDef.EntryCnt  = SCHTBL_SLOTS;
+   SchTblDef.Period    = SlotPeriod;
+   SchTblDef.PeriodCnt = sizeof(SlotPeriod);
+   SchTblDef.MsgCnt    = SCHTBL_SLOTS;
+
+   return ((TBLGEN_WriteMsgTbl(RT_MSG_TBL_FILE, SCHTBL_SLOTS, 0) > 0) &&
+           (TBLGEN_WriteSchTbl(RT_SCH_TBL_FILE, &SchTblDef) > 0) &&
+           MSGTBL_LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, RT_MSG_TBL_FILE) &&
+           SCHTBL_LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, RT_SCH_TBL_FILE));
+
+} /* End LoadTables() */
+
+
+/******************************************************************************
+** Function: RunLoop
+**
+** Start the load threads and run the scheduler for the configured time.
+*/
+static void RunLoop(const RtConfig_t* Config)
+{
+
+   SCHEDULER_Stats_t  Start, End;
+   pthread_t  Load[RT_MAX_LOAD_THREADS];
+   uint16     LoadCnt = 0;
+   uint64     SettleUs = (uint64)Config->SettleSec * POSIXPLAT_MICROS_PER_SEC;
+   uint64     EndUs    = (uint64)Config->Seconds * POSIXPLAT_MICROS_PER_SEC;
+   bool       Running  = true;
+
+   /* Runs below the platform's timer and tone threads like a cFS app task */
+   if (!POSIXPLAT_ConfigThread((Config->Priority > 1) ? (Config->Priority - 1) : Config->Priority))
+   {
+      printf("# Warning: SCHED_FIFO priority or CPU affinity couldn't be applied\n");
+   }
+
+   LoadDutyPct = Config->LoadDutyPct;
+   while ((LoadCnt < Config->LoadThreads) && (pthread_create(&Load[LoadCnt], NULL, LoadThread, NULL) == 0))
+   {
+      LoadCnt++;
+   }
+
+   memset(&SlotError, 0, sizeof(SlotError));
+   HOSTCFE_SetTransmitHook(RecordSlot);
+   SCHEDULER_StartTimers();
+
+   while (Running && (POSIXPLAT_NowUs() < SettleUs))
+   {
+      Running = SCHEDULER_Execute();
+   }
+
+   SCHEDULER_GetStats(&Start);
+   Measuring = true;
+
+   while (Running && (POSIXPLAT_NowUs() < EndUs))
+   {
+      Running = SCHEDULER_Execute();
+   }
+
+   Measuring = false;
+   SCHEDULER_GetStats(&End);
+   HOSTCFE_SetTransmitHook(NULL);
+
+   POSIXPLAT_Stop();
+   StopLoad = true;
+   while (LoadCnt > 0)
+   {
+      pthread_join(Load[--LoadCnt], NULL);
+   }
+
+   PrintResults(Config, &Start, &End);
+
+} /* End RunLoop() */
+
+
+/******************************************************************************
+** Function: PrintResults
+**
+*/
+static void PrintResults(const RtConfig_t* Config, const SCHEDULER_Stats_t* Start, const SCHEDULER_Stats_t* End)
+{
+
+   const POSIXPLAT_Stats_t* PlatStats = POSIXPLAT_GetStats();
+   const POSIXPLAT_Hist_t*  Hist[2];
+   const char* HistName[2] = { "tick_latency", "slot_error" };
+   uint16 h, Bin;
+
+   Hist[0] = &PlatStats->TickLatency;
+   Hist[1] = &SlotError;
+
+   printf("# KIT_SCH real time loop: %u s (first %u not measured), priority %d, cpu %d, %u load threads at %u%%, tone %s, ClockAccuracy %u us\n",
+          Config->Seconds, Config->SettleSec, Config->Priority, Config->Plat.Cpu, Config->LoadThreads,
+          Config->LoadDutyPct, (Config->Plat.ToneEnabled ? "on" : "off"), SchedulerObj.ClockAccuracy);
+   if (PlatStats->RtConfigFailures > 0)
+   {
+      printf("# Warning: %u threads couldn't apply the priority or CPU affinity\n", PlatStats->RtConfigFailures);
+   }
+
+   printf("measure,samples,min_us,mean_us,max_us\n");
+   for (h=0; h < 2; h++)
+   {
+      printf("%s,%u,%ld,%.1f,%ld\n", HistName[h], Hist[h]->Samples, (long)Hist[h]->MinUs,
+             (Hist[h]->Samples > 0) ? ((double)Hist[h]->SumUs / Hist[h]->Samples) : 0.0,
+             (long)Hist[h]->MaxUs);
+   }
+
+   printf("\nabs_us_max,tick_latency,slot_error\n");
+   for (Bin=0; Bin < POSIXPLAT_HIST_BINS; Bin++)
+   {
+      if (Bin < POSIXPLAT_HIST_BINS-1)
+      {
+         printf("%u", POSIXPLAT_HistBinLimUs(Bin));
+      }
+      else
+      {
+         printf("inf");
+      }
+      printf(",%u,%u\n", Hist[0]->Bin[Bin], Hist[1]->Bin[Bin]);
+   }
+
+   printf("\nslots_expected,slots_sent,valid_major,missed_major,unexpected_major,"
+          "skipped_slots,multiple_slots,same_slot,major_frame_ignored\n");
+   printf("%u,%u,%u,%u,%u,%u,%u,%u,%s\n",
+          (Config->Seconds - Config->SettleSec) * SCHTBL_SLOTS, SlotError.Samples,
+          (End->ValidMajorFrameCount - Start->ValidMajorFrameCount),
+          (End->MissedMajorFrameCount - Start->MissedMajorFrameCount),
+          (End->UnexpectedMajorFrameCount - Start->UnexpectedMajorFrameCount),
+          (uint16)(End->SkippedSlotsCount - Start->SkippedSlotsCount),
+          (uint16)(End->MultipleSlotsCount - Start->MultipleSlotsCount),
+          (uint16)(End->SameSlotCount - Start->SameSlotCount),
+          CMDMGR_BoolStr(End->IgnoreMajorFrame));
+
+} /* End PrintResults() */
+
+
+/******************************************************************************
+** Function: RecordSlot
+**
+** Transmit hook that adds the slot messages' send time errors to the slot
+** error histogram.
+**
+** Notes:
+**   1. Only called by the scheduler task.
+*/
+static void RecordSlot(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size)
+{
+
+   CFE_SB_MsgId_t MsgId;
+   uint32  Slot;
+   int64   RelUs;
+
+   CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+   Slot = CFE_SB_MsgIdToValue(MsgId) - TBLGEN_BASE_TOPIC_ID;
+
+   if (Measuring && (Slot < SCHTBL_SLOTS))
+   {
+      RelUs = (int64)POSIXPLAT_NowUs() - (int64)Slot * SCHEDULER_NORMAL_SLOT_PERIOD;
+      POSIXPLAT_HistAdd(&SlotError, RelUs - ((RelUs + POSIXPLAT_MICROS_PER_SEC/2) / POSIXPLAT_MICROS_PER_SEC) * POSIXPLAT_MICROS_PER_SEC);
+   }
+
+} /* End RecordSlot() */
+
+
+/******************************************************************************
+** Function: LoadThread
+**
+** Spin for the duty cycle of each RT_LOAD_PERIOD_US period and sleep for
+** the rest.
+*/
+static void* LoadThread(void* Arg)
+{
+
+   struct timespec Sleep;
+   uint64 PeriodStartUs;
+   uint64 BusyUs = (uint64)RT_LOAD_PERIOD_US * LoadDutyPct / 100;
+
+   POSIXPLAT_ConfigThread(0);
+
+   while (!StopLoad)
+   {
+
+      PeriodStartUs = NowUs();
+      while ((NowUs() - PeriodStartUs) < BusyUs);
+
+      if (BusyUs < RT_LOAD_PERIOD_US)
+      {
+         Sleep.tv_sec  = 0;
+         Sleep.tv_nsec = (long)(RT_LOAD_PERIOD_US - BusyUs) * 1000;
+         nanosleep(&Sleep, NULL);
+      }
+
+   } /* End while load */
+
+   return NULL;
+
+} /* End LoadThread() */
+
+
+/******************************************************************************
+** Function: NowUs
+**
+*/
+static uint64 NowUs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000 + Now.tv_nsec / 1000;
+
+} /* End NowUs() */
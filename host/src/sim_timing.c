@@ -0,0 +1,363 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Simulate the scheduler's frame timing under tone and timer faults in
+**    virtual time
+**
+**  Notes:
+**    1. Usage: sim_timing [seconds] [seed] [ini file]
+**    2. Each scenario configures the virtual platform's tone and minor
+**       frame timer models (see virtplat.h), runs SCHEDULER_Execute() for
+**       the given number of virtual seconds and reports one CSV line.
+**    3. The scheduler table has one activity per slot that sends a message
+**       whose ID identifies the slot. The transmit hook computes each
+**       slot's error as its send time minus the nearest nominal start of
+**       that slot, which is the MET second plus the slot's offset.
+**    4. Slot errors and counters are measured after SIM_SETTLE_SEC so the
+**       startup synchronization isn't included. Counters are the change in
+**       the scheduler's published statistics over the measurement.
+**    5. The flywheel scenarios report cFE TIME flywheeling for the middle
+**       third of the run.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <time.h>
+#include "scheduler.h"
+#include "hostcfe.h"
+#include "virtplat.h"
+#include "tblgen.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SIM_DEF_SEC     3600
+#define SIM_SETTLE_SEC  10
+
+#define SIM_MSG_TBL_FILE  "sim_timing_msgtbl.json"
+#define SIM_SCH_TBL_FILE  "sim_timing_schtbl.json"
+
+#define SIM_ERR_BINS  6
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   const char*  Name;
+   uint32       TimerAccuracyUs;
+   int32        TimerDriftPpm;
+   uint32       TimerJitterUs;
+   bool         ToneEnabled;
+   uint32       ToneJitterUs;
+   uint32       ToneDropPct;
+   bool         Flywheel;
+
+} Scenario_t;
+
+typedef struct
+{
+
+   bool    Measuring;
+   uint32  SlotsSent;
+   int64   ErrSumUs;
+   uint64  ErrAbsSumUs;
+   uint32  ErrMaxUs;
+   uint32  ErrBin[SIM_ERR_BINS];
+
+} SlotAccuracy_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static bool   LoadTables(const INITBL_Class_t* IniTbl, const Scenario_t* Scenario, uint32 Seed);
+static void   RunScenario(const Scenario_t* Scenario, uint32 Seconds);
+static void   RecordSlot(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size);
+static uint64 NowNs(void);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static SCHEDULER_Class_t  SchedulerObj;
+static SlotAccuracy_t     SlotAccuracy;
+
+static const uint8 SlotPeriod[] = { 1 };
+
+/* Upper bounds of the slot error histogram bins, the last bin is unbounded */
+static const uint32 ErrBinLimUs[SIM_ERR_BINS-1] = { 1, 100, 1000, 10000, 100000 };
+
+/*                                      Accuracy  Drift  Jitter  Tone   Jitter  Drop  Fly */
+static const Scenario_t Scenario[] =
+{
+   { "nominal",                          1,     0,       0,  true,       0,   0, false },
+   { "tone-jitter-2ms",                  1,     0,       0,  true,    2000,   0, false },
+   { "tone-jitter-20ms",                 1,     0,       0,  true,   20000,   0, false },
+   { "missed-tones-10pct",               1,     0,       0,  true,       0,  10, false },
+   { "missed-tones-50pct",               1,     0,       0,  true,       0,  50, false },
+   { "no-tone",                          1,     0,       0, false,       0,   0, false },
+   { "timer-accuracy-10ms",          10000,     0,       0,  true,       0,   0, false },
+   { "timer-accuracy-100ms",        100000,     0,       0,  true,       0,   0, false },
+   { "timer-drift-slow-1000ppm",         1,  1000,       0,  true,       0,   0, false },
+   { "timer-drift-fast-1000ppm",         1, -1000,       0,  true,       0,   0, false },
+   { "timer-jitter-5ms",                 1,     0,    5000,  true,       0,   0, false },
+   { "flywheel",                         1,     0,       0,  true,       0,   0, true  },
+   { "flywheel-drift-1000ppm",           1,  1000,       0,  true,       0,   0, true  },
+   { "all-faults",                  100000,   500,    5000,  true,    2000,  10, true  }
+};
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char* argv[])
+{
+
+   INITBL_Class_t  IniTbl;
+   uint32  Seconds = SIM_DEF_SEC;
+   uint32  Seed    = 1;
+   uint16  i;
+   const char* IniFile = KIT_SCH_HOST_INI_FILE;
+
+   if (argc > 1)
+   {
+      Seconds = (uint32)strtoul(argv[1], NULL, 0);
+   }
+   if (argc > 2)
+   {
+      Seed = (uint32)strtoul(argv[2], NULL, 0);
+   }
+   if (argc > 3)
+   {
+      IniFile = argv[3];
+   }
+
+   if ((Seconds <= SIM_SETTLE_SEC) || !INITBL_Constructor(&IniTbl, IniFile))
+   {
+      printf("Usage: sim_timing [seconds > %d] [seed] [ini file]\n", SIM_SETTLE_SEC);
+      return 1;
+   }
+
+   printf("# KIT_SCH timing simulation: %u virtual seconds per scenario, first %d not measured, seed %u\n",
+          Seconds, SIM_SETTLE_SEC, Seed);
+   printf("scenario,wall_ms,slots_expected,slots_sent,err_mean_us,err_abs_mean_us,err_abs_max_us,"
+          "err_le_1us,err_le_100us,err_le_1ms,err_le_10ms,err_le_100ms,err_gt_100ms,"
+          "tones,tones_dropped,valid_major,missed_major,unexpected_major,"
+          "skipped_slots,multiple_slots,same_slot,major_frame_ignored,error_events\n");
+
+   for (i=0; i < sizeof(Scenario)/sizeof(Scenario_t); i++)
+   {
+
+      if (LoadTables(&IniTbl, &Scenario[i], Seed))
+      {
+         printf("%s,", Scenario[i].Name);
+         RunScenario(&Scenario[i], Seconds);
+      }
+      else
+      {
+         printf("%s,load failed\n", Scenario[i].Name);
+      }
+
+   } /* End scenario loop */
+
+   remove(SIM_MSG_TBL_FILE);
+   remove(SIM_SCH_TBL_FILE);
+
+   return 0;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: LoadTables
+**
+** Construct a new scheduler on a virtual platform configured for the
+** scenario and load one activity per slot.
+*/
+static bool LoadTables(const INITBL_Class_t* IniTbl, const Scenario_t* Scenario, uint32 Seed)
+{
+
+   VIRTPLAT_Config_t  PlatConfig;
+   TBLGEN_SchTbl_t    SchTblDef;
+
+   HOSTCFE_Reset();
+   HOSTCFE_SetEventLevel(HOSTCFE_EVENT_TYPES);
+
+   VIRTPLAT_DefaultConfig(&PlatConfig);
+   PlatConfig.TimerAccuracyUs = Scenario->TimerAccuracyUs;
+   PlatConfig.TimerDriftPpm   = Scenario->TimerDriftPpm;
+   PlatConfig.TimerJitterUs   = Scenario->TimerJitterUs;
+   PlatConfig.ToneEnabled     = Scenario->ToneEnabled;
+   PlatConfig.ToneJitterUs    = Scenario->ToneJitterUs;
+   PlatConfig.ToneDropPct     = Scenario->ToneDropPct;
+   PlatConfig.Seed            = Seed;
+   VIRTPLAT_Reset(&PlatConfig);
+
+   SCHEDULER_Constructor(&SchedulerObj, IniTbl);
+
+   SchTblDef.EntryCnt  = SCHTBL_SLOTS;
+   SchTblDef.Period    = SlotPeriod;
+   SchTblDef.PeriodCnt = sizeof(SlotPeriod);
+   SchTblDef.MsgCnt    = SCHTBL_SLOTS;
+
+   return ((TBLGEN_WriteMsgTbl(SIM_MSG_TBL_FILE, SCHTBL_SLOTS, 0) > 0) &&
+           (TBLGEN_WriteSchTbl(SIM_SCH_TBL_FILE, &SchTblDef) > 0) &&
+           MSGTBL_LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, SIM_MSG_TBL_FILE) &&
+           SCHTBL_LoadCmd(NULL, TBLMGR_LOAD_TBL_REPLACE, SIM_SCH_TBL_FILE));
+
+} /* End LoadTables() */
+
+
+/******************************************************************************
+** Function: RunScenario
+**
+** Run the scheduler until the end of the scenario and print the scenario's
+** CSV values after its name.
+*/
+static void RunScenario(const Scenario_t* Scenario, uint32 Seconds)
+{
+
+   SCHEDULER_Stats_t  Start, End;
+   VIRTPLAT_Stats_t   PlatStart;
+   const VIRTPLAT_Stats_t* PlatEnd = VIRTPLAT_GetStats();
+   uint64  SettleUs  = (uint64)SIM_SETTLE_SEC * VIRTPLAT_MICROS_PER_SEC;
+   uint64  EndUs     = (uint64)Seconds * VIRTPLAT_MICROS_PER_SEC;
+   uint64  FlyStartUs = (Scenario->Flywheel ? (SettleUs + (EndUs - SettleUs)/3) : EndUs);
+   uint64  FlyEndUs   = (Scenario->Flywheel ? (SettleUs + 2*(EndUs - SettleUs)/3) : EndUs);
+   uint32  SlotsExpected = (Seconds - SIM_SETTLE_SEC) * SCHTBL_SLOTS;
+   bool    Running = true;
+   uint64  StartNs = NowNs();
+   uint16  i;
+
+   memset(&SlotAccuracy, 0, sizeof(SlotAccuracy_t));
+   HOSTCFE_SetTransmitHook(RecordSlot);
+   SCHEDULER_StartTimers();
+
+   while (Running && (VIRTPLAT_NowUs() < SettleUs))
+   {
+      Running = SCHEDULER_Execute();
+   }
+
+   SCHEDULER_GetStats(&Start);
+   PlatStart = *PlatEnd;
+   SlotAccuracy.Measuring = true;
+
+   while (Running && (VIRTPLAT_NowUs() < EndUs))
+   {
+      VIRTPLAT_SetFlywheel((VIRTPLAT_NowUs() >= FlyStartUs) && (VIRTPLAT_NowUs() < FlyEndUs));
+      Running = SCHEDULER_Execute();
+   }
+
+   SlotAccuracy.Measuring = false;
+   SCHEDULER_GetStats(&End);
+   HOSTCFE_SetTransmitHook(NULL);
+
+   printf("%.1f,%u,%u,%.1f,%.1f,%u,", (double)(NowNs() - StartNs) / 1000000.0, SlotsExpected, SlotAccuracy.SlotsSent,
+          (SlotAccuracy.SlotsSent > 0) ? ((double)SlotAccuracy.ErrSumUs / SlotAccuracy.SlotsSent) : 0.0,
+          (SlotAccuracy.SlotsSent > 0) ? ((double)SlotAccuracy.ErrAbsSumUs / SlotAccuracy.SlotsSent) : 0.0,
+          SlotAccuracy.ErrMaxUs);
+   for (i=0; i < SIM_ERR_BINS; i++)
+   {
+      printf("%u,", SlotAccuracy.ErrBin[i]);
+   }
+   printf("%u,%u,%u,%u,%u,%u,%u,%u,%s,%u\n",
+          (PlatEnd->Tones - PlatStart.Tones), (PlatEnd->TonesDropped - PlatStart.TonesDropped),
+          (End.ValidMajorFrameCount - Start.ValidMajorFrameCount),
+          (End.MissedMajorFrameCount - Start.MissedMajorFrameCount),
+          (End.UnexpectedMajorFrameCount - Start.UnexpectedMajorFrameCount),
+          (uint16)(End.SkippedSlotsCount - Start.SkippedSlotsCount),
+          (uint16)(End.MultipleSlotsCount - Start.MultipleSlotsCount),
+          (uint16)(End.SameSlotCount - Start.SameSlotCount),
+          CMDMGR_BoolStr(End.IgnoreMajorFrame),
+          HOSTCFE_GetStats()->EventCnt[CFE_EVS_EventType_ERROR]);
+
+} /* End RunScenario() */
+
+
+/******************************************************************************
+** Function: RecordSlot
+**
+** Transmit hook that accumulates the send time error of the slot messages.
+**
+** Notes:
+**   1. A slot's nominal start is the MET second plus the slot's offset. The
+**      nearest one is used so the error is within +/- half a second.
+*/
+static void RecordSlot(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size)
+{
+
+   CFE_SB_MsgId_t MsgId;
+   uint32  Slot;
+   int64   RelUs;
+   int64   ErrUs;
+   uint32  ErrAbsUs;
+   uint16  Bin;
+
+   CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+   Slot = CFE_SB_MsgIdToValue(MsgId) - TBLGEN_BASE_TOPIC_ID;
+
+   if (SlotAccuracy.Measuring && (Slot < SCHTBL_SLOTS))
+   {
+
+      RelUs = (int64)VIRTPLAT_NowUs() - (int64)Slot * SCHEDULER_NORMAL_SLOT_PERIOD;
+      ErrUs = RelUs - ((RelUs + VIRTPLAT_MICROS_PER_SEC/2) / VIRTPLAT_MICROS_PER_SEC) * VIRTPLAT_MICROS_PER_SEC;
+      ErrAbsUs = (uint32)((ErrUs < 0) ? -ErrUs : ErrUs);
+
+      SlotAccuracy.SlotsSent++;
+      SlotAccuracy.ErrSumUs    += ErrUs;
+      SlotAccuracy.ErrAbsSumUs += ErrAbsUs;
+      if (ErrAbsUs > SlotAccuracy.ErrMaxUs)
+      {
+         SlotAccuracy.ErrMaxUs = ErrAbsUs;
+      }
+
+      for (Bin=0; (Bin < SIM_ERR_BINS-1) && (ErrAbsUs > ErrBinLimUs[Bin]); Bin++);
+      SlotAccuracy.ErrBin[Bin]++;
+
+   } /* End if measured slot message */
+
+} /* End RecordSlot() */
+
+
+/******************************************************************************
+** Function: NowNs
+**
+*/
+static uint64 NowNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * 1000000000 + Now.tv_nsec;
+
+} /* End NowNs() */
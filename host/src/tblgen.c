@@ -0,0 +1,119 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Write synthetic message and scheduler JSON tables for the host drivers
+**
+**  Notes:
+**    1. See tblgen.h for the table contents.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "tblgen.h"
+
+
+/******************************************************************************
+** Function: TBLGEN_WriteMsgTbl
+**
+*/
+size_t TBLGEN_WriteMsgTbl(const char* Filename, uint16 MsgCnt, uint16 DataWords)
+{
+
+   size_t FileLen = 0;
+   FILE*  JsonFile;
+   uint16 Msg, Word;
+
+   JsonFile = fopen(Filename, "w");
+   if (JsonFile != NULL)
+   {
+
+      fprintf(JsonFile, "{\"name\":\"Synthetic message table\",\"message-array\":[");
+      for (Msg=0; Msg < MsgCnt; Msg++)
+      {
+         fprintf(JsonFile, "%s{\"message\":{\"id\":%u,\"topic-id\":%u,\"seq-seg\":49152,\"length\":%u",
+                 (Msg == 0) ? "" : ",", Msg, TBLGEN_BASE_TOPIC_ID + Msg, 1 + 2*DataWords);
+         if (DataWords > 0)
+         {
+            fprintf(JsonFile, ",\"data-words\":\"");
+            for (Word=0; Word < DataWords; Word++)
+            {
+               fprintf(JsonFile, "%s%u", (Word == 0) ? "" : ",", Word);
+            }
+            fprintf(JsonFile, "\"");
+         }
+         fprintf(JsonFile, "}}");
+      }
+      fprintf(JsonFile, "]}\n");
+
+      FileLen = (size_t)ftell(JsonFile);
+      fclose(JsonFile);
+   }
+
+   return FileLen;
+
+} /* End TBLGEN_WriteMsgTbl() */
+
+
+/******************************************************************************
+** Function: TBLGEN_WriteSchTbl
+**
+*/
+size_t TBLGEN_WriteSchTbl(const char* Filename, const TBLGEN_SchTbl_t* SchTbl)
+{
+
+   size_t FileLen = 0;
+   FILE*  JsonFile;
+   uint16 Slot, Entry, Period;
+   bool   FirstActivity;
+
+   JsonFile = fopen(Filename, "w");
+   if (JsonFile != NULL)
+   {
+
+      fprintf(JsonFile, "{\"name\":\"Synthetic scheduler table\",\"slot-array\":[");
+      for (Slot=0; Slot < SCHTBL_SLOTS; Slot++)
+      {
+
+         fprintf(JsonFile, "%s{\"slot\":{\"index\":%u,\"activity-array\":[", (Slot == 0) ? "" : ",", Slot);
+
+         FirstActivity = true;
+         for (Entry=Slot; (Entry < SchTbl->EntryCnt) && (Entry < SCHTBL_MAX_ENTRIES); Entry += SCHTBL_SLOTS)
+         {
+            Period = SchTbl->Period[Entry % SchTbl->PeriodCnt];
+            fprintf(JsonFile, "%s{\"activity\":{\"index\":%u,\"enabled\":\"true\",\"period\":%u,\"offset\":%u,\"msg-idx\":%u}}",
+                    FirstActivity ? "" : ",", Entry / SCHTBL_SLOTS, Period,
+                    (Entry / SCHTBL_SLOTS) % Period, Entry % SchTbl->MsgCnt);
+            FirstActivity = false;
+         }
+
+         fprintf(JsonFile, "]}}");
+
+      } /* End slot loop */
+      fprintf(JsonFile, "],\"trigger-array\":[]}\n");
+
+      FileLen = (size_t)ftell(JsonFile);
+      fclose(JsonFile);
+   }
+
+   return FileLen;
+
+} /* End TBLGEN_WriteSchTbl() */
@@ -0,0 +1,90 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Write synthetic message and scheduler JSON tables for the host drivers
+**
+**  Notes:
+**    1. Tables use the same JSON schema as fsw/tables with the optional
+**       attributes omitted and no whitespace so the largest tables fit in
+**       the JSON file limits.
+**    2. Message N is a command with topic ID TBLGEN_BASE_TOPIC_ID + N and
+**       DataWords data words.
+**    3. Scheduler entries are spread evenly across the slots. Entry E is
+**       activity E / SCHTBL_SLOTS in slot E % SCHTBL_SLOTS and uses period
+**       Period[E % PeriodCnt], offset (E / SCHTBL_SLOTS) % period and
+**       message E % MsgCnt.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _tblgen_
+#define _tblgen_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TBLGEN_BASE_TOPIC_ID  0x1900
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint16        EntryCnt;     /* Up to SCHTBL_MAX_ENTRIES */
+   const uint8*  Period;
+   uint16        PeriodCnt;
+   uint16        MsgCnt;
+
+} TBLGEN_SchTbl_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TBLGEN_WriteMsgTbl
+**
+** Write MsgCnt message definitions starting at ID 0. Returns the file
+** length or 0 if the file couldn't be written.
+**
+*/
+size_t TBLGEN_WriteMsgTbl(const char* Filename, uint16 MsgCnt, uint16 DataWords);
+
+
+/******************************************************************************
+** Function: TBLGEN_WriteSchTbl
+**
+** Returns the file length or 0 if the file couldn't be written.
+**
+*/
+size_t TBLGEN_WriteSchTbl(const char* Filename, const TBLGEN_SchTbl_t* SchTbl);
+
+
+#endif /* _tblgen_ */
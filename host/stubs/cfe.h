@@ -0,0 +1,254 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Declare the subset of the cFE, OSAL and PSP APIs used by KIT_SCH for
+**    host builds
+**
+**  Notes:
+**    1. Only used by the host build in kit_sch/host. Flight and SIL builds
+**       use the real cFE headers.
+**    2. Types and values follow cFE Caelum with the CCSDS v1 message
+**       header. Message IDs are the CCSDS stream ID.
+**    3. The common services are implemented in hostcfe.c. The time,
+**       timer and semaphore services are implemented by a host platform,
+**       either virtplat.c (virtual time) or posixplat.c (Linux time).
+**    4. OS_time_t ticks are nanoseconds.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _cfe_
+#define _cfe_
+
+/*
+** Includes
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CFE_SUCCESS                 (0)
+#define CFE_SB_NO_MESSAGE           ((int32)0xca00000e)
+#define CFE_SB_BAD_ARGUMENT         ((int32)0xca000001)
+#define CFE_SB_PIPE_RD_ERR          ((int32)0xca00000f)
+#define CFE_SB_POLL                 (0)
+#define CFE_SB_PEND_FOREVER         (-1)
+#define CFE_SB_INVALID_MSG_ID       (0)
+#define CFE_SB_HIGHEST_VALID_MSGID  (0x1FFF)
+
+#define CFE_MSG_PTR(shared_hdr)  (&(shared_hdr).Msg)
+
+#define CFE_EVS_NO_FILTER  0
+
+#define CFE_TIME_FLAG_CLKSET  0x8000
+#define CFE_TIME_FLAG_FLYING  0x4000
+
+#define CFE_MAKE_BIG16(n)  ((((n) << 8) & 0xFF00) | (((n) >> 8) & 0x00FF))
+#define CFE_MAKE_BIG32(n)  ((((n) << 24) & 0xFF000000) | (((n) << 8) & 0x00FF0000) | (((n) >> 8) & 0x0000FF00) | (((n) >> 24) & 0x000000FF))
+
+#define OS_SUCCESS                  (0)
+#define OS_ERROR                    (-1)
+#define OS_INVALID_POINTER          (-2)
+#define OS_ERR_INVALID_ID           (-35)
+#define OS_SEM_TIMEOUT              (-29)
+#define OS_TIMER_ERR_INVALID_ARGS   (-31)
+
+#define OS_MAX_PATH_LEN   64
+#define OS_MAX_API_NAME   20
+
+#define OS_FILE_FLAG_NONE      0x00
+#define OS_FILE_FLAG_CREATE    0x01
+#define OS_FILE_FLAG_TRUNCATE  0x02
+
+#define OS_READ_ONLY   0
+#define OS_WRITE_ONLY  1
+#define OS_READ_WRITE  2
+
+#define OS_SEEK_SET  0
+#define OS_SEEK_CUR  1
+#define OS_SEEK_END  2
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef uint8_t   uint8;
+typedef uint16_t  uint16;
+typedef uint32_t  uint32;
+typedef uint64_t  uint64;
+typedef int8_t    int8;
+typedef int16_t   int16;
+typedef int32_t   int32;
+typedef int64_t   int64;
+
+typedef uint32  osal_id_t;
+typedef char    os_err_name_t[35];
+
+typedef struct
+{
+   int64 ticks;
+} OS_time_t;
+
+typedef void (*OS_TimerCallback_t)(osal_id_t TimerId);
+
+
+/*
+** Message headers. The primary header is the CCSDS v1 primary header.
+*/
+
+typedef union
+{
+   uint8  Byte[6];
+} CFE_MSG_Message_t;
+
+typedef struct
+{
+   CFE_MSG_Message_t  Msg;
+   uint8              Sec[2];    /* Function code and checksum */
+} CFE_MSG_CommandHeader_t;
+
+typedef struct
+{
+   CFE_MSG_Message_t  Msg;
+   uint8              Sec[6];    /* Seconds and upper 16 bits of subseconds */
+   uint8              Spare[4];
+} CFE_MSG_TelemetryHeader_t;
+
+typedef union
+{
+   CFE_MSG_Message_t  Msg;
+   long long int      ForceAlign;
+} CFE_SB_Buffer_t;
+
+typedef uint32  CFE_SB_MsgId_t;
+typedef uint32  CFE_SB_PipeId_t;
+typedef size_t  CFE_MSG_Size_t;
+typedef uint16  CFE_MSG_ApId_t;
+typedef uint16  CFE_MSG_SequenceCount_t;
+typedef uint8   CFE_MSG_FcnCode_t;
+
+typedef enum
+{
+   CFE_MSG_Type_Invalid,
+   CFE_MSG_Type_Cmd,
+   CFE_MSG_Type_Tlm
+} CFE_MSG_Type_t;
+
+typedef struct
+{
+   uint32  Seconds;
+   uint32  Subseconds;
+} CFE_TIME_SysTime_t;
+
+typedef void (*CFE_TIME_SynchCallbackPtr_t)(void);
+
+enum
+{
+   CFE_EVS_EventType_DEBUG = 1,
+   CFE_EVS_EventType_INFORMATION,
+   CFE_EVS_EventType_ERROR,
+   CFE_EVS_EventType_CRITICAL
+};
+
+
+/*********************************/
+/** Common Services (hostcfe.c) **/
+/*********************************/
+
+void  CFE_ES_PerfLogEntry(uint32 Marker);
+void  CFE_ES_PerfLogExit(uint32 Marker);
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...);
+
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...);
+
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+int32 CFE_SB_Unsubscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+int32 CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount);
+void  CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr);
+bool  CFE_SB_IsValidMsgId(CFE_SB_MsgId_t MsgId);
+bool  CFE_SB_MsgId_Equal(CFE_SB_MsgId_t MsgId1, CFE_SB_MsgId_t MsgId2);
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32 MsgIdValue);
+uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId);
+
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size);
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+int32 CFE_MSG_GetApId(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_ApId_t *ApId);
+int32 CFE_MSG_GetType(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Type_t *Type);
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size);
+int32 CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size);
+int32 CFE_MSG_GetSequenceCount(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_SequenceCount_t *SeqCnt);
+int32 CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode);
+int32 CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode);
+int32 CFE_MSG_GenerateChecksum(CFE_MSG_Message_t *MsgPtr);
+int32 CFE_MSG_ValidateChecksum(const CFE_MSG_Message_t *MsgPtr, bool *IsValid);
+int32 CFE_MSG_GetMsgTime(const CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t *Time);
+int32 CFE_MSG_SetMsgTime(CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t NewTime);
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void);
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2);
+uint32 CFE_TIME_Sub2MicroSecs(uint32 SubSeconds);
+uint32 CFE_TIME_Micro2SubSecs(uint32 MicroSeconds);
+uint32 CFE_TIME_GetMETsubsecs(void);
+void   CFE_TIME_Print(char *PrintBuffer, CFE_TIME_SysTime_t TimeToPrint);
+
+int32 CFE_PSP_MemCpy(void *Dest, const void *Src, uint32 Size);
+int32 CFE_PSP_MemSet(void *Dest, uint8 Value, uint32 Size);
+
+int64     OS_TimeGetTotalMicroseconds(OS_time_t Time);
+int64     OS_TimeGetTotalNanoseconds(OS_time_t Time);
+OS_time_t OS_TimeSubtract(OS_time_t Time1, OS_time_t Time2);
+
+int32 OS_OpenCreate(osal_id_t *FileId, const char *Path, int32 Flags, int32 AccessMode);
+int32 OS_read(osal_id_t FileId, void *Buffer, size_t NumBytes);
+int32 OS_write(osal_id_t FileId, const void *Buffer, size_t NumBytes);
+int32 OS_lseek(osal_id_t FileId, int32 Offset, uint32 Whence);
+int32 OS_close(osal_id_t FileId);
+int32 OS_GetErrorName(int32 ErrorNum, os_err_name_t *ErrName);
+
+
+/*******************************************/
+/** Platform Services (virtplat/posixplat) **/
+/*******************************************/
+
+CFE_TIME_SysTime_t CFE_TIME_GetMET(void);
+uint16 CFE_TIME_GetClockInfo(void);
+int32  CFE_TIME_RegisterSynchCallback(CFE_TIME_SynchCallbackPtr_t CallbackFuncPtr);
+
+void CFE_PSP_GetTime(OS_time_t *LocalTime);
+
+int32 OS_TimerCreate(osal_id_t *TimerId, const char *TimerName, uint32 *ClockAccuracy, OS_TimerCallback_t CallbackPtr);
+int32 OS_TimerSet(osal_id_t TimerId, uint32 StartTime, uint32 IntervalTime);
+
+int32 OS_BinSemCreate(osal_id_t *SemId, const char *SemName, uint32 SemInitialValue, uint32 Options);
+int32 OS_BinSemGive(osal_id_t SemId);
+int32 OS_BinSemTake(osal_id_t SemId);
+int32 OS_BinSemTimedWait(osal_id_t SemId, uint32 Msecs);
+
+
+#endif /* _cfe_ */
@@ -0,0 +1,12 @@
+/*
+** Purpose: Host build replacement for cFE's cfe_endian.h
+**
+** Notes:
+**   1. The CFE_MAKE_BIG macros are defined in cfe.h.
+*/
+#ifndef _cfe_endian_
+#define _cfe_endian_
+
+#include "cfe.h"
+
+#endif /* _cfe_endian_ */
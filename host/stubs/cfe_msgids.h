@@ -0,0 +1,17 @@
+/*
+** Purpose: Host build replacement for the mission's cfe_msgids.h
+**
+** Notes:
+**   1. KIT_SCH only uses the housekeeping request message IDs in debug
+**      output. The values match the default cFE mission configuration.
+*/
+#ifndef _cfe_msgids_
+#define _cfe_msgids_
+
+#define CFE_ES_SEND_HK_MID    0x1808
+#define CFE_EVS_SEND_HK_MID   0x1809
+#define CFE_SB_SEND_HK_MID    0x180B
+#define CFE_TBL_SEND_HK_MID   0x180C
+#define CFE_TIME_SEND_HK_MID  0x180D
+
+#endif /* _cfe_msgids_ */
@@ -0,0 +1,12 @@
+/*
+** Purpose: Host build replacement for cFE's cfe_time_msg.h
+**
+** Notes:
+**   1. The clock state flags are defined in cfe.h.
+*/
+#ifndef _cfe_time_msg_
+#define _cfe_time_msg_
+
+#include "cfe.h"
+
+#endif /* _cfe_time_msg_ */
@@ -0,0 +1,63 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Declare the subset of the OSK C Framework's CJSON used by KIT_SCH for
+**    host builds
+**
+**  Notes:
+**    1. Only used by the host build in kit_sch/host. Implemented in
+**       hostfw.c.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _cjson_
+#define _cjson_
+
+/*
+** Includes
+*/
+
+#include "osk_c_fw.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef bool (*CJSON_LoadJsonData_t)(size_t JsonFileLen);
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFile
+**
+** Read a JSON file into JsonBuf and call LoadJsonData() with its length.
+**
+** Notes:
+**   1. The file is rejected if it has MaxJsonFileChar or more characters.
+**      JsonBuf is null terminated.
+*/
+bool CJSON_ProcessFile(const char* Filename, char* JsonBuf, size_t MaxJsonFileChar,
+                       CJSON_LoadJsonData_t LoadJsonData);
+
+
+#endif /* _cjson_ */
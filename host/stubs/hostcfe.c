@@ -0,0 +1,800 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the host cFE, OSAL and PSP services that don't depend on
+**    the host platform's notion of time
+**
+**  Notes:
+**    1. See hostcfe.h for the behavior visible to the host drivers.
+**    2. Message headers are CCSDS v1 in big endian byte order so messages
+**       are binary identical to a flight build's.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "hostcfe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CCSDS_CMD_TYPE_BIT  0x1000
+#define CCSDS_APID_MASK     0x07FF
+#define CCSDS_SEQ_FLAGS     0xC000
+#define CCSDS_SEQ_CNT_MASK  0x3FFF
+
+#define MSG_FCN_CODE_BYTE   6    /* Command secondary header */
+#define MSG_CHECKSUM_BYTE   7
+#define MSG_TIME_BYTE       6    /* Telemetry secondary header */
+
+#define EVENT_STR_MAX     256
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef union
+{
+
+   CFE_SB_Buffer_t  SbBuf;
+   uint8            Byte[HOSTCFE_MAX_MSG_BYTES];
+
+} PipeMsg_t;
+
+typedef struct
+{
+
+   bool       Created;
+   uint16     Depth;
+   uint16     Head;
+   uint16     Cnt;
+   PipeMsg_t  Msg[HOSTCFE_PIPE_DEPTH];
+
+} Pipe_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static uint16 GetBig16(const uint8* Byte);
+static void   PutBig16(uint8* Byte, uint16 Value);
+static uint8  ComputeChecksum(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static HOSTCFE_Stats_t         Stats;
+static HOSTCFE_TransmitHook_t  TransmitHook = NULL;
+static uint16                  EventLevel = CFE_EVS_EventType_ERROR;
+static Pipe_t                  Pipe[HOSTCFE_MAX_PIPES];
+
+static const char* EventTypeStr[HOSTCFE_EVENT_TYPES] =
+{
+   "UNDEF", "DEBUG", "INFO", "ERROR", "CRIT"
+};
+
+
+/******************************************************************************
+** Function: HOSTCFE_Reset
+**
+*/
+void HOSTCFE_Reset(void)
+{
+
+   memset(&Stats, 0, sizeof(Stats));
+   memset(Pipe, 0, sizeof(Pipe));
+   TransmitHook = NULL;
+   EventLevel   = CFE_EVS_EventType_ERROR;
+
+} /* End HOSTCFE_Reset() */
+
+
+/******************************************************************************
+** Function: HOSTCFE_SetEventLevel
+**
+*/
+void HOSTCFE_SetEventLevel(uint16 EventType)
+{
+
+   EventLevel = EventType;
+
+} /* End HOSTCFE_SetEventLevel() */
+
+
+/******************************************************************************
+** Function: HOSTCFE_SetTransmitHook
+**
+*/
+void HOSTCFE_SetTransmitHook(HOSTCFE_TransmitHook_t Hook)
+{
+
+   TransmitHook = Hook;
+
+} /* End HOSTCFE_SetTransmitHook() */
+
+
+/******************************************************************************
+** Function: HOSTCFE_QueueMsg
+**
+*/
+bool HOSTCFE_QueueMsg(CFE_SB_PipeId_t PipeId, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   bool            RetStatus = false;
+   CFE_MSG_Size_t  Size;
+   Pipe_t*         QueuePipe;
+
+   CFE_MSG_GetSize(MsgPtr, &Size);
+
+   if ((PipeId < HOSTCFE_MAX_PIPES) && (Size <= HOSTCFE_MAX_MSG_BYTES))
+   {
+
+      QueuePipe = &Pipe[PipeId];
+      if (QueuePipe->Created && (QueuePipe->Cnt < QueuePipe->Depth))
+      {
+         memcpy(QueuePipe->Msg[(QueuePipe->Head + QueuePipe->Cnt) % HOSTCFE_PIPE_DEPTH].Byte, MsgPtr, Size);
+         QueuePipe->Cnt++;
+         RetStatus = true;
+      }
+   }
+
+   return RetStatus;
+
+} /* End HOSTCFE_QueueMsg() */
+
+
+/******************************************************************************
+** Function: HOSTCFE_GetStats
+**
+*/
+const HOSTCFE_Stats_t* HOSTCFE_GetStats(void)
+{
+
+   return &Stats;
+
+} /* End HOSTCFE_GetStats() */
+
+
+/******************************************************************************
+** Executive Services
+*/
+
+void CFE_ES_PerfLogEntry(uint32 Marker)
+{
+
+} /* End CFE_ES_PerfLogEntry() */
+
+
+void CFE_ES_PerfLogExit(uint32 Marker)
+{
+
+} /* End CFE_ES_PerfLogExit() */
+
+
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+
+   va_list  ArgPtr;
+
+   va_start(ArgPtr, SpecStringPtr);
+   vprintf(SpecStringPtr, ArgPtr);
+   va_end(ArgPtr);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_ES_WriteToSysLog() */
+
+
+/******************************************************************************
+** Event Services
+*/
+
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+
+   va_list  ArgPtr;
+   char     EventStr[EVENT_STR_MAX];
+
+   if (EventType < HOSTCFE_EVENT_TYPES)
+   {
+
+      Stats.EventCnt[EventType]++;
+      if (EventType >= CFE_EVS_EventType_ERROR)
+      {
+         Stats.LastErrEventId = EventID;
+      }
+
+      if (EventType >= EventLevel)
+      {
+         va_start(ArgPtr, Spec);
+         vsnprintf(EventStr, EVENT_STR_MAX, Spec, ArgPtr);
+         va_end(ArgPtr);
+         printf("EVS %s %u: %s\n", EventTypeStr[EventType], EventID, EventStr);
+      }
+   }
+
+   return CFE_SUCCESS;
+
+} /* End CFE_EVS_SendEvent() */
+
+
+/******************************************************************************
+** Software Bus
+*/
+
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+
+   int32 Status = CFE_SB_BAD_ARGUMENT;
+   CFE_SB_PipeId_t PipeId;
+
+   for (PipeId=0; PipeId < HOSTCFE_MAX_PIPES; PipeId++)
+   {
+      if (!Pipe[PipeId].Created)
+      {
+         memset(&Pipe[PipeId], 0, sizeof(Pipe_t));
+         Pipe[PipeId].Created = true;
+         Pipe[PipeId].Depth   = (Depth < HOSTCFE_PIPE_DEPTH) ? Depth : HOSTCFE_PIPE_DEPTH;
+         *PipeIdPtr = PipeId;
+         Status = CFE_SUCCESS;
+         break;
+      }
+   }
+
+   return Status;
+
+} /* End CFE_SB_CreatePipe() */
+
+
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+
+   return CFE_SB_IsValidMsgId(MsgId) ? CFE_SUCCESS : CFE_SB_BAD_ARGUMENT;
+
+} /* End CFE_SB_Subscribe() */
+
+
+int32 CFE_SB_Unsubscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+
+   return CFE_SB_IsValidMsgId(MsgId) ? CFE_SUCCESS : CFE_SB_BAD_ARGUMENT;
+
+} /* End CFE_SB_Unsubscribe() */
+
+
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+
+   int32   Status = CFE_SB_NO_MESSAGE;
+   Pipe_t* RcvPipe;
+
+   if (PipeId >= HOSTCFE_MAX_PIPES || !Pipe[PipeId].Created)
+   {
+      Status = CFE_SB_BAD_ARGUMENT;
+   }
+   else
+   {
+      RcvPipe = &Pipe[PipeId];
+      if (RcvPipe->Cnt > 0)
+      {
+         *BufPtr = &RcvPipe->Msg[RcvPipe->Head].SbBuf;
+         RcvPipe->Head = (RcvPipe->Head + 1) % HOSTCFE_PIPE_DEPTH;
+         RcvPipe->Cnt--;
+         Status = CFE_SUCCESS;
+      }
+   }
+
+   return Status;
+
+} /* End CFE_SB_ReceiveBuffer() */
+
+
+int32 CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount)
+{
+
+   CFE_MSG_Size_t  Size;
+   CFE_MSG_Type_t  Type;
+
+   CFE_MSG_GetSize(MsgPtr, &Size);
+   CFE_MSG_GetType(MsgPtr, &Type);
+
+   if (Type == CFE_MSG_Type_Cmd)
+   {
+      Stats.CmdMsgCnt++;
+   }
+   else
+   {
+      Stats.TlmMsgCnt++;
+   }
+   Stats.MsgBytes += Size;
+
+   if (TransmitHook != NULL)
+   {
+      TransmitHook(MsgPtr, Size);
+   }
+
+   return CFE_SUCCESS;
+
+} /* End CFE_SB_TransmitMsg() */
+
+
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr)
+{
+
+   CFE_MSG_SetMsgTime(MsgPtr, CFE_TIME_GetTime());
+
+} /* End CFE_SB_TimeStampMsg() */
+
+
+bool CFE_SB_IsValidMsgId(CFE_SB_MsgId_t MsgId)
+{
+
+   return ((MsgId != CFE_SB_INVALID_MSG_ID) && (MsgId <= CFE_SB_HIGHEST_VALID_MSGID));
+
+} /* End CFE_SB_IsValidMsgId() */
+
+
+bool CFE_SB_MsgId_Equal(CFE_SB_MsgId_t MsgId1, CFE_SB_MsgId_t MsgId2)
+{
+
+   return (MsgId1 == MsgId2);
+
+} /* End CFE_SB_MsgId_Equal() */
+
+
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32 MsgIdValue)
+{
+
+   return (CFE_SB_MsgId_t)MsgIdValue;
+
+} /* End CFE_SB_ValueToMsgId() */
+
+
+uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId)
+{
+
+   return (uint32)MsgId;
+
+} /* End CFE_SB_MsgIdToValue() */
+
+
+/******************************************************************************
+** Message Headers
+*/
+
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size)
+{
+
+   memset(MsgPtr, 0, Size);
+   PutBig16(&MsgPtr->Byte[0], (uint16)MsgId);
+   PutBig16(&MsgPtr->Byte[2], CCSDS_SEQ_FLAGS);
+
+   return CFE_MSG_SetSize(MsgPtr, Size);
+
+} /* End CFE_MSG_Init() */
+
+
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+
+   *MsgId = GetBig16(&MsgPtr->Byte[0]);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetMsgId() */
+
+
+int32 CFE_MSG_GetApId(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_ApId_t *ApId)
+{
+
+   *ApId = GetBig16(&MsgPtr->Byte[0]) & CCSDS_APID_MASK;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetApId() */
+
+
+int32 CFE_MSG_GetType(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Type_t *Type)
+{
+
+   *Type = (GetBig16(&MsgPtr->Byte[0]) & CCSDS_CMD_TYPE_BIT) ? CFE_MSG_Type_Cmd : CFE_MSG_Type_Tlm;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetType() */
+
+
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size)
+{
+
+   *Size = GetBig16(&MsgPtr->Byte[4]) + 7;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetSize() */
+
+
+int32 CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size)
+{
+
+   int32 Status = CFE_SB_BAD_ARGUMENT;
+
+   if ((Size >= 7) && (Size <= (0xFFFF + 7)))
+   {
+      PutBig16(&MsgPtr->Byte[4], (uint16)(Size - 7));
+      Status = CFE_SUCCESS;
+   }
+
+   return Status;
+
+} /* End CFE_MSG_SetSize() */
+
+
+int32 CFE_MSG_GetSequenceCount(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_SequenceCount_t *SeqCnt)
+{
+
+   *SeqCnt = GetBig16(&MsgPtr->Byte[2]) & CCSDS_SEQ_CNT_MASK;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetSequenceCount() */
+
+
+int32 CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode)
+{
+
+   *FcnCode = ((const uint8*)MsgPtr)[MSG_FCN_CODE_BYTE] & 0x7F;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetFcnCode() */
+
+
+int32 CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode)
+{
+
+   ((uint8*)MsgPtr)[MSG_FCN_CODE_BYTE] = FcnCode & 0x7F;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_SetFcnCode() */
+
+
+int32 CFE_MSG_GenerateChecksum(CFE_MSG_Message_t *MsgPtr)
+{
+
+   CFE_MSG_Size_t Size;
+
+   CFE_MSG_GetSize(MsgPtr, &Size);
+   ((uint8*)MsgPtr)[MSG_CHECKSUM_BYTE] = 0;
+   ((uint8*)MsgPtr)[MSG_CHECKSUM_BYTE] = ComputeChecksum(MsgPtr, Size);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GenerateChecksum() */
+
+
+int32 CFE_MSG_ValidateChecksum(const CFE_MSG_Message_t *MsgPtr, bool *IsValid)
+{
+
+   CFE_MSG_Size_t Size;
+
+   CFE_MSG_GetSize(MsgPtr, &Size);
+   *IsValid = (ComputeChecksum(MsgPtr, Size) == 0);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_ValidateChecksum() */
+
+
+int32 CFE_MSG_GetMsgTime(const CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t *Time)
+{
+
+   const uint8* TimeByte = (const uint8*)MsgPtr + MSG_TIME_BYTE;
+
+   Time->Seconds    = ((uint32)GetBig16(&TimeByte[0]) << 16) | GetBig16(&TimeByte[2]);
+   Time->Subseconds = (uint32)GetBig16(&TimeByte[4]) << 16;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_GetMsgTime() */
+
+
+int32 CFE_MSG_SetMsgTime(CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t NewTime)
+{
+
+   uint8* TimeByte = (uint8*)MsgPtr + MSG_TIME_BYTE;
+
+   PutBig16(&TimeByte[0], (uint16)(NewTime.Seconds >> 16));
+   PutBig16(&TimeByte[2], (uint16)NewTime.Seconds);
+   PutBig16(&TimeByte[4], (uint16)(NewTime.Subseconds >> 16));
+
+   return CFE_SUCCESS;
+
+} /* End CFE_MSG_SetMsgTime() */
+
+
+/******************************************************************************
+** Time Services
+**
+** The platform provides the MET. Spacecraft time is the MET.
+*/
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+
+   return CFE_TIME_GetMET();
+
+} /* End CFE_TIME_GetTime() */
+
+
+uint32 CFE_TIME_GetMETsubsecs(void)
+{
+
+   return CFE_TIME_GetMET().Subseconds;
+
+} /* End CFE_TIME_GetMETsubsecs() */
+
+
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2)
+{
+
+   CFE_TIME_SysTime_t Result;
+
+   Result.Subseconds = Time1.Subseconds - Time2.Subseconds;
+   Result.Seconds    = Time1.Seconds - Time2.Seconds;
+   if (Result.Subseconds > Time1.Subseconds)
+   {
+      Result.Seconds--;
+   }
+
+   return Result;
+
+} /* End CFE_TIME_Subtract() */
+
+
+uint32 CFE_TIME_Sub2MicroSecs(uint32 SubSeconds)
+{
+
+   return (uint32)(((uint64)SubSeconds * 1000000) >> 32);
+
+} /* End CFE_TIME_Sub2MicroSecs() */
+
+
+/*
+** Rounded up so CFE_TIME_Sub2MicroSecs() returns the same microseconds
+*/
+uint32 CFE_TIME_Micro2SubSecs(uint32 MicroSeconds)
+{
+
+   uint32 SubSeconds = 0xFFFFFFFF;
+
+   if (MicroSeconds < 1000000)
+   {
+      SubSeconds = (uint32)((((uint64)MicroSeconds << 32) + 999999) / 1000000);
+   }
+
+   return SubSeconds;
+
+} /* End CFE_TIME_Micro2SubSecs() */
+
+
+void CFE_TIME_Print(char *PrintBuffer, CFE_TIME_SysTime_t TimeToPrint)
+{
+
+   uint32 Days = TimeToPrint.Seconds / 86400;
+   uint32 Secs = TimeToPrint.Seconds % 86400;
+
+   sprintf(PrintBuffer, "%04u-%03u-%02u:%02u:%02u.%05u", (unsigned)(1980 + Days/365), (unsigned)(Days%365 + 1),
+           (unsigned)(Secs/3600), (unsigned)((Secs/60)%60), (unsigned)(Secs%60),
+           (unsigned)(CFE_TIME_Sub2MicroSecs(TimeToPrint.Subseconds)/10));
+
+} /* End CFE_TIME_Print() */
+
+
+/******************************************************************************
+** PSP and OSAL
+*/
+
+int32 CFE_PSP_MemCpy(void *Dest, const void *Src, uint32 Size)
+{
+
+   memcpy(Dest, Src, Size);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_PSP_MemCpy() */
+
+
+int32 CFE_PSP_MemSet(void *Dest, uint8 Value, uint32 Size)
+{
+
+   memset(Dest, Value, Size);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_PSP_MemSet() */
+
+
+int64 OS_TimeGetTotalMicroseconds(OS_time_t Time)
+{
+
+   return Time.ticks / 1000;
+
+} /* End OS_TimeGetTotalMicroseconds() */
+
+
+int64 OS_TimeGetTotalNanoseconds(OS_time_t Time)
+{
+
+   return Time.ticks;
+
+} /* End OS_TimeGetTotalNanoseconds() */
+
+
+OS_time_t OS_TimeSubtract(OS_time_t Time1, OS_time_t Time2)
+{
+
+   OS_time_t Result;
+
+   Result.ticks = Time1.ticks - Time2.ticks;
+
+   return Result;
+
+} /* End OS_TimeSubtract() */
+
+
+/*
+** File IDs are the host file descriptor plus one so they're never zero
+*/
+int32 OS_OpenCreate(osal_id_t *FileId, const char *Path, int32 Flags, int32 AccessMode)
+{
+
+   int32 Status = OS_ERROR;
+   int   OpenFlags;
+   int   Fd;
+
+   OpenFlags = (AccessMode == OS_READ_ONLY) ? O_RDONLY : ((AccessMode == OS_WRITE_ONLY) ? O_WRONLY : O_RDWR);
+   if (Flags & OS_FILE_FLAG_CREATE)
+   {
+      OpenFlags |= O_CREAT;
+   }
+   if (Flags & OS_FILE_FLAG_TRUNCATE)
+   {
+      OpenFlags |= O_TRUNC;
+   }
+
+   Fd = open(Path, OpenFlags, 0644);
+   if (Fd >= 0)
+   {
+      *FileId = (osal_id_t)(Fd + 1);
+      Status  = OS_SUCCESS;
+   }
+
+   return Status;
+
+} /* End OS_OpenCreate() */
+
+
+int32 OS_read(osal_id_t FileId, void *Buffer, size_t NumBytes)
+{
+
+   ssize_t ReadLen = read((int)FileId - 1, Buffer, NumBytes);
+
+   return (ReadLen < 0) ? OS_ERROR : (int32)ReadLen;
+
+} /* End OS_read() */
+
+
+int32 OS_write(osal_id_t FileId, const void *Buffer, size_t NumBytes)
+{
+
+   ssize_t WriteLen = write((int)FileId - 1, Buffer, NumBytes);
+
+   return (WriteLen < 0) ? OS_ERROR : (int32)WriteLen;
+
+} /* End OS_write() */
+
+
+int32 OS_lseek(osal_id_t FileId, int32 Offset, uint32 Whence)
+{
+
+   off_t Pos = lseek((int)FileId - 1, Offset, (Whence == OS_SEEK_CUR) ? SEEK_CUR :
+                                              ((Whence == OS_SEEK_END) ? SEEK_END : SEEK_SET));
+
+   return (Pos < 0) ? OS_ERROR : (int32)Pos;
+
+} /* End OS_lseek() */
+
+
+int32 OS_close(osal_id_t FileId)
+{
+
+   return (close((int)FileId - 1) == 0) ? OS_SUCCESS : OS_ERROR;
+
+} /* End OS_close() */
+
+
+int32 OS_GetErrorName(int32 ErrorNum, os_err_name_t *ErrName)
+{
+
+   snprintf(*ErrName, sizeof(os_err_name_t), "OS_ERROR(%d)", (int)ErrorNum);
+
+   return OS_SUCCESS;
+
+} /* End OS_GetErrorName() */
+
+
+/******************************************************************************
+** Function: GetBig16
+**
+*/
+static uint16 GetBig16(const uint8* Byte)
+{
+
+   return (uint16)((Byte[0] << 8) | Byte[1]);
+
+} /* End GetBig16() */
+
+
+/******************************************************************************
+** Function: PutBig16
+**
+*/
+static void PutBig16(uint8* Byte, uint16 Value)
+{
+
+   Byte[0] = (uint8)(Value >> 8);
+   Byte[1] = (uint8)Value;
+
+} /* End PutBig16() */
+
+
+/******************************************************************************
+** Function: ComputeChecksum
+**
+** Return the XOR of 0xFF and every byte in the message. A message with a
+** valid checksum returns 0.
+*/
+static uint8 ComputeChecksum(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size)
+{
+
+   const uint8*   Byte = (const uint8*)MsgPtr;
+   uint8          Checksum = 0xFF;
+   CFE_MSG_Size_t i;
+
+   for (i=0; i < Size; i++)
+   {
+      Checksum ^= Byte[i];
+   }
+
+   return Checksum;
+
+} /* End ComputeChecksum() */
@@ -0,0 +1,125 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Control and observe the host cFE services used by the host drivers
+**
+**  Notes:
+**    1. Events are counted by type and only events at or above the print
+**       level are formatted and written to stdout. The default level is
+**       CFE_EVS_EventType_ERROR.
+**    2. Transmitted messages are counted and passed to an optional hook.
+**       Nothing is routed to subscribers.
+**    3. Each pipe has a FIFO of HOSTCFE_PIPE_DEPTH messages that the
+**       drivers fill with HOSTCFE_QueueMsg(). Subscriptions aren't
+**       checked.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _hostcfe_
+#define _hostcfe_
+
+/*
+** Includes
+*/
+
+#include "cfe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define HOSTCFE_MAX_PIPES       4
+#define HOSTCFE_PIPE_DEPTH     16
+#define HOSTCFE_MAX_MSG_BYTES 256
+
+#define HOSTCFE_EVENT_TYPES  (CFE_EVS_EventType_CRITICAL + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef void (*HOSTCFE_TransmitHook_t)(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size);
+
+typedef struct
+{
+
+   uint32  EventCnt[HOSTCFE_EVENT_TYPES];
+   uint16  LastErrEventId;
+
+   uint32  CmdMsgCnt;
+   uint32  TlmMsgCnt;
+   uint64  MsgBytes;
+
+} HOSTCFE_Stats_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: HOSTCFE_Reset
+**
+** Clear the statistics and pipes, remove the transmit hook and restore the
+** default event print level.
+**
+*/
+void HOSTCFE_Reset(void);
+
+
+/******************************************************************************
+** Function: HOSTCFE_SetEventLevel
+**
+** Events of this type or higher are written to stdout. Use
+** HOSTCFE_EVENT_TYPES to print nothing.
+**
+*/
+void HOSTCFE_SetEventLevel(uint16 EventType);
+
+
+/******************************************************************************
+** Function: HOSTCFE_SetTransmitHook
+**
+** Hook is called with each message passed to CFE_SB_TransmitMsg(). Use
+** NULL to remove the hook.
+**
+*/
+void HOSTCFE_SetTransmitHook(HOSTCFE_TransmitHook_t Hook);
+
+
+/******************************************************************************
+** Function: HOSTCFE_QueueMsg
+**
+** Copy a message into a pipe so CFE_SB_ReceiveBuffer() returns it. Returns
+** false if the pipe doesn't exist, is full or the message is too long.
+**
+*/
+bool HOSTCFE_QueueMsg(CFE_SB_PipeId_t PipeId, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: HOSTCFE_GetStats
+**
+*/
+const HOSTCFE_Stats_t* HOSTCFE_GetStats(void);
+
+
+#endif /* _hostcfe_ */
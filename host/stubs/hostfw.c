@@ -0,0 +1,244 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the OSK C Framework services used by KIT_SCH for host builds
+**
+**  Notes:
+**    1. INITBL uses KIT_SCH's JSON walker to read the init file so the
+**       host build doesn't need the framework's JSON library.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "cjson.h"
+#include "app_cfg.h"
+#include "jsonwalk.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define INITBL_FILE_MAX_CHAR  8192
+
+#define CFG_NAME(Name,Type)  #Name,
+#define CFG_TYPE(Name,Type)  #Type,
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static size_t ReadFile(const char* Filename, char* Buf, size_t MaxChar);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static const char* CfgName[] = { "", APP_CONFIG(CFG_NAME) };
+static const char* CfgType[] = { "", APP_CONFIG(CFG_TYPE) };
+
+
+/******************************************************************************
+** Function: CMDMGR_BoolStr
+**
+*/
+const char* CMDMGR_BoolStr(bool BoolArg)
+{
+
+   return BoolArg ? "true" : "false";
+
+} /* End CMDMGR_BoolStr() */
+
+
+/******************************************************************************
+** Function: CMDMGR_ValidBoolArg
+**
+*/
+bool CMDMGR_ValidBoolArg(uint16 BoolArg)
+{
+
+   return ((BoolArg == true) || (BoolArg == false));
+
+} /* End CMDMGR_ValidBoolArg() */
+
+
+/******************************************************************************
+** Function: INITBL_Constructor
+**
+*/
+bool INITBL_Constructor(INITBL_Class_t* IniTbl, const char* IniFile)
+{
+
+   bool   RetStatus = false;
+   char*  JsonBuf;
+   size_t JsonLen;
+   int    IntValue;
+   uint16 Cfg;
+   JSONWALK_Cursor_t JsonRoot;
+   JSONWALK_Cursor_t JsonConfig;
+
+   memset(IniTbl, 0, sizeof(INITBL_Class_t));
+
+   JsonBuf = malloc(INITBL_FILE_MAX_CHAR);
+   JsonLen = ReadFile(IniFile, JsonBuf, INITBL_FILE_MAX_CHAR);
+
+   JSONWALK_Init(&JsonRoot, JsonBuf, JsonLen);
+   if ((JsonLen > 0) && (Config_END_ <= INITBL_MAX_CFG_ITEMS) &&
+       JSONWALK_GetMember(&JsonRoot, "config", &JsonConfig))
+   {
+
+      RetStatus = true;
+      for (Cfg=Config_START_+1; Cfg < Config_END_; Cfg++)
+      {
+
+         if (strcmp(CfgType[Cfg], "char*") == 0)
+         {
+            if (!JSONWALK_GetStr(&JsonConfig, CfgName[Cfg], IniTbl->StrCfg[Cfg], OS_MAX_PATH_LEN))
+            {
+               RetStatus = false;
+            }
+         }
+         else
+         {
+            if (JSONWALK_GetInt(&JsonConfig, CfgName[Cfg], &IntValue))
+            {
+               IniTbl->IntCfg[Cfg] = (uint32)IntValue;
+            }
+            else
+            {
+               RetStatus = false;
+            }
+         }
+
+         if (!RetStatus)
+         {
+            printf("INITBL: %s is missing or invalid in %s\n", CfgName[Cfg], IniFile);
+            break;
+         }
+
+      } /* End config loop */
+
+      IniTbl->CfgCnt = Config_END_ - 1;
+
+   } /* End if config object */
+   else
+   {
+      printf("INITBL: Unable to read the config object from %s\n", IniFile);
+   }
+
+   free(JsonBuf);
+
+   return RetStatus;
+
+} /* End INITBL_Constructor() */
+
+
+/******************************************************************************
+** Function: INITBL_GetIntConfig
+**
+*/
+uint32 INITBL_GetIntConfig(const INITBL_Class_t* IniTbl, uint16 Param)
+{
+
+   return (Param < INITBL_MAX_CFG_ITEMS) ? IniTbl->IntCfg[Param] : 0;
+
+} /* End INITBL_GetIntConfig() */
+
+
+/******************************************************************************
+** Function: INITBL_GetStrConfig
+**
+*/
+const char* INITBL_GetStrConfig(const INITBL_Class_t* IniTbl, uint16 Param)
+{
+
+   return (Param < INITBL_MAX_CFG_ITEMS) ? IniTbl->StrCfg[Param] : "";
+
+} /* End INITBL_GetStrConfig() */
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFile
+**
+*/
+bool CJSON_ProcessFile(const char* Filename, char* JsonBuf, size_t MaxJsonFileChar,
+                       CJSON_LoadJsonData_t LoadJsonData)
+{
+
+   bool   RetStatus = false;
+   size_t JsonLen;
+
+   JsonLen = ReadFile(Filename, JsonBuf, MaxJsonFileChar);
+
+   if (JsonLen > 0)
+   {
+      RetStatus = LoadJsonData(JsonLen);
+   }
+
+   return RetStatus;
+
+} /* End CJSON_ProcessFile() */
+
+
+/******************************************************************************
+** Function: ReadFile
+**
+** Read a file into a null terminated buffer and return its length.
+**
+** Notes:
+**   1. Returns 0 if the file can't be read or if it has MaxChar or more
+**      characters.
+*/
+static size_t ReadFile(const char* Filename, char* Buf, size_t MaxChar)
+{
+
+   size_t     FileLen = 0;
+   int32      ReadLen;
+   osal_id_t  FileHandle;
+
+   if (OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) == OS_SUCCESS)
+   {
+
+      ReadLen = OS_read(FileHandle, Buf, MaxChar);
+      OS_close(FileHandle);
+
+      if ((ReadLen > 0) && ((size_t)ReadLen < MaxChar))
+      {
+         Buf[ReadLen] = '\0';
+         FileLen = (size_t)ReadLen;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(0, CFE_EVS_EventType_ERROR, "CJSON: %s is empty or exceeds %u characters",
+                           Filename, (unsigned)(MaxChar-1));
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(0, CFE_EVS_EventType_ERROR, "CJSON: Unable to open %s", Filename);
+   }
+
+   return FileLen;
+
+} /* End ReadFile() */
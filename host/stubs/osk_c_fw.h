@@ -0,0 +1,120 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Declare the subset of the OSK C Framework used by KIT_SCH for host
+**    builds
+**
+**  Notes:
+**    1. Only used by the host build in kit_sch/host. Implemented in
+**       hostfw.c.
+**    2. INITBL reads the "config" object of KIT_SCH's JSON init file. The
+**       configuration names and types come from app_cfg.h's APP_CONFIG.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _osk_c_fw_
+#define _osk_c_fw_
+
+/*
+** Includes
+*/
+
+#include "cfe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define OSK_C_FW_APP_BASE_EID  0
+#define OSK_C_FW_CFS_ERROR     (-1)
+
+#define CMDMGR_NOOP_CMD_FC     0
+#define CMDMGR_RESET_CMD_FC    1
+#define CMDMGR_APP_START_FC   10
+
+#define PKTUTIL_CMD_HDR_BYTES  (sizeof(CFE_MSG_CommandHeader_t))
+
+#define TBLMGR_STATUS_UNDEF    0
+#define TBLMGR_STATUS_VALID    1
+#define TBLMGR_STATUS_INVALID  2
+
+#define TBLMGR_LOAD_TBL_REPLACE  0
+#define TBLMGR_LOAD_TBL_UPDATE   1
+
+#define INITBL_MAX_CFG_ITEMS  32
+
+/*
+** Configuration enumerations. DECLARE_ENUM() creates the enumeration with
+** the first item equal to 1 so 0 is never a valid configuration.
+*/
+
+#define OSK_C_FW_ENUM_ITEM(Name,Type)  Name,
+#define DECLARE_ENUM(EnumName,EnumDef) \
+   typedef enum { EnumName##_START_ = 0, EnumDef(OSK_C_FW_ENUM_ITEM) EnumName##_END_ } EnumName##_Enum_t;
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef bool (*CMDMGR_CmdFuncPtr_t)(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+typedef struct
+{
+   uint8  LastAction;
+} TBLMGR_Tbl_t;
+
+typedef bool (*TBLMGR_LoadTblFuncPtr_t)(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
+typedef bool (*TBLMGR_DumpTblFuncPtr_t)(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename);
+
+typedef struct
+{
+
+   uint16  CfgCnt;
+   uint32  IntCfg[INITBL_MAX_CFG_ITEMS];
+   char    StrCfg[INITBL_MAX_CFG_ITEMS][OS_MAX_PATH_LEN];
+
+} INITBL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+const char* CMDMGR_BoolStr(bool BoolArg);
+bool CMDMGR_ValidBoolArg(uint16 BoolArg);
+
+
+/******************************************************************************
+** Function: INITBL_Constructor
+**
+** Read the JSON init file's configuration items into IniTbl.
+**
+** Notes:
+**   1. Returns false if the file can't be read or any APP_CONFIG item is
+**      missing.
+*/
+bool INITBL_Constructor(INITBL_Class_t* IniTbl, const char* IniFile);
+
+
+uint32 INITBL_GetIntConfig(const INITBL_Class_t* IniTbl, uint16 Param);
+const char* INITBL_GetStrConfig(const INITBL_Class_t* IniTbl, uint16 Param);
+
+
+#endif /* _osk_c_fw_ */
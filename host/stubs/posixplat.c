@@ -0,0 +1,653 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the real time POSIX host platform
+**
+**  Notes:
+**    1. See posixplat.h for the time, timer and tone models.
+**    2. Timer and semaphore IDs are their table index plus one so they're
+**       never zero.
+**    3. Timer expiries are absolute CLOCK_MONOTONIC times so a periodic
+**       timer's callback latency doesn't accumulate.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <time.h>
+#include "posixplat.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TIME_NEVER    UINT64_MAX
+#define NANOS_PER_SEC 1000000000ULL
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   bool                Created;
+   osal_id_t           Id;
+   OS_TimerCallback_t  Callback;
+   uint64              ExpiryNs;     /* TIME_NEVER if not armed */
+   uint64              IntervalNs;   /* 0 for one-shot */
+   pthread_t           Thread;
+   pthread_mutex_t     Mutex;
+   pthread_cond_t      Cond;
+
+} Timer_t;
+
+typedef struct
+{
+
+   bool             Created;
+   bool             Given;
+   pthread_mutex_t  Mutex;
+   pthread_cond_t   Cond;
+
+} Sem_t;
+
+typedef struct
+{
+
+   POSIXPLAT_Config_t  Config;
+   POSIXPLAT_Stats_t   Stats;
+
+   volatile bool  Stop;
+   uint64         StartNs;
+
+   bool       ToneStarted;
+   pthread_t  ToneThread;
+   volatile CFE_TIME_SynchCallbackPtr_t  SynchCallback;
+
+   Timer_t  Timer[POSIXPLAT_MAX_TIMERS];
+   Sem_t    Sem[POSIXPLAT_MAX_SEMS];
+
+} POSIXPLAT_Class_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static void*  TimerThread(void* Arg);
+static void*  ToneThread(void* Arg);
+static void   InitCond(pthread_cond_t* Cond);
+static uint64 MonotonicNs(void);
+static void   AbsTime(uint64 Ns, struct timespec* Time);
+static Sem_t* GetSem(osal_id_t SemId);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static POSIXPLAT_Class_t  PosixPlat;
+
+/* Inclusive upper limits of the histogram bins, the last bin is unbounded */
+static const uint32 HistBinLimUs[POSIXPLAT_HIST_BINS-1] =
+{
+   10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000
+};
+
+
+/******************************************************************************
+** Function: POSIXPLAT_Start
+**
+*/
+bool POSIXPLAT_Start(const POSIXPLAT_Config_t* Config)
+{
+
+   bool RetStatus = true;
+
+   memset(&PosixPlat, 0, sizeof(POSIXPLAT_Class_t));
+   PosixPlat.Config  = *Config;
+   PosixPlat.StartNs = MonotonicNs();
+
+   if (Config->ToneEnabled)
+   {
+      PosixPlat.ToneStarted = (pthread_create(&PosixPlat.ToneThread, NULL, ToneThread, NULL) == 0);
+      RetStatus = PosixPlat.ToneStarted;
+   }
+
+   return RetStatus;
+
+} /* End POSIXPLAT_Start() */
+
+
+/******************************************************************************
+** Function: POSIXPLAT_Stop
+**
+*/
+void POSIXPLAT_Stop(void)
+{
+
+   uint16 i;
+
+   PosixPlat.Stop = true;
+
+   for (i=0; i < POSIXPLAT_MAX_TIMERS; i++)
+   {
+      if (PosixPlat.Timer[i].Created)
+      {
+         pthread_mutex_lock(&PosixPlat.Timer[i].Mutex);
+         pthread_cond_signal(&PosixPlat.Timer[i].Cond);
+         pthread_mutex_unlock(&PosixPlat.Timer[i].Mutex);
+         pthread_join(PosixPlat.Timer[i].Thread, NULL);
+         PosixPlat.Timer[i].Created = false;
+      }
+   }
+
+   if (PosixPlat.ToneStarted)
+   {
+      pthread_join(PosixPlat.ToneThread, NULL);
+      PosixPlat.ToneStarted = false;
+   }
+
+} /* End POSIXPLAT_Stop() */
+
+
+/******************************************************************************
+** Function: POSIXPLAT_ConfigThread
+**
+*/
+bool POSIXPLAT_ConfigThread(int32 Priority)
+{
+
+   bool RetStatus = true;
+   struct sched_param  Param;
+   cpu_set_t           CpuSet;
+
+   if (Priority > 0)
+   {
+      memset(&Param, 0, sizeof(Param));
+      Param.sched_priority = Priority;
+      if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &Param) != 0)
+      {
+         RetStatus = false;
+      }
+   }
+
+   if (PosixPlat.Config.Cpu >= 0)
+   {
+      CPU_ZERO(&CpuSet);
+      CPU_SET(PosixPlat.Config.Cpu, &CpuSet);
+      if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &CpuSet) != 0)
+      {
+         RetStatus = false;
+      }
+   }
+
+   if (!RetStatus)
+   {
+      __atomic_fetch_add(&PosixPlat.Stats.RtConfigFailures, 1, __ATOMIC_RELAXED);
+   }
+
+   return RetStatus;
+
+} /* End POSIXPLAT_ConfigThread() */
+
+
+/******************************************************************************
+** Function: POSIXPLAT_NowUs
+**
+*/
+uint64 POSIXPLAT_NowUs(void)
+{
+
+   return (MonotonicNs() - PosixPlat.StartNs) / 1000;
+
+} /* End POSIXPLAT_NowUs() */
+
+
+/******************************************************************************
+** Function: POSIXPLAT_HistAdd
+**
+*/
+void POSIXPLAT_HistAdd(POSIXPLAT_Hist_t* Hist, int64 ValueUs)
+{
+
+   uint64 AbsUs = (ValueUs < 0) ? -ValueUs : ValueUs;
+   uint16 Bin;
+
+   for (Bin=0; (Bin < POSIXPLAT_HIST_BINS-1) && (AbsUs > HistBinLimUs[Bin]); Bin++);
+   Hist->Bin[Bin]++;
+
+   if ((Hist->Samples == 0) || (ValueUs < Hist->MinUs))
+   {
+      Hist->MinUs = ValueUs;
+   }
+   if ((Hist->Samples == 0) || (ValueUs > Hist->MaxUs))
+   {
+      Hist->MaxUs = ValueUs;
+   }
+   Hist->SumUs += ValueUs;
+   Hist->Samples++;
+
+} /* End POSIXPLAT_HistAdd() */
+
+
+/******************************************************************************
+** Function: POSIXPLAT_HistBinLimUs
+**
+*/
+uint32 POSIXPLAT_HistBinLimUs(uint16 Bin)
+{
+
+   return (Bin < POSIXPLAT_HIST_BINS-1) ? HistBinLimUs[Bin] : 0;
+
+} /* End POSIXPLAT_HistBinLimUs() */
+
+
+/******************************************************************************
+** Function: POSIXPLAT_GetStats
+**
+*/
+const POSIXPLAT_Stats_t* POSIXPLAT_GetStats(void)
+{
+
+   return &PosixPlat.Stats;
+
+} /* End POSIXPLAT_GetStats() */
+
+
+/******************************************************************************
+** Time Services
+*/
+
+CFE_TIME_SysTime_t CFE_TIME_GetMET(void)
+{
+
+   CFE_TIME_SysTime_t Met;
+   uint64 NowUs = POSIXPLAT_NowUs();
+
+   Met.Seconds    = (uint32)(NowUs / POSIXPLAT_MICROS_PER_SEC);
+   Met.Subseconds = CFE_TIME_Micro2SubSecs((uint32)(NowUs % POSIXPLAT_MICROS_PER_SEC));
+
+   return Met;
+
+} /* End CFE_TIME_GetMET() */
+
+
+uint16 CFE_TIME_GetClockInfo(void)
+{
+
+   return CFE_TIME_FLAG_CLKSET;
+
+} /* End CFE_TIME_GetClockInfo() */
+
+
+int32 CFE_TIME_RegisterSynchCallback(CFE_TIME_SynchCallbackPtr_t CallbackFuncPtr)
+{
+
+   PosixPlat.SynchCallback = CallbackFuncPtr;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_TIME_RegisterSynchCallback() */
+
+
+void CFE_PSP_GetTime(OS_time_t *LocalTime)
+{
+
+   LocalTime->ticks = (int64)MonotonicNs();
+
+} /* End CFE_PSP_GetTime() */
+
+
+/******************************************************************************
+** Timers
+*/
+
+int32 OS_TimerCreate(osal_id_t *TimerId, const char *TimerName, uint32 *ClockAccuracy, OS_TimerCallback_t CallbackPtr)
+{
+
+   int32    Status = OS_ERROR;
+   Timer_t* Timer;
+   struct timespec Res;
+   uint16   i;
+
+   for (i=0; i < POSIXPLAT_MAX_TIMERS; i++)
+   {
+      if (!PosixPlat.Timer[i].Created)
+      {
+
+         Timer = &PosixPlat.Timer[i];
+         Timer->Id         = i + 1;
+         Timer->Callback   = CallbackPtr;
+         Timer->ExpiryNs   = TIME_NEVER;
+         Timer->IntervalNs = 0;
+         pthread_mutex_init(&Timer->Mutex, NULL);
+         InitCond(&Timer->Cond);
+
+         if (pthread_create(&Timer->Thread, NULL, TimerThread, Timer) == 0)
+         {
+            clock_getres(CLOCK_MONOTONIC, &Res);
+            Timer->Created = true;
+            *TimerId       = Timer->Id;
+            *ClockAccuracy = (uint32)((Res.tv_sec * NANOS_PER_SEC + Res.tv_nsec + 999) / 1000);
+            Status = OS_SUCCESS;
+         }
+         break;
+      }
+   }
+
+   return Status;
+
+} /* End OS_TimerCreate() */
+
+
+int32 OS_TimerSet(osal_id_t TimerId, uint32 StartTime, uint32 IntervalTime)
+{
+
+   int32    Status = OS_ERR_INVALID_ID;
+   Timer_t* Timer;
+
+   if ((TimerId > 0) && (TimerId <= POSIXPLAT_MAX_TIMERS) && PosixPlat.Timer[TimerId-1].Created)
+   {
+
+      Timer  = &PosixPlat.Timer[TimerId-1];
+      Status = OS_SUCCESS;
+
+      pthread_mutex_lock(&Timer->Mutex);
+      if (StartTime == 0)
+      {
+         Timer->ExpiryNs = TIME_NEVER;
+      }
+      else
+      {
+         Timer->ExpiryNs   = MonotonicNs() + (uint64)StartTime * 1000;
+         Timer->IntervalNs = (uint64)IntervalTime * 1000;
+      }
+      pthread_cond_signal(&Timer->Cond);
+      pthread_mutex_unlock(&Timer->Mutex);
+   }
+
+   return Status;
+
+} /* End OS_TimerSet() */
+
+
+/******************************************************************************
+** Binary Semaphores
+*/
+
+int32 OS_BinSemCreate(osal_id_t *SemId, const char *SemName, uint32 SemInitialValue, uint32 Options)
+{
+
+   int32  Status = OS_ERROR;
+   uint16 i;
+
+   for (i=0; i < POSIXPLAT_MAX_SEMS; i++)
+   {
+      if (!PosixPlat.Sem[i].Created)
+      {
+         pthread_mutex_init(&PosixPlat.Sem[i].Mutex, NULL);
+         InitCond(&PosixPlat.Sem[i].Cond);
+         PosixPlat.Sem[i].Given   = (SemInitialValue != 0);
+         PosixPlat.Sem[i].Created = true;
+         *SemId = i + 1;
+         Status = OS_SUCCESS;
+         break;
+      }
+   }
+
+   return Status;
+
+} /* End OS_BinSemCreate() */
+
+
+int32 OS_BinSemGive(osal_id_t SemId)
+{
+
+   int32  Status = OS_ERR_INVALID_ID;
+   Sem_t* Sem = GetSem(SemId);
+
+   if (Sem != NULL)
+   {
+      pthread_mutex_lock(&Sem->Mutex);
+      Sem->Given = true;
+      pthread_cond_signal(&Sem->Cond);
+      pthread_mutex_unlock(&Sem->Mutex);
+      Status = OS_SUCCESS;
+   }
+
+   return Status;
+
+} /* End OS_BinSemGive() */
+
+
+int32 OS_BinSemTake(osal_id_t SemId)
+{
+
+   int32  Status = OS_ERR_INVALID_ID;
+   Sem_t* Sem = GetSem(SemId);
+
+   if (Sem != NULL)
+   {
+      pthread_mutex_lock(&Sem->Mutex);
+      while (!Sem->Given)
+      {
+         pthread_cond_wait(&Sem->Cond, &Sem->Mutex);
+      }
+      Sem->Given = false;
+      pthread_mutex_unlock(&Sem->Mutex);
+      Status = OS_SUCCESS;
+   }
+
+   return Status;
+
+} /* End OS_BinSemTake() */
+
+
+int32 OS_BinSemTimedWait(osal_id_t SemId, uint32 Msecs)
+{
+
+   int32  Status = OS_ERR_INVALID_ID;
+   Sem_t* Sem = GetSem(SemId);
+   struct timespec Timeout;
+   int    WaitStatus = 0;
+
+   if (Sem != NULL)
+   {
+      AbsTime(MonotonicNs() + (uint64)Msecs * 1000000, &Timeout);
+      pthread_mutex_lock(&Sem->Mutex);
+      while (!Sem->Given && (WaitStatus != ETIMEDOUT))
+      {
+         WaitStatus = pthread_cond_timedwait(&Sem->Cond, &Sem->Mutex, &Timeout);
+      }
+      Status = Sem->Given ? OS_SUCCESS : OS_SEM_TIMEOUT;
+      Sem->Given = false;
+      pthread_mutex_unlock(&Sem->Mutex);
+   }
+
+   return Status;
+
+} /* End OS_BinSemTimedWait() */
+
+
+/******************************************************************************
+** Function: TimerThread
+**
+** Wait for the timer's expiry, record its lateness and call its callback.
+**
+** Notes:
+**   1. The next expiry is set before the callback so the callback can
+**      rearm the timer. The callback is called without the mutex held.
+*/
+static void* TimerThread(void* Arg)
+{
+
+   Timer_t* Timer = (Timer_t*)Arg;
+   struct timespec Expiry;
+   uint64   NowNs;
+   uint64   LatencyNs;
+
+   POSIXPLAT_ConfigThread(PosixPlat.Config.Priority);
+
+   pthread_mutex_lock(&Timer->Mutex);
+   while (!PosixPlat.Stop)
+   {
+
+      if (Timer->ExpiryNs == TIME_NEVER)
+      {
+         pthread_cond_wait(&Timer->Cond, &Timer->Mutex);
+      }
+      else
+      {
+         AbsTime(Timer->ExpiryNs, &Expiry);
+         pthread_cond_timedwait(&Timer->Cond, &Timer->Mutex, &Expiry);
+
+         NowNs = MonotonicNs();
+         if (!PosixPlat.Stop && (Timer->ExpiryNs != TIME_NEVER) && (NowNs >= Timer->ExpiryNs))
+         {
+
+            LatencyNs = NowNs - Timer->ExpiryNs;
+            Timer->ExpiryNs = (Timer->IntervalNs == 0) ? TIME_NEVER : (Timer->ExpiryNs + Timer->IntervalNs);
+            PosixPlat.Stats.TimerExpiries++;
+            POSIXPLAT_HistAdd(&PosixPlat.Stats.TickLatency, (int64)(LatencyNs / 1000));
+
+            pthread_mutex_unlock(&Timer->Mutex);
+            Timer->Callback(Timer->Id);
+            pthread_mutex_lock(&Timer->Mutex);
+
+         } /* End if expired */
+      }
+
+   } /* End while not stopped */
+   pthread_mutex_unlock(&Timer->Mutex);
+
+   return NULL;
+
+} /* End TimerThread() */
+
+
+/******************************************************************************
+** Function: ToneThread
+**
+** Call the synch callback at each MET second.
+*/
+static void* ToneThread(void* Arg)
+{
+
+   struct timespec ToneTime;
+   uint64 ToneNs = PosixPlat.StartNs;
+
+   POSIXPLAT_ConfigThread(PosixPlat.Config.Priority);
+
+   while (!PosixPlat.Stop)
+   {
+
+      ToneNs += NANOS_PER_SEC;
+      AbsTime(ToneNs, &ToneTime);
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ToneTime, NULL) == EINTR);
+
+      if (!PosixPlat.Stop)
+      {
+         PosixPlat.Stats.Tones++;
+         if (PosixPlat.SynchCallback != NULL)
+         {
+            PosixPlat.SynchCallback();
+         }
+      }
+
+   } /* End while not stopped */
+
+   return NULL;
+
+} /* End ToneThread() */
+
+
+/******************************************************************************
+** Function: InitCond
+**
+** Initialize a condition variable whose timed waits use CLOCK_MONOTONIC.
+*/
+static void InitCond(pthread_cond_t* Cond)
+{
+
+   pthread_condattr_t Attr;
+
+   pthread_condattr_init(&Attr);
+   pthread_condattr_setclock(&Attr, CLOCK_MONOTONIC);
+   pthread_cond_init(Cond, &Attr);
+   pthread_condattr_destroy(&Attr);
+
+} /* End InitCond() */
+
+
+/******************************************************************************
+** Function: MonotonicNs
+**
+*/
+static uint64 MonotonicNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64)Now.tv_sec * NANOS_PER_SEC + Now.tv_nsec;
+
+} /* End MonotonicNs() */
+
+
+/******************************************************************************
+** Function: AbsTime
+**
+*/
+static void AbsTime(uint64 Ns, struct timespec* Time)
+{
+
+   Time->tv_sec  = (time_t)(Ns / NANOS_PER_SEC);
+   Time->tv_nsec = (long)(Ns % NANOS_PER_SEC);
+
+} /* End AbsTime() */
+
+
+/******************************************************************************
+** Function: GetSem
+**
+*/
+static Sem_t* GetSem(osal_id_t SemId)
+{
+
+   Sem_t* Sem = NULL;
+
+   if ((SemId > 0) && (SemId <= POSIXPLAT_MAX_SEMS) && PosixPlat.Sem[SemId-1].Created)
+   {
+      Sem = &PosixPlat.Sem[SemId-1];
+   }
+
+   return Sem;
+
+} /* End GetSem() */
@@ -0,0 +1,177 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a real time POSIX host platform for the cFE time, OSAL timer
+**    and OSAL semaphore services
+**
+**  Notes:
+**    1. The MET is CLOCK_MONOTONIC since POSIXPLAT_Start(). A tone thread
+**       calls the synch callback at each MET second like cFE TIME's local
+**       1Hz. The clock is never flywheeling.
+**    2. Each OSAL timer has its own thread that sleeps until the timer's
+**       absolute expiry and calls the timer's callback, like the POSIX
+**       OSAL's timebase. ClockAccuracy is the CLOCK_MONOTONIC resolution.
+**       The lateness of every expiry is added to the tick latency
+**       histogram.
+**    3. Binary semaphores are a mutex and a condition variable.
+**    4. The timer and tone threads use SCHED_FIFO when Priority is greater
+**       than zero and are pinned to Cpu when it isn't negative. Failures,
+**       usually from missing privileges, are counted and the threads run
+**       with the default policy.
+**    5. hostcfe.c isn't thread safe. The frame callbacks only send debug
+**       events so at worst an event count is off.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _posixplat_
+#define _posixplat_
+
+/*
+** Includes
+*/
+
+#include "cfe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define POSIXPLAT_MAX_TIMERS  4
+#define POSIXPLAT_MAX_SEMS    4
+
+#define POSIXPLAT_MICROS_PER_SEC  1000000
+
+#define POSIXPLAT_HIST_BINS  11   /* See POSIXPLAT_HistBinLimUs() */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   int32   Priority;   /* SCHED_FIFO priority, 0 for the default policy */
+   int32   Cpu;        /* CPU to pin threads to, -1 for any */
+   bool    ToneEnabled;
+
+} POSIXPLAT_Config_t;
+
+
+/*
+** Histogram of absolute values in microseconds. Min, max and the sum keep
+** their signs.
+*/
+typedef struct
+{
+
+   uint32  Bin[POSIXPLAT_HIST_BINS];
+   uint32  Samples;
+   int64   MinUs;
+   int64   MaxUs;
+   int64   SumUs;
+
+} POSIXPLAT_Hist_t;
+
+
+typedef struct
+{
+
+   uint32  TimerExpiries;
+   uint32  Tones;
+   uint32  RtConfigFailures;
+   POSIXPLAT_Hist_t  TickLatency;
+
+} POSIXPLAT_Stats_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: POSIXPLAT_Start
+**
+** Start the MET at zero and start the tone thread.
+**
+*/
+bool POSIXPLAT_Start(const POSIXPLAT_Config_t* Config);
+
+
+/******************************************************************************
+** Function: POSIXPLAT_Stop
+**
+** Stop and join the timer and tone threads. Callbacks aren't called after
+** this returns.
+**
+*/
+void POSIXPLAT_Stop(void);
+
+
+/******************************************************************************
+** Function: POSIXPLAT_ConfigThread
+**
+** Apply the SCHED_FIFO priority and the configured CPU pinning to the
+** calling thread.
+**
+** Notes:
+**   1. A Priority of zero only pins the thread.
+**   2. Returns false if either can't be applied.
+**
+*/
+bool POSIXPLAT_ConfigThread(int32 Priority);
+
+
+/******************************************************************************
+** Function: POSIXPLAT_NowUs
+**
+** Return the MET in microseconds.
+**
+*/
+uint64 POSIXPLAT_NowUs(void);
+
+
+/******************************************************************************
+** Function: POSIXPLAT_HistAdd
+**
+*/
+void POSIXPLAT_HistAdd(POSIXPLAT_Hist_t* Hist, int64 ValueUs);
+
+
+/******************************************************************************
+** Function: POSIXPLAT_HistBinLimUs
+**
+** Return a histogram bin's inclusive upper limit. The last bin is
+** unbounded and returns 0.
+**
+*/
+uint32 POSIXPLAT_HistBinLimUs(uint16 Bin);
+
+
+/******************************************************************************
+** Function: POSIXPLAT_GetStats
+**
+** Only consistent after POSIXPLAT_Stop().
+**
+*/
+const POSIXPLAT_Stats_t* POSIXPLAT_GetStats(void);
+
+
+#endif /* _posixplat_ */
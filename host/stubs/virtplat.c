@@ -0,0 +1,599 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the virtual time host platform
+**
+**  Notes:
+**    1. See virtplat.h for the time, timer and tone models.
+**    2. Timer and semaphore IDs are their table index plus one so they're
+**       never zero.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "virtplat.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TIME_NEVER  UINT64_MAX
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   bool                Created;
+   OS_TimerCallback_t  Callback;
+   uint64              NominalUs;   /* Next expiry without jitter */
+   uint64              ExpiryUs;    /* TIME_NEVER if not armed */
+   uint32              IntervalUs;  /* After rounding and drift, 0 for one-shot */
+
+} Timer_t;
+
+typedef struct
+{
+
+   bool  Created;
+   bool  Given;
+
+} Sem_t;
+
+typedef struct
+{
+
+   VIRTPLAT_Config_t  Config;
+   VIRTPLAT_Stats_t   Stats;
+
+   uint64   NowUs;
+   bool     Flying;
+   uint32   Random;
+
+   uint64   ToneNominalUs;
+   uint64   ToneUs;
+   CFE_TIME_SynchCallbackPtr_t  SynchCallback;
+
+   Timer_t  Timer[VIRTPLAT_MAX_TIMERS];
+   Sem_t    Sem[VIRTPLAT_MAX_SEMS];
+
+} VIRTPLAT_Class_t;
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static bool   RunUntil(uint64 TargetUs, const Sem_t* WakeSem);
+static void   DeliverTone(void);
+static void   DeliverTimer(Timer_t* Timer);
+static void   ScheduleTone(void);
+static uint32 TimerDuration(uint32 Us);
+static uint32 RandomUs(uint32 MaxUs);
+static Sem_t* GetSem(osal_id_t SemId);
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static VIRTPLAT_Class_t  VirtPlat;
+
+
+/******************************************************************************
+** Function: VIRTPLAT_DefaultConfig
+**
+*/
+void VIRTPLAT_DefaultConfig(VIRTPLAT_Config_t* Config)
+{
+
+   memset(Config, 0, sizeof(VIRTPLAT_Config_t));
+   Config->TimerAccuracyUs = 1;
+   Config->ToneEnabled     = true;
+   Config->Seed            = 1;
+
+} /* End VIRTPLAT_DefaultConfig() */
+
+
+/******************************************************************************
+** Function: VIRTPLAT_Reset
+**
+*/
+void VIRTPLAT_Reset(const VIRTPLAT_Config_t* Config)
+{
+
+   memset(&VirtPlat, 0, sizeof(VIRTPLAT_Class_t));
+
+   VirtPlat.Config = *Config;
+   if (VirtPlat.Config.TimerAccuracyUs == 0)
+   {
+      VirtPlat.Config.TimerAccuracyUs = 1;
+   }
+   VirtPlat.Random = (Config->Seed == 0) ? 1 : Config->Seed;
+
+   VirtPlat.ToneNominalUs = VIRTPLAT_MICROS_PER_SEC;
+   ScheduleTone();
+
+} /* End VIRTPLAT_Reset() */
+
+
+/******************************************************************************
+** Function: VIRTPLAT_Advance
+**
+*/
+void VIRTPLAT_Advance(uint32 Us)
+{
+
+   RunUntil(VirtPlat.NowUs + Us, NULL);
+
+} /* End VIRTPLAT_Advance() */
+
+
+/******************************************************************************
+** Function: VIRTPLAT_NowUs
+**
+*/
+uint64 VIRTPLAT_NowUs(void)
+{
+
+   return VirtPlat.NowUs;
+
+} /* End VIRTPLAT_NowUs() */
+
+
+/******************************************************************************
+** Function: VIRTPLAT_SetFlywheel
+**
+*/
+void VIRTPLAT_SetFlywheel(bool Flying)
+{
+
+   VirtPlat.Flying = Flying;
+
+} /* End VIRTPLAT_SetFlywheel() */
+
+
+/******************************************************************************
+** Function: VIRTPLAT_SetToneFaults
+**
+** The next tone keeps its current offset.
+*/
+void VIRTPLAT_SetToneFaults(uint32 JitterUs, uint32 DropPct)
+{
+
+   VirtPlat.Config.ToneJitterUs = JitterUs;
+   VirtPlat.Config.ToneDropPct  = DropPct;
+
+} /* End VIRTPLAT_SetToneFaults() */
+
+
+/******************************************************************************
+** Function: VIRTPLAT_GetStats
+**
+*/
+const VIRTPLAT_Stats_t* VIRTPLAT_GetStats(void)
+{
+
+   return &VirtPlat.Stats;
+
+} /* End VIRTPLAT_GetStats() */
+
+
+/******************************************************************************
+** Time Services
+*/
+
+CFE_TIME_SysTime_t CFE_TIME_GetMET(void)
+{
+
+   CFE_TIME_SysTime_t Met;
+
+   Met.Seconds    = (uint32)(VirtPlat.NowUs / VIRTPLAT_MICROS_PER_SEC);
+   Met.Subseconds = CFE_TIME_Micro2SubSecs((uint32)(VirtPlat.NowUs % VIRTPLAT_MICROS_PER_SEC));
+
+   return Met;
+
+} /* End CFE_TIME_GetMET() */
+
+
+uint16 CFE_TIME_GetClockInfo(void)
+{
+
+   return CFE_TIME_FLAG_CLKSET | (VirtPlat.Flying ? CFE_TIME_FLAG_FLYING : 0);
+
+} /* End CFE_TIME_GetClockInfo() */
+
+
+int32 CFE_TIME_RegisterSynchCallback(CFE_TIME_SynchCallbackPtr_t CallbackFuncPtr)
+{
+
+   VirtPlat.SynchCallback = CallbackFuncPtr;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_TIME_RegisterSynchCallback() */
+
+
+void CFE_PSP_GetTime(OS_time_t *LocalTime)
+{
+
+   LocalTime->ticks = (int64)VirtPlat.NowUs * 1000;
+
+} /* End CFE_PSP_GetTime() */
+
+
+/******************************************************************************
+** Timers
+*/
+
+int32 OS_TimerCreate(osal_id_t *TimerId, const char *TimerName, uint32 *ClockAccuracy, OS_TimerCallback_t CallbackPtr)
+{
+
+   int32  Status = OS_ERROR;
+   uint16 i;
+
+   for (i=0; i < VIRTPLAT_MAX_TIMERS; i++)
+   {
+      if (!VirtPlat.Timer[i].Created)
+      {
+         VirtPlat.Timer[i].Created  = true;
+         VirtPlat.Timer[i].Callback = CallbackPtr;
+         VirtPlat.Timer[i].ExpiryUs = TIME_NEVER;
+         *TimerId       = i + 1;
+         *ClockAccuracy = VirtPlat.Config.TimerAccuracyUs;
+         Status = OS_SUCCESS;
+         break;
+      }
+   }
+
+   return Status;
+
+} /* End OS_TimerCreate() */
+
+
+int32 OS_TimerSet(osal_id_t TimerId, uint32 StartTime, uint32 IntervalTime)
+{
+
+   int32    Status = OS_ERR_INVALID_ID;
+   Timer_t* Timer;
+
+   if ((TimerId > 0) && (TimerId <= VIRTPLAT_MAX_TIMERS) && VirtPlat.Timer[TimerId-1].Created)
+   {
+
+      Timer  = &VirtPlat.Timer[TimerId-1];
+      Status = OS_SUCCESS;
+
+      if (StartTime == 0)
+      {
+         Timer->ExpiryUs = TIME_NEVER;
+      }
+      else
+      {
+         Timer->NominalUs  = VirtPlat.NowUs + TimerDuration(StartTime);
+         Timer->ExpiryUs   = Timer->NominalUs + RandomUs(VirtPlat.Config.TimerJitterUs);
+         Timer->IntervalUs = (IntervalTime == 0) ? 0 : TimerDuration(IntervalTime);
+      }
+   }
+
+   return Status;
+
+} /* End OS_TimerSet() */
+
+
+/******************************************************************************
+** Binary Semaphores
+*/
+
+int32 OS_BinSemCreate(osal_id_t *SemId, const char *SemName, uint32 SemInitialValue, uint32 Options)
+{
+
+   int32  Status = OS_ERROR;
+   uint16 i;
+
+   for (i=0; i < VIRTPLAT_MAX_SEMS; i++)
+   {
+      if (!VirtPlat.Sem[i].Created)
+      {
+         VirtPlat.Sem[i].Created = true;
+         VirtPlat.Sem[i].Given   = (SemInitialValue != 0);
+         *SemId = i + 1;
+         Status = OS_SUCCESS;
+         break;
+      }
+   }
+
+   return Status;
+
+} /* End OS_BinSemCreate() */
+
+
+int32 OS_BinSemGive(osal_id_t SemId)
+{
+
+   int32  Status = OS_ERR_INVALID_ID;
+   Sem_t* Sem = GetSem(SemId);
+
+   if (Sem != NULL)
+   {
+      Sem->Given = true;
+      Status = OS_SUCCESS;
+   }
+
+   return Status;
+
+} /* End OS_BinSemGive() */
+
+
+/*
+** Returns OS_ERROR if nothing is left that could give the semaphore
+*/
+int32 OS_BinSemTake(osal_id_t SemId)
+{
+
+   int32  Status = OS_ERR_INVALID_ID;
+   Sem_t* Sem = GetSem(SemId);
+
+   if (Sem != NULL)
+   {
+      Status = OS_ERROR;
+      if (RunUntil(TIME_NEVER, Sem))
+      {
+         Sem->Given = false;
+         VirtPlat.Stats.Wakeups++;
+         VirtPlat.Stats.LastWakeUs = VirtPlat.NowUs;
+         Status = OS_SUCCESS;
+      }
+   }
+
+   return Status;
+
+} /* End OS_BinSemTake() */
+
+
+int32 OS_BinSemTimedWait(osal_id_t SemId, uint32 Msecs)
+{
+
+   int32  Status = OS_ERR_INVALID_ID;
+   Sem_t* Sem = GetSem(SemId);
+
+   if (Sem != NULL)
+   {
+      if (RunUntil(VirtPlat.NowUs + (uint64)Msecs * 1000, Sem))
+      {
+         Sem->Given = false;
+         VirtPlat.Stats.Wakeups++;
+         VirtPlat.Stats.LastWakeUs = VirtPlat.NowUs;
+         Status = OS_SUCCESS;
+      }
+      else
+      {
+         VirtPlat.Stats.WaitTimeouts++;
+         Status = OS_SEM_TIMEOUT;
+      }
+   }
+
+   return Status;
+
+} /* End OS_BinSemTimedWait() */
+
+
+/******************************************************************************
+** Function: RunUntil
+**
+** Deliver timer expiries and tones in time order until TargetUs or until
+** WakeSem is given. Returns true if WakeSem was given.
+**
+** Notes:
+**   1. If nothing can happen before TargetUs, time is set to TargetUs. If
+**      TargetUs is TIME_NEVER and nothing can happen, time doesn't change
+**      and false is returned.
+**   2. WakeSem can be NULL.
+*/
+static bool RunUntil(uint64 TargetUs, const Sem_t* WakeSem)
+{
+
+   uint64   NextUs;
+   Timer_t* NextTimer;
+   uint16   i;
+
+   while ((WakeSem == NULL) || !WakeSem->Given)
+   {
+
+      NextUs    = VirtPlat.ToneUs;
+      NextTimer = NULL;
+      for (i=0; i < VIRTPLAT_MAX_TIMERS; i++)
+      {
+         if (VirtPlat.Timer[i].Created && (VirtPlat.Timer[i].ExpiryUs < NextUs))
+         {
+            NextUs    = VirtPlat.Timer[i].ExpiryUs;
+            NextTimer = &VirtPlat.Timer[i];
+         }
+      }
+
+      if ((NextUs > TargetUs) || (NextUs == TIME_NEVER))
+      {
+         if (TargetUs != TIME_NEVER)
+         {
+            VirtPlat.NowUs = TargetUs;
+         }
+         break;
+      }
+
+      if (NextUs > VirtPlat.NowUs)
+      {
+         VirtPlat.NowUs = NextUs;
+      }
+
+      if (NextTimer == NULL)
+      {
+         DeliverTone();
+      }
+      else
+      {
+         DeliverTimer(NextTimer);
+      }
+
+   } /* End while not woken */
+
+   return ((WakeSem != NULL) && WakeSem->Given);
+
+} /* End RunUntil() */
+
+
+/******************************************************************************
+** Function: DeliverTone
+**
+*/
+static void DeliverTone(void)
+{
+
+   if (RandomUs(99) < VirtPlat.Config.ToneDropPct)
+   {
+      VirtPlat.Stats.TonesDropped++;
+   }
+   else
+   {
+      VirtPlat.Stats.Tones++;
+      if (VirtPlat.Flying)
+      {
+         VirtPlat.Stats.TonesFlywheel++;
+      }
+      if (VirtPlat.SynchCallback != NULL)
+      {
+         VirtPlat.SynchCallback();
+      }
+   }
+
+   VirtPlat.ToneNominalUs += VIRTPLAT_MICROS_PER_SEC;
+   ScheduleTone();
+
+} /* End DeliverTone() */
+
+
+/******************************************************************************
+** Function: DeliverTimer
+**
+** The next expiry is set before the callback so the callback can rearm the
+** timer.
+*/
+static void DeliverTimer(Timer_t* Timer)
+{
+
+   if (Timer->IntervalUs == 0)
+   {
+      Timer->ExpiryUs = TIME_NEVER;
+   }
+   else
+   {
+      Timer->NominalUs += Timer->IntervalUs;
+      Timer->ExpiryUs   = Timer->NominalUs + RandomUs(VirtPlat.Config.TimerJitterUs);
+   }
+
+   VirtPlat.Stats.TimerExpiries++;
+   Timer->Callback((osal_id_t)(Timer - VirtPlat.Timer) + 1);
+
+} /* End DeliverTimer() */
+
+
+/******************************************************************************
+** Function: ScheduleTone
+**
+** Compute the next tone's delivery time from its nominal time.
+*/
+static void ScheduleTone(void)
+{
+
+   uint32 JitterUs = VirtPlat.Config.ToneJitterUs;
+   uint64 ToneUs   = VirtPlat.ToneNominalUs + RandomUs(2 * JitterUs);
+
+   VirtPlat.ToneUs = TIME_NEVER;
+   if (VirtPlat.Config.ToneEnabled)
+   {
+      VirtPlat.ToneUs = (ToneUs > JitterUs) ? (ToneUs - JitterUs) : 0;
+   }
+
+} /* End ScheduleTone() */
+
+
+/******************************************************************************
+** Function: TimerDuration
+**
+** Apply the drift and round up to the timer accuracy.
+*/
+static uint32 TimerDuration(uint32 Us)
+{
+
+   uint32 Accuracy = VirtPlat.Config.TimerAccuracyUs;
+   int64  DriftUs  = ((int64)Us * VirtPlat.Config.TimerDriftPpm) / VIRTPLAT_MICROS_PER_SEC;
+   uint64 Duration = (uint64)((int64)Us + DriftUs);
+
+   Duration = ((Duration + Accuracy - 1) / Accuracy) * Accuracy;
+
+   return (Duration == 0) ? Accuracy : (uint32)Duration;
+
+} /* End TimerDuration() */
+
+
+/******************************************************************************
+** Function: RandomUs
+**
+** Return a random value from 0 to MaxUs using a xorshift generator.
+*/
+static uint32 RandomUs(uint32 MaxUs)
+{
+
+   uint32 RandomValue = 0;
+
+   if (MaxUs > 0)
+   {
+      VirtPlat.Random ^= VirtPlat.Random << 13;
+      VirtPlat.Random ^= VirtPlat.Random >> 17;
+      VirtPlat.Random ^= VirtPlat.Random << 5;
+      RandomValue = VirtPlat.Random % (MaxUs + 1);
+   }
+
+   return RandomValue;
+
+} /* End RandomUs() */
+
+
+/******************************************************************************
+** Function: GetSem
+**
+*/
+static Sem_t* GetSem(osal_id_t SemId)
+{
+
+   Sem_t* Sem = NULL;
+
+   if ((SemId > 0) && (SemId <= VIRTPLAT_MAX_SEMS) && VirtPlat.Sem[SemId-1].Created)
+   {
+      Sem = &VirtPlat.Sem[SemId-1];
+   }
+
+   return Sem;
+
+} /* End GetSem() */
@@ -0,0 +1,159 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define a virtual time host platform for the cFE time, OSAL timer and
+**    OSAL semaphore services
+**
+**  Notes:
+**    1. Virtual time is a microsecond count that only advances when the
+**       single host thread blocks on a semaphore or calls
+**       VIRTPLAT_Advance(). Pending timer expiries and tones are delivered
+**       in time order while it advances so callbacks run as if they
+**       preempted the task. Nothing runs faster or slower than the code
+**       under test, so a simulated hour takes milliseconds.
+**    2. The MET is the virtual time and starts at zero. The tone is
+**       nominally at each MET second.
+**    3. Timer expiries are rounded up to a multiple of TimerAccuracyUs,
+**       which is also the ClockAccuracy reported by OS_TimerCreate(),
+**       scaled by TimerDriftPpm and delayed by up to TimerJitterUs. A
+**       periodic timer's jitter doesn't accumulate.
+**    4. Each tone is offset from its MET second by up to +/- ToneJitterUs
+**       and dropped with a probability of ToneDropPct percent. While
+**       flywheeling the tone is still delivered and CFE_TIME_GetClockInfo()
+**       reports CFE_TIME_FLAG_FLYING like cFE TIME's local 1Hz.
+**    5. Random values come from a seeded generator so runs are
+**       repeatable.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _virtplat_
+#define _virtplat_
+
+/*
+** Includes
+*/
+
+#include "cfe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define VIRTPLAT_MAX_TIMERS  4
+#define VIRTPLAT_MAX_SEMS    4
+
+#define VIRTPLAT_MICROS_PER_SEC  1000000
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint32  TimerAccuracyUs;   /* 0 is treated as 1 */
+   int32   TimerDriftPpm;
+   uint32  TimerJitterUs;
+   bool    ToneEnabled;
+   uint32  ToneJitterUs;
+   uint32  ToneDropPct;
+   uint32  Seed;
+
+} VIRTPLAT_Config_t;
+
+typedef struct
+{
+
+   uint32  TimerExpiries;
+   uint32  Tones;
+   uint32  TonesDropped;
+   uint32  TonesFlywheel;
+   uint32  Wakeups;
+   uint32  WaitTimeouts;
+   uint64  LastWakeUs;     /* Time of the last successful semaphore take */
+
+} VIRTPLAT_Stats_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: VIRTPLAT_DefaultConfig
+**
+** Ideal timer and tone: 1us accuracy, no drift, jitter or dropped tones.
+**
+*/
+void VIRTPLAT_DefaultConfig(VIRTPLAT_Config_t* Config);
+
+
+/******************************************************************************
+** Function: VIRTPLAT_Reset
+**
+** Restart virtual time at zero with no timers, semaphores or synch
+** callback.
+**
+*/
+void VIRTPLAT_Reset(const VIRTPLAT_Config_t* Config);
+
+
+/******************************************************************************
+** Function: VIRTPLAT_Advance
+**
+** Advance virtual time by Us microseconds delivering the timer expiries and
+** tones that occur in that time.
+**
+*/
+void VIRTPLAT_Advance(uint32 Us);
+
+
+/******************************************************************************
+** Function: VIRTPLAT_NowUs
+**
+*/
+uint64 VIRTPLAT_NowUs(void);
+
+
+/******************************************************************************
+** Function: VIRTPLAT_SetFlywheel
+**
+*/
+void VIRTPLAT_SetFlywheel(bool Flying);
+
+
+/******************************************************************************
+** Function: VIRTPLAT_SetToneFaults
+**
+** Change the tone jitter and drop rate without restarting virtual time.
+**
+*/
+void VIRTPLAT_SetToneFaults(uint32 JitterUs, uint32 DropPct);
+
+
+/******************************************************************************
+** Function: VIRTPLAT_GetStats
+**
+*/
+const VIRTPLAT_Stats_t* VIRTPLAT_GetStats(void);
+
+
+#endif /* _virtplat_ */